@@ -1013,6 +1013,494 @@ int utility_test(const std::string& self_path)
 		cout << console::color::GREEN << "PASSED!";
 	}
 
+	cout << console::color::LIGHT_PURPLE << "Testing 'config' (indexed lookups)...";
+	{
+		config conf;
+		conf.auto_save(false);
+
+		cout << "Filling 50 sections with 40 keys each...";
+
+		for (int s = 0; s < 50; ++s) {
+			const std::string sec = "section" + std::to_string(s);
+			conf.set(sec, config::config_section_mode::MEMORY_ONLY);
+			for (int k = 0; k < 40; ++k) conf.set(sec, "key" + std::to_string(k), s * 1000 + k);
+		}
+
+		cout << "Looking them up...";
+
+		for (int s = 0; s < 50; ++s) {
+			const std::string sec = "section" + std::to_string(s);
+			for (int k = 0; k < 40; ++k) TESTLU(conf.get_as<int32_t>(sec, "key" + std::to_string(k)) == s * 1000 + k, "Config index returned the wrong value!");
+		}
+
+		TESTLU(conf.has("section49", "key39", config::config_section_mode::MEMORY_ONLY), "Config index lost a key!");
+		TESTLU(!conf.has("section49", "key40", config::config_section_mode::MEMORY_ONLY), "Config index found a key that was never set!");
+		TESTLU(!conf.has("section50", config::config_section_mode::MEMORY_ONLY), "Config index found a section that was never set!");
+		TESTLU(conf.get("section50", "key0").empty(), "Missing section should read as empty!");
+
+		cout << "Replacing a value...";
+
+		conf.set("section7", "key7", std::string("replaced"));
+		TESTLU(conf.get("section7", "key7") == "replaced", "Config index didn't replace the value!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'config' (cached values and handles)...";
+	{
+		config conf;
+		conf.auto_save(false);
+		conf.set("cache", config::config_section_mode::MEMORY_ONLY);
+
+		cout << "Binding a handle before the key exists...";
+
+		const auto hdl = conf.bind<int32_t>("cache", "number");
+		const auto hdl_arr = conf.bind<std::vector<int32_t>>("cache", "list");
+		TESTLU(hdl.valid() && !hdl.exists() && hdl.get() == 0, "Unbound key should read as T{}!");
+
+		cout << "Setting and reading through the handle...";
+
+		conf.set("cache", "number", 42);
+		conf.set("cache", "list", { 1, 2, 3 });
+		TESTLU(hdl.exists() && hdl.get() == 42, "Handle didn't see the new key!");
+		TESTLU(hdl_arr.get() == std::vector<int32_t>({ 1, 2, 3 }), "Handle didn't parse the array!");
+
+		const int32_t before = hdl.get();
+		conf.set("cache", "number", 7);
+		TESTLU(before == 42 && hdl.get() == 7, "Handle kept a stale cached value!");
+		TESTLU(conf.get_as<int32_t>("cache", "number") == 7 && conf.get_as<double>("cache", "number") == 7.0, "Reading as another type broke the cache!");
+		TESTLU(conf.get_array<int32_t>("cache", "list").size() == 3, "Cached array read is wrong!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'config' (background save)...";
+	{
+		const std::string temp_path_conf = "temp_conf_bg.conf";
+
+		{
+			config conf;
+			conf.auto_save(false);
+			conf.save_path(temp_path_conf);
+			conf.background_save(true, std::chrono::milliseconds(50));
+
+			cout << "Changing many values in a row (one save after they stop)...";
+
+			conf.set("bg", config::config_section_mode::SAVE);
+			for (int k = 0; k < 100; ++k) conf.set("bg", "key" + std::to_string(k), k);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+		{
+			config conf;
+			TESTLU(conf.load(temp_path_conf), "Background save didn't write the file!");
+			conf.auto_save(false);
+			TESTLU(conf.get_as<int32_t>("bg", "key99") == 99, "Background save didn't save the last change!");
+		}
+
+		std::remove(temp_path_conf.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'hash' (known answers and streaming)...";
+	{
+		const std::string hash_abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+		const std::string hash_empty = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+		TESTLU(sha256(std::string("abc")) == hash_abc, "SHA256 of 'abc' is wrong!");
+		TESTLU(sha256(std::string()) == hash_empty, "SHA256 of nothing is wrong!");
+
+		cout << "Hashing in parts of odd sizes...";
+
+		std::string data;
+		for (size_t p = 0; p < 100000; ++p) data += static_cast<char>((p * 31) % 251);
+
+		sha256_hasher hasher;
+		for (size_t p = 0; p < data.size(); p += 97) hasher.update(std::string_view(data).substr(p, 97));
+		TESTLU(hasher.final() == sha256(data), "Streaming SHA256 doesn't match hashing at once!");
+
+		cout << "Hashing a file...";
+
+		{
+			file fp;
+			TESTLU(fp.open(temp_local_file_path, file::open_mode_e::WRITE_REPLACE), "Failed to create a local file.");
+			TESTLU(fp.write(data.data(), data.size()), "Couldn't write all data into temporary file.");
+		}
+		TESTLU(sha256_f(temp_local_file_path) == sha256(data), "SHA256 of the file doesn't match!");
+		TESTLU(sha256_f(temp_local_file_path + ".nope").empty(), "SHA256 of a missing file should be empty!");
+		std::remove(temp_local_file_path.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'hash' (every kernel)...";
+	{
+		const std::string hash_abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+		const sha256_kernel_e old_single = sha256_kernel();
+		const sha256_kernel_e old_multi = sha256_multi_kernel();
+
+		std::vector<std::string> msgs;
+		for (size_t p = 0; p < 19; ++p) msgs.push_back(std::string(p * 37, static_cast<char>('a' + p)));
+		msgs.push_back("abc");
+		const std::vector<std::string_view> views(msgs.begin(), msgs.end());
+
+		for (const auto kern : { sha256_kernel_e::SCALAR, sha256_kernel_e::SHA_NI, sha256_kernel_e::AVX2 }) {
+			if (!sha256_supports(kern)) continue;
+
+			cout << "Kernel " << static_cast<int>(kern) << " is supported, checking...";
+
+			if (sha256_use_kernel(kern)) {
+				TESTLU(sha256(std::string("abc")) == hash_abc, "SHA256 of 'abc' is wrong with this kernel!");
+			}
+			if (sha256_use_multi_kernel(kern)) {
+				TESTLU(sha256_use_kernel(sha256_kernel_e::SCALAR), "Scalar kernel should always work!");
+				const auto res = sha256_multi(views);
+				TESTLU(res.size() == msgs.size() && res.back() == hash_abc, "Multi SHA256 of 'abc' is wrong with this kernel!");
+				for (size_t p = 0; p < msgs.size(); ++p) TESTLU(res[p] == sha256(msgs[p]), "Multi SHA256 doesn't match single SHA256!");
+			}
+		}
+
+		sha256_use_kernel(old_single);
+		sha256_use_multi_kernel(old_multi);
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'merkle'...";
+	{
+		std::string data;
+		for (size_t p = 0; p < 10000; ++p) data += static_cast<char>((p * 7) % 256);
+
+		cout << "Building from memory and from a file...";
+
+		merkle_tree tree;
+		TESTLU(tree.build(data, 1024, 4), "Merkle tree didn't build!");
+		TESTLU(tree.chunk_count() == 10 && tree.size() == data.size(), "Merkle tree has the wrong shape!");
+
+		{
+			file fp;
+			TESTLU(fp.open(temp_local_file_path, file::open_mode_e::WRITE_REPLACE), "Failed to create a local file.");
+			TESTLU(fp.write(data.data(), data.size()), "Couldn't write all data into temporary file.");
+		}
+		merkle_tree tree_file;
+		TESTLU(tree_file.build_file(temp_local_file_path, 1024, 4), "Merkle tree didn't build from file!");
+		TESTLU(tree_file.root() == tree.root(), "Merkle tree from file doesn't match the one from memory!");
+
+		cout << "Changing one chunk and updating...";
+
+		merkle_tree changed;
+		data[5000] ^= 0x55;
+		TESTLU(changed.build(data, 1024, 4), "Merkle tree didn't build!");
+		const auto diffs = tree.diff(changed);
+		TESTLU(diffs.size() == 1 && diffs[0] == 4, "Merkle diff should find only chunk 4!");
+		TESTLU(changed.verify_chunk(4, std::string_view(data).substr(4096, 1024)) && !tree.verify_chunk(4, std::string_view(data).substr(4096, 1024)), "Merkle verify_chunk is wrong!");
+
+		TESTLU(tree.update(data, 5000, 1) && tree.root() == changed.root(), "Merkle update doesn't match a full build!");
+
+		{
+			file fp;
+			TESTLU(fp.open(temp_local_file_path, file::open_mode_e::WRITE_REPLACE), "Failed to create a local file.");
+			TESTLU(fp.write(data.data(), data.size()), "Couldn't write all data into temporary file.");
+		}
+		TESTLU(tree_file.update_file(temp_local_file_path, 5000, 1) && tree_file.root() == changed.root(), "Merkle update_file doesn't match a full build!");
+		std::remove(temp_local_file_path.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'crypt'...";
+	{
+		const auto to_hex = [](const unsigned char* p, const size_t len) {
+			static const char hx[] = "0123456789abcdef";
+			std::string res;
+			for (size_t i = 0; i < len; ++i) { res += hx[p[i] >> 4]; res += hx[p[i] & 0xF]; }
+			return res;
+		};
+
+		cout << "Checking the RFC 8439 (2.8.2) ChaCha20-Poly1305 vector...";
+
+		crypt_key key{};
+		for (size_t p = 0; p < key.size(); ++p) key[p] = static_cast<unsigned char>(0x80 + p);
+		const crypt_nonce nonce = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+		const unsigned char aad[] = { 0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7 };
+		const std::string plain = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+		const std::string cipher_hex =
+			"d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+			"3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+			"92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+			"3ff4def08e4b7a9de576d26586cec64b6116";
+
+		std::string buf = plain;
+		const crypt_tag tag = chacha20_poly1305_encrypt(key, nonce, buf.data(), buf.size(), aad, sizeof(aad));
+		TESTLU(to_hex(reinterpret_cast<const unsigned char*>(buf.data()), buf.size()) == cipher_hex, "ChaCha20-Poly1305 ciphertext doesn't match RFC 8439!");
+		TESTLU(to_hex(tag.data(), tag.size()) == "1ae10b594f09e26a7e902ecbd0600691", "ChaCha20-Poly1305 tag doesn't match RFC 8439!");
+
+		std::string bad = buf;
+		bad[10] ^= 1;
+		TESTLU(!chacha20_poly1305_decrypt(key, nonce, bad.data(), bad.size(), tag, aad, sizeof(aad)), "Tampered data was accepted!");
+		TESTLU(chacha20_poly1305_decrypt(key, nonce, buf.data(), buf.size(), tag, aad, sizeof(aad)) && buf == plain, "ChaCha20-Poly1305 round trip failed!");
+
+		cout << "Checking PBKDF2-HMAC-SHA256 (known answer)...";
+
+		const crypt_key derived = crypt_key_from("password", "salt", 1);
+		TESTLU(to_hex(derived.data(), derived.size()) == "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b", "PBKDF2 key is wrong!");
+
+		cout << "Sealing and opening...";
+
+		const crypt_key rkey = crypt_random_key();
+		std::string sealed = plain;
+		crypt_seal(rkey, sealed);
+		TESTLU(sealed != plain && sealed.size() == plain.size() + crypt_nonce_size + crypt_tag_size, "Sealed data has the wrong size!");
+		std::string tampered = sealed;
+		tampered.back() ^= 1;
+		TESTLU(!crypt_open(rkey, tampered), "Tampered sealed data was opened!");
+		TESTLU(crypt_open(rkey, sealed) && sealed == plain, "Seal and open round trip failed!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'package' (bulk copies and views)...";
+	{
+		package pkg;
+		pkg.reserve(1 << 12);
+		TESTLU(pkg.capacity() >= (1 << 12), "Package didn't reserve!");
+
+		const std::string raw = "raw bytes";
+		pkg << std::string("first") << std::string_view("second") << 123 << "third";
+		pkg.write_data(raw.data(), raw.size());
+		pkg << std::vector<char>{ 'x', 'y', 'z' };
+
+		cout << "Reading back as views (no copies)...";
+
+		int num = 0;
+		std::string third;
+		std::vector<char> vec;
+
+		const std::string_view first = pkg.read_string_view();
+		const std::string_view second = pkg.read_string_view();
+		pkg >> num >> third;
+		const std::string_view data_view = pkg.read_data_view(raw.size());
+		pkg >> vec;
+
+		TESTLU(first == "first" && second == "second" && num == 123 && third == "third", "Package views read the wrong values!");
+		TESTLU(data_view == raw, "Package data view is wrong!");
+		TESTLU(vec == std::vector<char>({ 'x', 'y', 'z' }) && pkg.remaining() == 0, "Package didn't read everything!");
+
+		bool threw = false;
+		try { pkg.read_data_view(1); }
+		catch (const std::exception&) { threw = true; }
+		TESTLU(threw, "Package read past the end!");
+
+		cout << "Round trip with a copy...";
+
+		package cpy(pkg.read_as_array());
+		std::string s1, s2;
+		cpy >> s1 >> s2;
+		TESTLU(s1 == "first" && s2 == "second" && cpy == pkg, "Package copy is different!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'serialize'...";
+	{
+		struct item {
+			int32_t id = 0;
+			std::string name;
+			std::vector<float> values;
+			LUNARIS_SERIALIZE(id, name, values)
+		};
+		struct inventory {
+			std::vector<item> items;
+			std::optional<item> equipped;
+			std::map<std::string, int32_t> counts;
+			double weight = 0.0;
+			LUNARIS_SERIALIZE_VERSION(2)
+			LUNARIS_SERIALIZE(items, equipped, counts, weight)
+		};
+
+		inventory inv;
+		inv.items.push_back({ 1, "sword", { 1.5f, 2.0f } });
+		inv.items.push_back({ 2, "shield", {} });
+		inv.equipped = inv.items[0];
+		inv.counts["arrows"] = 40;
+		inv.weight = 12.25;
+
+		cout << "Serializing a nested struct...";
+
+		const std::vector<char> buf = serialize(inv);
+		TESTLU(buf.size() == serialized_size(inv), "serialized_size doesn't match the data!");
+
+		inventory back;
+		TESTLU(deserialize(buf, back), "Couldn't deserialize!");
+		TESTLU(back.items.size() == 2 && back.items[0].name == "sword" && back.items[0].values == std::vector<float>({ 1.5f, 2.0f }), "Deserialized items are wrong!");
+		TESTLU(back.equipped && back.equipped->id == 1 && back.counts["arrows"] == 40 && back.weight == 12.25, "Deserialized fields are wrong!");
+
+		cout << "Truncated data must fail...";
+
+		inventory broken;
+		TESTLU(!deserialize(std::string_view(buf.data(), buf.size() - 1), broken), "Truncated data was accepted!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'mmapfile'...";
+	{
+		const std::string data = "memory mapped file content 0123456789";
+		{
+			file fp;
+			TESTLU(fp.open(temp_local_file_path, file::open_mode_e::WRITE_REPLACE), "Failed to create a local file.");
+			TESTLU(fp.write(data.data(), data.size()), "Couldn't write all data into temporary file.");
+		}
+
+		{
+			cout << "Mapping read only...";
+
+			mmapfile mp;
+			TESTLU(mp.open(temp_local_file_path), "Couldn't map the file!");
+			TESTLU(mp.view() == data && mp.view(7, 6) == "mapped" && mp.view(27, 100) == "0123456789", "Mapped data is wrong!");
+			TESTLU(mp.data_cow() == nullptr, "Read only mapping gave writable data!");
+
+			char buf[6]{};
+			mp.seek(7, file::seek_mode_e::BEGIN);
+			TESTLU(mp.read(buf, 6) == 6 && std::string(buf, 6) == "mapped", "Reading the mapping as a file failed!");
+		}
+		{
+			cout << "Mapping copy-on-write...";
+
+			mmapfile mp;
+			TESTLU(mp.open(temp_local_file_path, true) && mp.is_copy_on_write(), "Couldn't map the file copy-on-write!");
+			mp.data_cow()[0] = 'M';
+			TESTLU(mp.view()[0] == 'M', "Copy-on-write change not seen!");
+		}
+		{
+			mmapfile mp;
+			TESTLU(mp.open(temp_local_file_path) && mp.view() == data, "Copy-on-write changed the file on disk!");
+		}
+
+		std::remove(temp_local_file_path.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'archive'...";
+	{
+		const std::string temp_path_pak = "lunaris_temp_archive.pak";
+		std::string big;
+		for (size_t p = 0; p < 50000; ++p) big += "abcdefgh"[p % 8];
+
+		cout << "Writing an archive...";
+
+		{
+			archive_writer wr;
+			wr.add("data/big.txt", big);
+			wr.add("data/raw.bin", "raw, never compressed", false);
+			wr.add("empty", "");
+			TESTLU(wr.size() == 3, "Archive writer has the wrong amount of entries!");
+			TESTLU(wr.save(temp_path_pak), "Couldn't save the archive!");
+		}
+
+		cout << "Reading it back...";
+
+		{
+			archive pak;
+			TESTLU(pak.open(temp_path_pak), "Couldn't open the archive!");
+			TESTLU(pak.entries().size() == 3 && pak.has("data/big.txt") && !pak.has("nope"), "Archive index is wrong!");
+			TESTLU(pak.info("data/big.txt")->stored_size < big.size(), "Big repetitive entry wasn't compressed!");
+
+			std::vector<char> out;
+			TESTLU(pak.read("data/big.txt", out) && std::string(out.begin(), out.end()) == big, "Archive entry read is wrong!");
+			TESTLU(pak.view("data/raw.bin") == "raw, never compressed", "Archive stored entry view is wrong!");
+			TESTLU(pak.read("empty", out) && out.empty(), "Empty archive entry should read as empty!");
+			TESTLU(!pak.read("nope", out), "Missing archive entry was read!");
+
+			auto fp = pak.get_file("data/big.txt");
+			TESTLU(!fp.empty() && fp->size() == static_cast<int64_t>(big.size()), "Archive entry as file has the wrong size!");
+			TESTLU(pak.verify_all(), "Archive didn't verify!");
+		}
+
+		std::remove(temp_path_pak.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'async_io'...";
+	{
+		async_io aio;
+		TESTLU(aio.start(), "Couldn't start async_io!");
+		cout << "Using " << (aio.is_io_uring() ? "io_uring" : "the thread pool") << "...";
+
+		std::vector<char> data(1 << 16);
+		for (size_t p = 0; p < data.size(); ++p) data[p] = static_cast<char>(p % 253);
+
+		async_file afp;
+		TESTLU(afp.open(temp_local_file_path, file::open_mode_e::READWRITE_REPLACE), "Couldn't open the async file!");
+
+		cout << "Writing in 16 parts at once...";
+
+		std::vector<future<int64_t>> writes;
+		for (size_t p = 0; p < 16; ++p) writes.push_back(aio.write(afp, data.data() + p * 4096, 4096, p * 4096));
+		for (auto& it : writes) TESTLU(it.get() == 4096, "Async write failed!");
+		TESTLU(aio.flush(afp).get(), "Async flush failed!");
+
+		cout << "Reading back with one submit...";
+
+		std::vector<char> back(data.size());
+		std::vector<async_io_request> reqs;
+		for (size_t p = 0; p < 16; ++p) reqs.push_back({ async_io_op_e::READ, &afp, back.data() + p * 4096, 4096, p * 4096 });
+		for (auto& it : aio.submit(reqs)) TESTLU(it.get() == 4096, "Async read failed!");
+		TESTLU(back == data, "Async read data is different!");
+
+		TESTLU(aio.read(afp, back.data(), 16, data.size()).get() == 0, "Reading past the end should read nothing!");
+		async_file none;
+		TESTLU(aio.read(none, back.data(), 16, 0).get() < 0, "Reading a closed file should fail!");
+
+		afp.close();
+		aio.stop();
+		std::remove(temp_local_file_path.c_str());
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
+	cout << console::color::LIGHT_PURPLE << "Testing 'paths' (parallel walk, scan and copy)...";
+	{
+		TESTLU(path_glob_match("a/**/b", "a/b") && path_glob_match("a/**/b", "a/x/y/b") && !path_glob_match("a/**/b", "a/xb"), "Glob '**' is wrong!");
+		TESTLU(path_glob_match("*.txt", "file.txt") && !path_glob_match("*.txt", "dir/file.txt"), "Glob '*' is wrong!");
+
+		const std::string temp_dir = "lunaris_temp_walk";
+		const std::string temp_copy = "lunaris_temp_walk_copy";
+		remove_all(temp_dir);
+		remove_all(temp_copy);
+
+		cout << "Creating 8 folders with 25 files each...";
+
+		for (int d = 0; d < 8; ++d) {
+			for (int f = 0; f < 25; ++f) {
+				const std::string fpath = temp_dir + "/d" + std::to_string(d) + "/sub/f" + std::to_string(f) + ".txt";
+				TESTLU(make_path(fpath), "Couldn't create path!");
+				file fp;
+				TESTLU(fp.open(fpath, file::open_mode_e::WRITE_REPLACE), "Couldn't create file!");
+				TESTLU(fp.write(fpath.data(), fpath.size()), "Couldn't write file!");
+			}
+		}
+
+		cout << "Scanning, walking and copying...";
+
+		const auto found = scan_path(temp_dir, "**/*.txt", false);
+		TESTLU(found.size() == 200 && std::is_sorted(found.begin(), found.end(), [](const path_entry& a, const path_entry& b) { return a.relative < b.relative; }), "scan_path found the wrong files!");
+		TESTLU(scan_path(temp_dir, "d3/**/f1*.txt", false).size() == 11, "scan_path filter is wrong!");
+
+		std::atomic<size_t> walked = 0;
+		TESTLU(walk_path(temp_dir, [&](std::vector<path_entry>& lst) { walked += lst.size(); }) == 216 && walked == 216, "walk_path didn't see everything!");
+
+		TESTLU(copy_all(temp_dir, temp_copy) == 200, "copy_all copied the wrong amount of files!");
+		TESTLU(scan_path(temp_copy, "**/*.txt", false).size() == 200, "The copy is missing files!");
+
+		TESTLU(remove_all(temp_dir) == 217 && remove_all(temp_copy) == 217, "remove_all removed the wrong amount!");
+
+		cout << console::color::GREEN << "PASSED!";
+	}
+
 	cout << console::color::DARK_BLUE << "======================================";
 	cout << console::color::BLUE << "# Ended utility_test!";
 	cout << console::color::DARK_BLUE << "======================================";
@@ -1034,6 +1522,29 @@ int audio_test()
 
 	TESTLU(audio_file.flush(), "Failed to flush the temporary file?!");
 
+	cout << "Rendering offline (before any audio device is used)...";
+	{
+		auto off_sample = make_hybrid<soft_sample>();
+		soft_mixer off_mixer;
+		soft_track off_track;
+		offline_voice off_voice;
+
+		TESTLU(off_mixer.create_offline(48000), "Can't create soft mixer offline!");
+		TESTLU(off_sample->load(audio_file.get_path()), "Could not load temporary audio file as soft sample!");
+		TESTLU(off_track.load(off_sample) && off_track.attach_to(off_mixer), "Can't set up soft track offline!");
+		off_track.play();
+
+		TESTLU(off_voice.attach(off_mixer, 512), "Can't attach offline voice to offline soft mixer!");
+		off_voice.keep_in_memory(true);
+		TESTLU(off_voice.render(48000) == 48000, "Offline voice didn't render everything!");
+
+		const auto rendered = off_voice.copy_memory();
+		TESTLU(rendered.size() == 96000, "Offline voice memory has the wrong size!");
+		TESTLU(std::any_of(rendered.begin(), rendered.end(), [](const float f) { return f != 0.0f; }), "Offline render is silent?!");
+	}
+
+	cout << console::color::GREEN << "PASSED!";
+
 	voice my_voice;
 	mixer my_mixer;
 	mixer my_submixer;
@@ -1522,9 +2033,7 @@ int graphics_test()
 			break;
 		case ALLEGRO_KEY_F11:
 			if (!ev.down) return;
-			my_display.toggle_flag(ALLEGRO_FULLSCREEN_WINDOW);
-
-			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			my_display.toggle_flag(ALLEGRO_FULLSCREEN_WINDOW); // async, don't wait on it here (handlers share one thread)
 			break;
 		case ALLEGRO_KEY_R:
 			if (!ev.down) return;
@@ -1985,11 +2494,11 @@ int events_test()
 		kb.hook_each_key_event([&](keyboard& self, int key) {
 			last_key = key;
 		});
-		kb.hook_each_key_phrase_event([&](keyboard& self, const std::string& cpy) {
+		kb.hook_each_key_phrase_event([&](keyboard& self, const std::string_view cpy) {
 			if (keep_clean) self.clear();
 			else curr_string = cpy;
 		});
-		kb.hook_enter_line_phrase_event([&](keyboard& self, const std::string& str) {
+		kb.hook_enter_line_phrase_event([&](keyboard& self, const std::string_view str) {
 			last_string = str;
 			self.clear();
 		});		
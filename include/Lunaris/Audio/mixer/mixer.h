@@ -11,8 +11,11 @@ namespace Lunaris {
 	class mixer : public NonCopyable {
 		/*
 		* Friend class track: because track should link to a mixer, and it's better if you just set(mixer). get_instance is just another friend-like.
+		* Friend class soft_mixer and track_stream: their streams should link to a mixer the same way.
 		*/
 		friend class track;
+		friend class soft_mixer;
+		friend class track_stream;
 
 		ALLEGRO_MIXER* mixing = nullptr;
 
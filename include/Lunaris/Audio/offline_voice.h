@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "offline_voice/offline_voice.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "offline_voice/offline_voice.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "offline_voice.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL double offline_voice_stats::realtime_factor() const
+	{
+		return mix_seconds > 0.0 ? audio_seconds / mix_seconds : 0.0;
+	}
+
+	LUNARIS_DECL double offline_voice_stats::frames_per_second() const
+	{
+		return mix_seconds > 0.0 ? static_cast<double>(frames) / mix_seconds : 0.0;
+	}
+
+	LUNARIS_DECL void offline_voice::_block()
+	{
+		const auto bef = std::chrono::steady_clock::now();
+
+		m_buf.resize(m_block * 2);
+		m_src->render(m_buf.data(), m_block);
+
+		const double took = std::chrono::duration<double>(std::chrono::steady_clock::now() - bef).count();
+		const double dur = static_cast<double>(m_block) / m_src->get_frequency();
+
+		if (m_wav.is_open()) m_wav_bytes += m_wav.write(reinterpret_cast<const char*>(m_buf.data()), m_buf.size() * sizeof(float));
+		if (m_keep_memory) m_memory.insert(m_memory.end(), m_buf.begin(), m_buf.end());
+
+		m_stats.frames += m_block;
+		++m_stats.blocks;
+		m_stats.audio_seconds += dur;
+		m_stats.mix_seconds += took;
+		if (took * 1000.0 > m_stats.worst_block_ms) m_stats.worst_block_ms = took * 1000.0;
+		if (took > dur) ++m_stats.underruns;
+	}
+
+	LUNARIS_DECL void offline_voice::_wav_header()
+	{
+		const unsigned freq = m_src ? m_src->get_frequency() : 48000;
+		const uint32_t data_len = static_cast<uint32_t>(m_wav_bytes > 0xFFFFFFFFull - 36 ? 0xFFFFFFFFull - 36 : m_wav_bytes);
+		char head[44];
+		size_t p = 0;
+
+		const auto put_str = [&](const char* s) { for (size_t k = 0; k < 4; ++k) head[p++] = s[k]; };
+		const auto put_u32 = [&](const uint32_t v) { for (size_t k = 0; k < 4; ++k) head[p++] = static_cast<char>((v >> (8 * k)) & 0xFF); };
+		const auto put_u16 = [&](const uint16_t v) { for (size_t k = 0; k < 2; ++k) head[p++] = static_cast<char>((v >> (8 * k)) & 0xFF); };
+
+		put_str("RIFF");
+		put_u32(36 + data_len);
+		put_str("WAVE");
+		put_str("fmt ");
+		put_u32(16);
+		put_u16(3);						// IEEE float
+		put_u16(2);						// stereo
+		put_u32(freq);
+		put_u32(freq * 2 * sizeof(float));	// bytes per second
+		put_u16(2 * sizeof(float));		// block align
+		put_u16(8 * sizeof(float));		// bits per sample
+		put_str("data");
+		put_u32(data_len);
+
+		m_wav.seek(0, file::seek_mode_e::BEGIN);
+		m_wav.write(head, sizeof(head));
+		m_wav.seek(0, file::seek_mode_e::END);
+	}
+
+	LUNARIS_DECL void offline_voice::_async()
+	{
+		auto next = std::chrono::steady_clock::now();
+
+		while (m_keep) {
+			{
+				std::lock_guard<std::mutex> luck(m_safe);
+				if (!m_src || m_src->get_frequency() == 0) {
+					m_keep = false;
+					return;
+				}
+				_block();
+				next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(static_cast<double>(m_block) / m_src->get_frequency()));
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now > next) { // late, a device would've played silence. Don't try to catch up.
+				std::lock_guard<std::mutex> luck(m_safe);
+				++m_stats.underruns;
+				next = now;
+			}
+			else std::this_thread::sleep_until(next);
+		}
+	}
+
+	LUNARIS_DECL offline_voice::~offline_voice()
+	{
+		stop();
+		close_wav();
+	}
+
+	LUNARIS_DECL bool offline_voice::attach(soft_mixer& src, const size_t block)
+	{
+		if (block == 0 || src.get_frequency() == 0) return false;
+		stop();
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_src = &src;
+		m_block = block;
+		return true;
+	}
+
+	LUNARIS_DECL void offline_voice::detach()
+	{
+		stop();
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_src = nullptr;
+	}
+
+	LUNARIS_DECL bool offline_voice::open_wav(const std::string& path)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (m_wav.is_open()) {
+			_wav_header();
+			m_wav.close();
+		}
+
+		m_wav_bytes = 0;
+		if (!m_wav.open(path, file::open_mode_e::WRITE_REPLACE)) return false;
+		_wav_header(); // sizes are fixed on close
+		return true;
+	}
+
+	LUNARIS_DECL void offline_voice::close_wav()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (!m_wav.is_open()) return;
+		_wav_header();
+		m_wav.flush();
+		m_wav.close();
+		m_wav_bytes = 0;
+	}
+
+	LUNARIS_DECL void offline_voice::keep_in_memory(const bool keep)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_keep_memory = keep;
+	}
+
+	LUNARIS_DECL std::vector<float> offline_voice::copy_memory() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_memory;
+	}
+
+	LUNARIS_DECL void offline_voice::clear_memory()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_memory.clear();
+	}
+
+	LUNARIS_DECL size_t offline_voice::render(const size_t frames)
+	{
+		if (is_running()) return 0;
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (!m_src) return 0;
+
+		const size_t blk = m_block;
+		size_t done = 0;
+		while (done < frames) { // last block may be shorter
+			m_block = (frames - done) < blk ? (frames - done) : blk;
+			_block();
+			done += m_block;
+		}
+		m_block = blk;
+		return done;
+	}
+
+	LUNARIS_DECL bool offline_voice::start()
+	{
+		if (is_running()) return true;
+		{
+			std::lock_guard<std::mutex> luck(m_safe);
+			if (!m_src) return false;
+		}
+		if (m_thr.joinable()) m_thr.join(); // ended by itself
+
+		m_keep = true;
+		m_thr = std::thread([this] { _async(); });
+		return true;
+	}
+
+	LUNARIS_DECL void offline_voice::stop()
+	{
+		m_keep = false;
+		if (m_thr.joinable()) m_thr.join();
+	}
+
+	LUNARIS_DECL bool offline_voice::is_running() const
+	{
+		return m_keep;
+	}
+
+	LUNARIS_DECL offline_voice_stats offline_voice::get_stats() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_stats;
+	}
+
+	LUNARIS_DECL void offline_voice::reset_stats()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_stats = {};
+	}
+
+}
\ No newline at end of file
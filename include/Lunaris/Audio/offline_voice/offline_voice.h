@@ -0,0 +1,145 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Audio/softmix.h>
+#include <Lunaris/Utility/file.h>
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+namespace Lunaris {
+
+	/// <summary>
+	/// <para>Mixing statistics of an offline_voice.</para>
+	/// </summary>
+	struct offline_voice_stats {
+		uint64_t frames = 0;			// frames mixed
+		uint64_t blocks = 0;			// blocks mixed
+		uint64_t underruns = 0;			// blocks that took longer to mix than to play (a real device would glitch)
+		double audio_seconds = 0.0;		// audio time mixed
+		double mix_seconds = 0.0;		// time spent mixing
+		double worst_block_ms = 0.0;	// slowest block
+
+		/// <summary>
+		/// <para>How many times faster than real time the mixing is.</para>
+		/// </summary>
+		/// <returns>{double} Audio time / mixing time (0 if nothing mixed).</returns>
+		double realtime_factor() const;
+
+		/// <summary>
+		/// <para>Frames mixed per second of mixing.</para>
+		/// </summary>
+		/// <returns>{double} Throughput (0 if nothing mixed).</returns>
+		double frames_per_second() const;
+	};
+
+	/// <summary>
+	/// <para>offline_voice is a voice without a sound device. It pulls mixed audio from a soft_mixer and writes it to a WAV file and/or memory.</para>
+	/// <para>Run as fast as possible (render) or at simulated real time (start/stop), and check the stats for throughput and underruns.</para>
+	/// <para>Allegro's own mixer can only be pulled by a real voice, so this works on the soft_mixer graph. Use soft_mixer::create_offline() on it to run with no audio device at all.</para>
+	/// </summary>
+	class offline_voice : public NonCopyable, public NonMovable {
+		mutable std::mutex m_safe; // everything below
+		soft_mixer* m_src = nullptr;
+		size_t m_block = 1024;
+		file m_wav;
+		uint64_t m_wav_bytes = 0;
+		bool m_keep_memory = false;
+		std::vector<float> m_memory;
+		std::vector<float> m_buf;
+		offline_voice_stats m_stats;
+
+		std::thread m_thr;
+		std::atomic<bool> m_keep = false;
+
+		void _block(); // mix one block and send it everywhere (m_safe locked)
+		void _wav_header(); // (re)write header with current size
+		void _async();
+	public:
+		offline_voice() = default;
+		~offline_voice();
+
+		/// <summary>
+		/// <para>Set the source and the block size (frames mixed at once, like a device buffer).</para>
+		/// <para>NOTE: The soft_mixer MUST EXIST while attached.</para>
+		/// </summary>
+		/// <param name="{soft_mixer}">The source.</param>
+		/// <param name="{size_t}">Block size in frames.</param>
+		/// <returns>{bool} True if attached.</returns>
+		bool attach(soft_mixer&, const size_t = 1024);
+
+		/// <summary>
+		/// <para>Stop and forget the source.</para>
+		/// </summary>
+		void detach();
+
+		/// <summary>
+		/// <para>Write everything mixed from now on into a WAV file (32 bit float, stereo). Replaces the file.</para>
+		/// </summary>
+		/// <param name="{std::string}">Path.</param>
+		/// <returns>{bool} True if the file was opened.</returns>
+		bool open_wav(const std::string&);
+
+		/// <summary>
+		/// <para>Finish and close the WAV file, if any.</para>
+		/// </summary>
+		void close_wav();
+
+		/// <summary>
+		/// <para>Keep everything mixed from now on in memory (interleaved stereo floats).</para>
+		/// </summary>
+		/// <param name="{bool}">Keep?</param>
+		void keep_in_memory(const bool);
+
+		/// <summary>
+		/// <para>Copy of what was kept in memory.</para>
+		/// </summary>
+		/// <returns>{std::vector&lt;float&gt;} Interleaved stereo floats.</returns>
+		std::vector<float> copy_memory() const;
+
+		/// <summary>
+		/// <para>Clear what was kept in memory.</para>
+		/// </summary>
+		void clear_memory();
+
+		/// <summary>
+		/// <para>Mix this many frames as fast as possible (blocking). Can't be used while running in real time.</para>
+		/// </summary>
+		/// <param name="{size_t}">Frames.</param>
+		/// <returns>{size_t} Frames mixed.</returns>
+		size_t render(const size_t);
+
+		/// <summary>
+		/// <para>Start mixing on its own thread at simulated real time (one block per block duration).</para>
+		/// </summary>
+		/// <returns>{bool} True if started.</returns>
+		bool start();
+
+		/// <summary>
+		/// <para>Stop real time mixing.</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Is it mixing in real time?</para>
+		/// </summary>
+		/// <returns>{bool} True if running.</returns>
+		bool is_running() const;
+
+		/// <summary>
+		/// <para>Stats so far.</para>
+		/// </summary>
+		/// <returns>{offline_voice_stats} Copy of the stats.</returns>
+		offline_voice_stats get_stats() const;
+
+		/// <summary>
+		/// <para>Reset the stats.</para>
+		/// </summary>
+		void reset_stats();
+	};
+
+}
\ No newline at end of file
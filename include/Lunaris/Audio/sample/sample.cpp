@@ -18,7 +18,7 @@ namespace Lunaris {
 
 	LUNARIS_DECL sample::sample()
 	{
-		__audio_allegro_start(); // from voice.h
+		__audio_allegro_start_headless(); // from voice.h, a sample alone doesn't need a device
 	}
 
 	LUNARIS_DECL sample::~sample()
@@ -50,6 +50,17 @@ namespace Lunaris {
 		return set(al_load_sample(str.c_str()));
 	}
 
+	LUNARIS_DECL bool sample::load(const hybrid_memory<file>& fp, const std::string& type)
+	{
+		if (fp.empty() || !fp->is_open()) return false;
+		if (!type.empty()) return set(al_load_sample_f(fp->get_fp(), type.c_str()));
+
+		const std::string& pth = fp->get_path();
+		const size_t dot = pth.rfind('.');
+		if (dot == std::string::npos) return false;
+		return set(al_load_sample_f(fp->get_fp(), pth.substr(dot).c_str()));
+	}
+
 	LUNARIS_DECL void sample::destroy()
 	{
 		if (file_sample) {
@@ -3,17 +3,22 @@
 #include <Lunaris/__macro/macros.h>
 #include <Lunaris/Audio/voice.h>
 #include <Lunaris/Audio/mixer.h>
+#include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/memory.h>
 
 namespace Lunaris {
 	
 	/// <summary>
 	/// <para>A sample is a music file or stream itself. You load a sample and then play/control with a Track.</para>
+	/// <para>The whole file is decoded into memory on load. For long music, track_stream is lighter.</para>
 	/// </summary>
 	class sample : public NonCopyable {
 		/*
 		* Friend class Track: because Track should link to/with a sample. get_instance is just another friend-like.
+		* Friend class soft_sample: it converts the sample data once to be mixed by soft_mixer.
 		*/
 		friend class track;
+		friend class soft_sample;
 
 		ALLEGRO_SAMPLE* file_sample = nullptr;
 
@@ -32,6 +37,14 @@ namespace Lunaris {
 		/// <returns>{bool} True if loaded successfully.</returns>
 		bool load(const std::string&);
 
+		/// <summary>
+		/// <para>Loads from an open file (like one from an archive). The sample keeps no reference to the file.</para>
+		/// </summary>
+		/// <param name="{hybrid_memory&lt;file&gt;}">The file.</param>
+		/// <param name="{std::string}">File type, like ".ogg" (empty: extension of the file path).</param>
+		/// <returns>{bool} True if loaded successfully.</returns>
+		bool load(const hybrid_memory<file>&, const std::string& = {});
+
 		/// <summary>
 		/// <para>Destroy this sample, if exists.</para>
 		/// </summary>
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "softmix/softmix.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "softmix/softmix.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,681 @@
+#include "softmix.h"
+
+namespace Lunaris {
+
+	// dst += src * gain (interleaved stereo), gain going linearly from (l0, r0) to (l1, r1) over frames.
+	LUNARIS_DECL void __softmix_mix_ramp(float* dst, const float* src, const size_t frames, const float l0, const float r0, const float l1, const float r1)
+	{
+		if (frames == 0) return;
+		const float dl = (l1 - l0) / static_cast<float>(frames);
+		const float dr = (r1 - r0) / static_cast<float>(frames);
+		size_t f = 0;
+
+#ifdef LUNARIS_SOFTMIX_SSE
+		__m128 gain = _mm_setr_ps(l0, r0, l0 + dl, r0 + dr); // two frames at once
+		const __m128 step = _mm_setr_ps(2.0f * dl, 2.0f * dr, 2.0f * dl, 2.0f * dr);
+
+		for (; f + 2 <= frames; f += 2) {
+			const __m128 d = _mm_loadu_ps(dst + f * 2);
+			const __m128 s = _mm_loadu_ps(src + f * 2);
+			_mm_storeu_ps(dst + f * 2, _mm_add_ps(d, _mm_mul_ps(s, gain)));
+			gain = _mm_add_ps(gain, step);
+		}
+#endif
+		for (; f < frames; ++f) {
+			dst[f * 2] += src[f * 2] * (l0 + dl * static_cast<float>(f));
+			dst[f * 2 + 1] += src[f * 2 + 1] * (r0 + dr * static_cast<float>(f));
+		}
+	}
+
+	LUNARIS_DECL float __softmix_sample_to_float(const void* src, const size_t idx, const ALLEGRO_AUDIO_DEPTH depth)
+	{
+		switch (depth) {
+		case ALLEGRO_AUDIO_DEPTH_INT8:
+			return static_cast<const int8_t*>(src)[idx] / 128.0f;
+		case ALLEGRO_AUDIO_DEPTH_UINT8:
+			return (static_cast<int>(static_cast<const uint8_t*>(src)[idx]) - 128) / 128.0f;
+		case ALLEGRO_AUDIO_DEPTH_INT16:
+			return static_cast<const int16_t*>(src)[idx] / 32768.0f;
+		case ALLEGRO_AUDIO_DEPTH_UINT16:
+			return (static_cast<int>(static_cast<const uint16_t*>(src)[idx]) - 32768) / 32768.0f;
+		case ALLEGRO_AUDIO_DEPTH_INT24: // stored in 32 bits
+			return static_cast<const int32_t*>(src)[idx] / 8388608.0f;
+		case ALLEGRO_AUDIO_DEPTH_UINT24:
+			return (static_cast<int64_t>(static_cast<const uint32_t*>(src)[idx]) - 8388608) / 8388608.0f;
+		case ALLEGRO_AUDIO_DEPTH_FLOAT32:
+			return static_cast<const float*>(src)[idx];
+		default:
+			return 0.0f;
+		}
+	}
+
+	LUNARIS_DECL bool soft_sample::load(const sample& sp)
+	{
+		if (sp.empty()) return false;
+
+		ALLEGRO_SAMPLE* raw = sp.file_sample;
+		const void* src = al_get_sample_data(raw);
+		const size_t frames = al_get_sample_length(raw);
+		const size_t channels = al_get_channel_count(al_get_sample_channels(raw));
+		const ALLEGRO_AUDIO_DEPTH depth = al_get_sample_depth(raw);
+
+		if (!src || frames == 0 || channels == 0) return false;
+
+		std::vector<float> conv(frames * 2);
+		for (size_t f = 0; f < frames; ++f) {
+			conv[f * 2] = __softmix_sample_to_float(src, f * channels, depth);
+			conv[f * 2 + 1] = channels > 1 ? __softmix_sample_to_float(src, f * channels + 1, depth) : conv[f * 2];
+		}
+
+		m_data = std::move(conv);
+		m_frames = frames;
+		m_freq = al_get_sample_frequency(raw);
+		return true;
+	}
+
+	LUNARIS_DECL bool soft_sample::load(const std::string& path)
+	{
+		sample sp;
+		return sp.load(path) && load(sp);
+	}
+
+	LUNARIS_DECL void soft_sample::destroy()
+	{
+		m_data.clear();
+		m_data.shrink_to_fit();
+		m_frames = 0;
+		m_freq = 0;
+	}
+
+	LUNARIS_DECL bool soft_sample::empty() const
+	{
+		return m_frames == 0;
+	}
+
+	LUNARIS_DECL size_t soft_sample::get_length_samples() const
+	{
+		return m_frames;
+	}
+
+	LUNARIS_DECL unsigned soft_sample::get_frequency() const
+	{
+		return m_freq;
+	}
+
+	LUNARIS_DECL const float* soft_sample::data() const
+	{
+		return m_data.data();
+	}
+
+	LUNARIS_DECL soft_lowpass::soft_lowpass(const float cutoff, const float q)
+		: m_cutoff(cutoff), m_q(q)
+	{
+	}
+
+	LUNARIS_DECL void soft_lowpass::process(float* buf, const size_t frames, const unsigned freq)
+	{
+		if (m_changed.exchange(false) || freq != m_last_freq) { // RBJ cookbook
+			m_last_freq = freq;
+			const float nyq = freq * 0.5f;
+			const float fc = m_cutoff < 1.0f ? 1.0f : (m_cutoff > nyq * 0.99f ? nyq * 0.99f : m_cutoff.load());
+			const float q = m_q < 0.01f ? 0.01f : m_q.load();
+			const float w0 = 2.0f * 3.14159265358979f * fc / static_cast<float>(freq);
+			const float alpha = sinf(w0) / (2.0f * q);
+			const float cw = cosf(w0);
+			const float a0 = 1.0f + alpha;
+
+			b0 = ((1.0f - cw) * 0.5f) / a0;
+			b1 = (1.0f - cw) / a0;
+			b2 = b0;
+			a1 = (-2.0f * cw) / a0;
+			a2 = (1.0f - alpha) / a0;
+		}
+
+		for (size_t f = 0; f < frames; ++f) {
+			for (size_t c = 0; c < 2; ++c) { // transposed direct form II
+				float& x = buf[f * 2 + c];
+				const float y = b0 * x + z1[c];
+				z1[c] = b1 * x - a1 * y + z2[c];
+				z2[c] = b2 * x - a2 * y;
+				x = y;
+			}
+		}
+	}
+
+	LUNARIS_DECL void soft_lowpass::set_cutoff(const float val)
+	{
+		m_cutoff = val;
+		m_changed = true;
+	}
+
+	LUNARIS_DECL float soft_lowpass::get_cutoff() const
+	{
+		return m_cutoff;
+	}
+
+	LUNARIS_DECL void soft_lowpass::set_q(const float val)
+	{
+		m_q = val;
+		m_changed = true;
+	}
+
+	LUNARIS_DECL float soft_lowpass::get_q() const
+	{
+		return m_q;
+	}
+
+	LUNARIS_DECL soft_compressor::soft_compressor(const float threshold, const float ratio, const float attack, const float release, const float makeup)
+		: m_threshold(threshold), m_ratio(ratio < 1.0f ? 1.0f : ratio), m_attack(attack), m_release(release), m_makeup(makeup)
+	{
+	}
+
+	LUNARIS_DECL void soft_compressor::process(float* buf, const size_t frames, const unsigned freq)
+	{
+		const float att = m_attack <= 0.0f ? 0.0f : expf(-1000.0f / (m_attack * freq));
+		const float rel = m_release <= 0.0f ? 0.0f : expf(-1000.0f / (m_release * freq));
+		const float thr = m_threshold;
+		const float slope = 1.0f - 1.0f / m_ratio;
+		const float makeup = m_makeup;
+
+		for (size_t f = 0; f < frames; ++f) {
+			const float peak = fmaxf(fabsf(buf[f * 2]), fabsf(buf[f * 2 + 1]));
+			m_env = peak + (peak > m_env ? att : rel) * (m_env - peak);
+
+			const float over = 20.0f * log10f(m_env + 1e-9f) - thr;
+			const float gain_db = (over > 0.0f ? -over * slope : 0.0f) + makeup;
+			const float gain = gain_db == 0.0f ? 1.0f : powf(10.0f, gain_db * 0.05f);
+
+			buf[f * 2] *= gain;
+			buf[f * 2 + 1] *= gain;
+		}
+	}
+
+	LUNARIS_DECL void soft_compressor::set_threshold(const float val)
+	{
+		m_threshold = val;
+	}
+
+	LUNARIS_DECL void soft_compressor::set_ratio(const float val)
+	{
+		m_ratio = val < 1.0f ? 1.0f : val;
+	}
+
+	LUNARIS_DECL void soft_compressor::set_times(const float attack, const float release)
+	{
+		m_attack = attack;
+		m_release = release;
+	}
+
+	LUNARIS_DECL void soft_compressor::set_makeup(const float val)
+	{
+		m_makeup = val;
+	}
+
+	LUNARIS_DECL void soft_track::_render(float* out, const size_t frames, const unsigned out_freq)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (!m_playing || m_sample.empty() || m_sample->empty()) return;
+
+		const soft_sample& smp = *m_sample;
+		const float* src = smp.data();
+		const size_t len = smp.get_length_samples();
+		const double last = static_cast<double>(len);
+		const ALLEGRO_PLAYMODE mode = m_mode;
+
+		const int64_t seek = m_seek.exchange(-1);
+		if (seek >= 0) {
+			m_pos = static_cast<double>(seek) < last ? static_cast<double>(seek) : 0.0;
+			m_dir = 1;
+		}
+
+		const float pan = m_pan < -1.0f ? -1.0f : (m_pan > 1.0f ? 1.0f : m_pan.load());
+		const float tgt_l = m_gain * (pan > 0.0f ? 1.0f - pan : 1.0f);
+		const float tgt_r = m_gain * (pan < 0.0f ? 1.0f + pan : 1.0f);
+		if (m_fresh) {
+			m_cur_l = tgt_l;
+			m_cur_r = tgt_r;
+			m_fresh = false;
+		}
+
+		const double step = static_cast<double>(m_speed > 0.0f ? m_speed.load() : 0.0f) * smp.get_frequency() / out_freq;
+		bool finished = false;
+		size_t done = 0;
+		const float* from = nullptr;
+		alignas(16) float tmp[soft_mix_block * 2];
+
+		if (step == 1.0 && m_dir > 0 && m_pos == std::floor(m_pos) && m_pos + frames <= last) { // no resampling, mix straight from the sample
+			from = src + static_cast<size_t>(m_pos) * 2;
+			done = frames;
+			m_pos += static_cast<double>(frames);
+			if (m_pos >= last && mode == ALLEGRO_PLAYMODE_ONCE) finished = true;
+		}
+		else {
+			const double bidir_end = last > 1.0 ? last - 1.0 : 0.0;
+
+			for (; done < frames; ++done) {
+				if (mode == ALLEGRO_PLAYMODE_BIDIR) {
+					if (m_pos > bidir_end) { m_pos = 2.0 * bidir_end - m_pos; m_dir = -1; }
+					if (m_pos < 0.0) { m_pos = -m_pos; m_dir = 1; }
+					if (m_pos > bidir_end || m_pos < 0.0) m_pos = 0.0; // step bigger than the whole sample
+				}
+				else if (m_pos >= last) {
+					if (mode == ALLEGRO_PLAYMODE_LOOP) m_pos = std::fmod(m_pos, last);
+					else {
+						finished = true;
+						break;
+					}
+				}
+
+				const size_t i = static_cast<size_t>(m_pos);
+				const size_t j = i + 1 < len ? i + 1 : (mode == ALLEGRO_PLAYMODE_LOOP ? 0 : i);
+				const float frac = static_cast<float>(m_pos - static_cast<double>(i));
+
+				tmp[done * 2] = src[i * 2] + (src[j * 2] - src[i * 2]) * frac;
+				tmp[done * 2 + 1] = src[i * 2 + 1] + (src[j * 2 + 1] - src[i * 2 + 1]) * frac;
+
+				m_pos += step * m_dir;
+			}
+			from = tmp;
+		}
+
+		__softmix_mix_ramp(out, from, done, m_cur_l, m_cur_r, tgt_l, tgt_r);
+		m_cur_l = tgt_l;
+		m_cur_r = tgt_r;
+
+		if (finished) {
+			m_playing = false;
+			m_pos = 0.0;
+			m_dir = 1;
+			m_fresh = true;
+		}
+		m_pos_pub = static_cast<size_t>(m_pos);
+	}
+
+	LUNARIS_DECL soft_track::~soft_track()
+	{
+		detach();
+	}
+
+	LUNARIS_DECL bool soft_track::load(const hybrid_memory<soft_sample>& smp)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_playing = false;
+		m_sample = smp;
+		m_pos = 0.0;
+		m_dir = 1;
+		m_fresh = true;
+		m_seek = -1;
+		m_pos_pub = 0;
+		return !m_sample.empty() && !m_sample->empty();
+	}
+
+	LUNARIS_DECL void soft_track::destroy()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_playing = false;
+		m_sample.reset_this();
+		m_pos = 0.0;
+		m_pos_pub = 0;
+	}
+
+	LUNARIS_DECL bool soft_track::attach_to(soft_bus& bus)
+	{
+		detach();
+		std::lock_guard<std::mutex> luck(bus.m_safe);
+		bus.m_tracks.push_back(this);
+		m_bus = &bus;
+		return true;
+	}
+
+	LUNARIS_DECL void soft_track::detach()
+	{
+		soft_bus* bus = m_bus.exchange(nullptr);
+		if (!bus) return;
+
+		std::lock_guard<std::mutex> luck(bus->m_safe);
+		for (auto it = bus->m_tracks.begin(); it != bus->m_tracks.end(); ++it) {
+			if (*it == this) {
+				bus->m_tracks.erase(it);
+				return;
+			}
+		}
+	}
+
+	LUNARIS_DECL bool soft_track::exists() const
+	{
+		return !m_sample.empty();
+	}
+
+	LUNARIS_DECL bool soft_track::empty() const
+	{
+		return m_sample.empty();
+	}
+
+	LUNARIS_DECL bool soft_track::valid() const
+	{
+		return !m_sample.empty();
+	}
+
+	LUNARIS_DECL void soft_track::play()
+	{
+		if (!exists()) return;
+		m_playing = true;
+	}
+
+	LUNARIS_DECL void soft_track::pause()
+	{
+		m_playing = false;
+	}
+
+	LUNARIS_DECL void soft_track::stop()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_playing = false;
+		m_pos = 0.0;
+		m_dir = 1;
+		m_fresh = true;
+		m_seek = -1;
+		m_pos_pub = 0;
+	}
+
+	LUNARIS_DECL bool soft_track::is_playing() const
+	{
+		return m_playing;
+	}
+
+	LUNARIS_DECL unsigned soft_track::get_frequency() const
+	{
+		if (!exists()) return 0;
+		return m_sample->get_frequency();
+	}
+
+	LUNARIS_DECL unsigned soft_track::get_length_samples() const
+	{
+		if (!exists()) return 0;
+		return static_cast<unsigned>(m_sample->get_length_samples());
+	}
+
+	LUNARIS_DECL size_t soft_track::get_length_ms() const
+	{
+		if (!exists() || get_frequency() == 0) return 0;
+		return static_cast<size_t>((1000.0 * get_length_samples()) / get_frequency());
+	}
+
+	LUNARIS_DECL unsigned soft_track::get_position_samples() const
+	{
+		const int64_t seek = m_seek;
+		return static_cast<unsigned>(seek >= 0 ? seek : m_pos_pub.load());
+	}
+
+	LUNARIS_DECL void soft_track::set_position_samples(const unsigned pos)
+	{
+		m_seek = static_cast<int64_t>(pos);
+	}
+
+	LUNARIS_DECL size_t soft_track::get_position_ms() const
+	{
+		if (!exists() || get_frequency() == 0) return 0;
+		return static_cast<size_t>((1000.0 * get_position_samples()) / get_frequency());
+	}
+
+	LUNARIS_DECL void soft_track::set_position_ms(const size_t ms)
+	{
+		if (!exists()) return;
+		set_position_samples(static_cast<unsigned>((ms / 1000.0) * get_frequency()));
+	}
+
+	LUNARIS_DECL float soft_track::get_speed() const
+	{
+		return m_speed;
+	}
+
+	LUNARIS_DECL void soft_track::set_speed(const float speed)
+	{
+		m_speed = speed;
+	}
+
+	LUNARIS_DECL float soft_track::get_gain() const
+	{
+		return m_gain;
+	}
+
+	LUNARIS_DECL void soft_track::set_gain(const float gain)
+	{
+		m_gain = gain;
+	}
+
+	LUNARIS_DECL float soft_track::get_pan() const
+	{
+		return m_pan;
+	}
+
+	LUNARIS_DECL void soft_track::set_pan(const float pan)
+	{
+		m_pan = pan;
+	}
+
+	LUNARIS_DECL float soft_track::get_time_s() const
+	{
+		if (!exists() || get_frequency() == 0) return 0.0f;
+		return static_cast<float>(get_length_samples()) / get_frequency();
+	}
+
+	LUNARIS_DECL ALLEGRO_PLAYMODE soft_track::get_play_mode() const
+	{
+		return m_mode;
+	}
+
+	LUNARIS_DECL void soft_track::set_play_mode(const ALLEGRO_PLAYMODE mode)
+	{
+		m_mode = mode;
+	}
+
+	LUNARIS_DECL void soft_bus::_render(float* out, const size_t frames, const unsigned freq)
+	{
+		alignas(16) float mix[soft_mix_block * 2];
+		std::memset(mix, 0, sizeof(float) * frames * 2);
+
+		std::lock_guard<std::mutex> luck(m_safe);
+
+		for (auto& it : m_tracks) it->_render(mix, frames, freq);
+		for (auto& it : m_buses) it->_render(mix, frames, freq);
+		for (auto& it : m_effects) it->process(mix, frames, freq);
+
+		const float tgt = m_muted ? 0.0f : m_gain.load();
+		__softmix_mix_ramp(out, mix, frames, m_cur_gain, m_cur_gain, tgt, tgt);
+		m_cur_gain = tgt;
+	}
+
+	LUNARIS_DECL soft_bus::~soft_bus()
+	{
+		detach();
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		for (auto& it : m_tracks) it->m_bus = nullptr;
+		for (auto& it : m_buses) it->m_parent = nullptr;
+		m_tracks.clear();
+		m_buses.clear();
+	}
+
+	LUNARIS_DECL bool soft_bus::attach_to(soft_bus& par)
+	{
+		for (soft_bus* p = &par; p; p = p->m_parent) {
+			if (p == this) return false;
+		}
+
+		detach();
+		std::lock_guard<std::mutex> luck(par.m_safe);
+		par.m_buses.push_back(this);
+		m_parent = &par;
+		return true;
+	}
+
+	LUNARIS_DECL void soft_bus::detach()
+	{
+		soft_bus* par = m_parent.exchange(nullptr);
+		if (!par) return;
+
+		std::lock_guard<std::mutex> luck(par->m_safe);
+		for (auto it = par->m_buses.begin(); it != par->m_buses.end(); ++it) {
+			if (*it == this) {
+				par->m_buses.erase(it);
+				return;
+			}
+		}
+	}
+
+	LUNARIS_DECL void soft_bus::effect_clear()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_effects.clear();
+	}
+
+	LUNARIS_DECL size_t soft_bus::effect_size() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_effects.size();
+	}
+
+	LUNARIS_DECL size_t soft_bus::tracks_size() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_tracks.size();
+	}
+
+	LUNARIS_DECL void soft_bus::mute(const bool muted)
+	{
+		m_muted = muted;
+	}
+
+	LUNARIS_DECL float soft_bus::get_gain() const
+	{
+		return m_gain;
+	}
+
+	LUNARIS_DECL void soft_bus::set_gain(const float gain)
+	{
+		m_gain = gain;
+	}
+
+	LUNARIS_DECL void soft_mixer::_async()
+	{
+		ALLEGRO_EVENT ev;
+
+		while (m_keep) {
+			if (!al_wait_for_event_timed(m_queue, &ev, 0.1f)) continue;
+			if (ev.type != ALLEGRO_EVENT_AUDIO_STREAM_FRAGMENT) continue;
+
+			while (void* buf = al_get_audio_stream_fragment(m_stream)) {
+				render(static_cast<float*>(buf), m_frag);
+				al_set_audio_stream_fragment(m_stream, buf);
+			}
+		}
+	}
+
+	LUNARIS_DECL soft_mixer::soft_mixer()
+	{
+		__audio_allegro_start_headless(); // from voice.h, create() asks for the device
+	}
+
+	LUNARIS_DECL soft_mixer::~soft_mixer()
+	{
+		destroy();
+	}
+
+	LUNARIS_DECL bool soft_mixer::create(const unsigned frequency, const size_t buffers, const size_t frames)
+	{
+		destroy();
+		if (frequency == 0 || buffers == 0 || frames == 0) return false;
+		__audio_allegro_start(); // from voice.h
+
+		m_stream = al_create_audio_stream(buffers, static_cast<unsigned>(frames), frequency, ALLEGRO_AUDIO_DEPTH_FLOAT32, ALLEGRO_CHANNEL_CONF_2);
+		if (!m_stream) return false;
+
+		if (!(m_queue = al_create_event_queue())) {
+			al_destroy_audio_stream(m_stream);
+			m_stream = nullptr;
+			return false;
+		}
+		al_register_event_source(m_queue, al_get_audio_stream_event_source(m_stream));
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("New soft mixer stream %p", m_stream);
+#endif
+
+		m_freq = frequency;
+		m_frag = frames;
+		m_keep = true;
+		m_thr = std::thread([this] { _async(); });
+		return true;
+	}
+
+	LUNARIS_DECL bool soft_mixer::create_offline(const unsigned frequency)
+	{
+		destroy();
+		if (frequency == 0) return false;
+
+		m_freq = frequency;
+		m_frag = 0;
+		m_offline = true;
+		return true;
+	}
+
+	LUNARIS_DECL void soft_mixer::destroy()
+	{
+		m_offline = false;
+		m_keep = false;
+		if (m_thr.joinable()) m_thr.join();
+
+		if (m_stream) {
+#ifdef LUNARIS_VERBOSE_BUILD
+			PRINT_DEBUG("Del soft mixer stream %p", m_stream);
+#endif
+			al_destroy_audio_stream(m_stream);
+			m_stream = nullptr;
+		}
+		if (m_queue) {
+			al_destroy_event_queue(m_queue);
+			m_queue = nullptr;
+		}
+	}
+
+	LUNARIS_DECL bool soft_mixer::attach_to(const mixer& mx)
+	{
+		return m_stream && mx.exists() && al_attach_audio_stream_to_mixer(m_stream, mx.mixing);
+	}
+
+	LUNARIS_DECL bool soft_mixer::attach_to(const voice& vc)
+	{
+		return m_stream && vc.exists() && al_attach_audio_stream_to_voice(m_stream, vc.device);
+	}
+
+	LUNARIS_DECL void soft_mixer::render(float* out, const size_t frames)
+	{
+		std::memset(out, 0, sizeof(float) * frames * 2);
+		for (size_t off = 0; off < frames; off += soft_mix_block) {
+			const size_t now = (frames - off) < soft_mix_block ? (frames - off) : soft_mix_block;
+			_render(out + off * 2, now, m_freq);
+		}
+	}
+
+	LUNARIS_DECL unsigned soft_mixer::get_frequency() const
+	{
+		return m_freq;
+	}
+
+	LUNARIS_DECL bool soft_mixer::exists() const
+	{
+		return m_stream != nullptr || m_offline;
+	}
+
+	LUNARIS_DECL bool soft_mixer::empty() const
+	{
+		return m_stream == nullptr && !m_offline;
+	}
+
+	LUNARIS_DECL bool soft_mixer::valid() const
+	{
+		return m_stream != nullptr || m_offline;
+	}
+
+}
\ No newline at end of file
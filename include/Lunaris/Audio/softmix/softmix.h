@@ -0,0 +1,545 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Audio/voice.h>
+#include <Lunaris/Audio/mixer.h>
+#include <Lunaris/Audio/sample.h>
+#include <Lunaris/Utility/memory.h>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define LUNARIS_SOFTMIX_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Lunaris {
+
+	constexpr size_t soft_mix_block = 256; // frames mixed at once (internal scratch size)
+
+	class soft_bus;
+	class soft_mixer;
+
+	/// <summary>
+	/// <para>soft_sample is a sample converted once to 32 bit float stereo, ready to be mixed by soft_mixer.</para>
+	/// <para>Share it (hybrid_memory) between as many soft_track as you want.</para>
+	/// </summary>
+	class soft_sample : public NonCopyable {
+		std::vector<float> m_data; // interleaved L R
+		size_t m_frames = 0;
+		unsigned m_freq = 0;
+	public:
+		soft_sample() = default;
+
+		/// <summary>
+		/// <para>Convert a loaded sample. Mono is copied to both sides, more than two channels keeps the first two.</para>
+		/// </summary>
+		/// <param name="{sample}">A loaded sample.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool load(const sample&);
+
+		/// <summary>
+		/// <para>Load a file and convert it.</para>
+		/// </summary>
+		/// <param name="{std::string}">The path to the file.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool load(const std::string&);
+
+		/// <summary>
+		/// <para>Free the data.</para>
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// <para>Is there any data?</para>
+		/// </summary>
+		/// <returns>{bool} True if there's nothing.</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// <para>Length in frames (one frame is L and R).</para>
+		/// </summary>
+		/// <returns>{size_t} Frames.</returns>
+		size_t get_length_samples() const;
+
+		/// <summary>
+		/// <para>Original frequency.</para>
+		/// </summary>
+		/// <returns>{unsigned} Frequency, in hertz.</returns>
+		unsigned get_frequency() const;
+
+		/// <summary>
+		/// <para>Raw interleaved stereo data.</para>
+		/// </summary>
+		/// <returns>{float*} Data (2 * length floats).</returns>
+		const float* data() const;
+	};
+
+	/// <summary>
+	/// <para>soft_effect is an effect applied on a soft_bus mix (after its tracks and buses are mixed, before its gain).</para>
+	/// <para>process() is called from the mixing thread. Parameters should be safe to change from any thread.</para>
+	/// </summary>
+	class soft_effect : public NonCopyable {
+	public:
+		virtual ~soft_effect() = default;
+
+		/// <summary>
+		/// <para>Process interleaved stereo audio in place.</para>
+		/// </summary>
+		/// <param name="{float*}">Interleaved stereo buffer.</param>
+		/// <param name="{size_t}">Frames.</param>
+		/// <param name="{unsigned}">Frequency, in hertz.</param>
+		virtual void process(float*, const size_t, const unsigned) = 0;
+	};
+
+	/// <summary>
+	/// <para>Low-pass filter (biquad, 12 dB per octave).</para>
+	/// </summary>
+	class soft_lowpass : public soft_effect {
+		std::atomic<float> m_cutoff, m_q;
+		std::atomic<bool> m_changed = true;
+		unsigned m_last_freq = 0;
+		float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+		float z1[2]{}, z2[2]{};
+	public:
+		/// <summary>
+		/// <para>Create a low-pass filter.</para>
+		/// </summary>
+		/// <param name="{float}">Cutoff frequency, in hertz.</param>
+		/// <param name="{float}">Resonance (Q). 0.7071 is flat.</param>
+		soft_lowpass(const float = 8000.0f, const float = 0.7071f);
+
+		void process(float*, const size_t, const unsigned) override;
+
+		/// <summary>
+		/// <para>Set cutoff frequency.</para>
+		/// </summary>
+		/// <param name="{float}">Cutoff, in hertz.</param>
+		void set_cutoff(const float);
+
+		/// <summary>
+		/// <para>Get cutoff frequency.</para>
+		/// </summary>
+		/// <returns>{float} Cutoff, in hertz.</returns>
+		float get_cutoff() const;
+
+		/// <summary>
+		/// <para>Set resonance.</para>
+		/// </summary>
+		/// <param name="{float}">Q (more than zero).</param>
+		void set_q(const float);
+
+		/// <summary>
+		/// <para>Get resonance.</para>
+		/// </summary>
+		/// <returns>{float} Q.</returns>
+		float get_q() const;
+	};
+
+	/// <summary>
+	/// <para>Compressor (peak detection, both channels linked).</para>
+	/// </summary>
+	class soft_compressor : public soft_effect {
+		std::atomic<float> m_threshold, m_ratio, m_attack, m_release, m_makeup;
+		float m_env = 0.0f;
+	public:
+		/// <summary>
+		/// <para>Create a compressor.</para>
+		/// </summary>
+		/// <param name="{float}">Threshold, in dB.</param>
+		/// <param name="{float}">Ratio (4 means 4:1).</param>
+		/// <param name="{float}">Attack, in milliseconds.</param>
+		/// <param name="{float}">Release, in milliseconds.</param>
+		/// <param name="{float}">Makeup gain, in dB.</param>
+		soft_compressor(const float = -12.0f, const float = 4.0f, const float = 5.0f, const float = 100.0f, const float = 0.0f);
+
+		void process(float*, const size_t, const unsigned) override;
+
+		/// <summary>
+		/// <para>Set threshold.</para>
+		/// </summary>
+		/// <param name="{float}">Threshold, in dB.</param>
+		void set_threshold(const float);
+
+		/// <summary>
+		/// <para>Set ratio.</para>
+		/// </summary>
+		/// <param name="{float}">Ratio (1 or more).</param>
+		void set_ratio(const float);
+
+		/// <summary>
+		/// <para>Set attack and release times.</para>
+		/// </summary>
+		/// <param name="{float}">Attack, in milliseconds.</param>
+		/// <param name="{float}">Release, in milliseconds.</param>
+		void set_times(const float, const float);
+
+		/// <summary>
+		/// <para>Set makeup gain.</para>
+		/// </summary>
+		/// <param name="{float}">Makeup gain, in dB.</param>
+		void set_makeup(const float);
+	};
+
+	/// <summary>
+	/// <para>soft_track plays a soft_sample on a soft_bus. Same controls as track, but mixed in-process by soft_mixer (no Allegro instance per track).</para>
+	/// <para>Gain and pan changes are ramped over one block, so they don't click.</para>
+	/// </summary>
+	class soft_track : public NonCopyable, public NonMovable {
+		friend class soft_bus;
+
+		std::mutex m_safe; // sample and mixing state
+		hybrid_memory<soft_sample> m_sample;
+		std::atomic<soft_bus*> m_bus = nullptr;
+
+		std::atomic<bool> m_playing = false;
+		std::atomic<float> m_gain = 1.0f, m_pan = 0.0f, m_speed = 1.0f;
+		std::atomic<ALLEGRO_PLAYMODE> m_mode = ALLEGRO_PLAYMODE_ONCE;
+		std::atomic<int64_t> m_seek = -1; // applied on next mix
+		std::atomic<size_t> m_pos_pub = 0;
+
+		// mixing thread only
+		double m_pos = 0.0;
+		int m_dir = 1;
+		float m_cur_l = 0.0f, m_cur_r = 0.0f;
+		bool m_fresh = true;
+
+		void _render(float*, const size_t, const unsigned);
+	public:
+		soft_track() = default;
+		~soft_track();
+
+		/// <summary>
+		/// <para>Set the sample this plays. Stops and resets position.</para>
+		/// </summary>
+		/// <param name="{hybrid_memory&lt;soft_sample&gt;}">Shared converted sample.</param>
+		/// <returns>{bool} True if the sample has data.</returns>
+		bool load(const hybrid_memory<soft_sample>&);
+
+		/// <summary>
+		/// <para>Remove the sample (and stop).</para>
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// <para>Attach this to a bus (or a soft_mixer). Detaches from the old one.</para>
+		/// </summary>
+		/// <param name="{soft_bus}">The bus.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool attach_to(soft_bus&);
+
+		/// <summary>
+		/// <para>Detach from its bus, if any.</para>
+		/// </summary>
+		void detach();
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if loaded.</returns>
+		bool exists() const;
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if not ready/set.</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if loaded.</returns>
+		bool valid() const;
+
+		/// <summary>
+		/// <para>Play/Resume.</para>
+		/// </summary>
+		void play();
+
+		/// <summary>
+		/// <para>Pause (keeps position).</para>
+		/// </summary>
+		void pause();
+
+		/// <summary>
+		/// <para>Stop and reset.</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Is it playing?</para>
+		/// </summary>
+		/// <returns>{bool} Playing.</returns>
+		bool is_playing() const;
+
+		/// <summary>
+		/// <para>What frequency is the sample?</para>
+		/// </summary>
+		/// <returns>{unsigned} Frequency, in hertz.</returns>
+		unsigned get_frequency() const;
+
+		/// <summary>
+		/// <para>Get the track length in samples.</para>
+		/// </summary>
+		/// <returns>{unsigned} samples.</returns>
+		unsigned get_length_samples() const;
+
+		/// <summary>
+		/// <para>track length in milliseconds.</para>
+		/// </summary>
+		/// <returns>{size_t} Milliseconds.</returns>
+		size_t get_length_ms() const;
+
+		/// <summary>
+		/// <para>Get the position in samples (updated each mixed block).</para>
+		/// </summary>
+		/// <returns>{unsigned} samples since start.</returns>
+		unsigned get_position_samples() const;
+
+		/// <summary>
+		/// <para>Set the track position in samples.</para>
+		/// </summary>
+		/// <param name="{unsigned}">Position in samples</param>
+		void set_position_samples(const unsigned);
+
+		/// <summary>
+		/// <para>Get track position in milliseconds.</para>
+		/// </summary>
+		/// <returns>{size_t} Position in milliseconds.</returns>
+		size_t get_position_ms() const;
+
+		/// <summary>
+		/// <para>Set the track position in milliseconds.</para>
+		/// </summary>
+		/// <param name="{size_t}">Position in milliseconds.</param>
+		void set_position_ms(const size_t);
+
+		/// <summary>
+		/// <para>Get current track speed.</para>
+		/// </summary>
+		/// <returns>{float} Speed.</returns>
+		float get_speed() const;
+
+		/// <summary>
+		/// <para>Set track speed (resampled with linear interpolation).</para>
+		/// </summary>
+		/// <param name="{float}">Speed (more than zero).</param>
+		void set_speed(const float);
+
+		/// <summary>
+		/// <para>Get current track gain.</para>
+		/// </summary>
+		/// <returns>{float} Gain.</returns>
+		float get_gain() const;
+
+		/// <summary>
+		/// <para>Set track gain.</para>
+		/// </summary>
+		/// <param name="{float}">Gain.</param>
+		void set_gain(const float);
+
+		/// <summary>
+		/// <para>Get current track pan/balance.</para>
+		/// </summary>
+		/// <returns>{float} Pan.</returns>
+		float get_pan() const;
+
+		/// <summary>
+		/// <para>Set track pan/balance.</para>
+		/// </summary>
+		/// <param name="{float}">Pan [-1.0f, 1.0f].</param>
+		void set_pan(const float);
+
+		/// <summary>
+		/// <para>Get full track length in seconds.</para>
+		/// </summary>
+		/// <returns>{float} Precise length in seconds.</returns>
+		float get_time_s() const;
+
+		/// <summary>
+		/// <para>Get playing mode.</para>
+		/// </summary>
+		/// <returns>{ALLEGRO_PLAYMODE} Mode.</returns>
+		ALLEGRO_PLAYMODE get_play_mode() const;
+
+		/// <summary>
+		/// <para>Set playing mode (ONCE, LOOP or BIDIR).</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_PLAYMODE}">New mode.</param>
+		void set_play_mode(const ALLEGRO_PLAYMODE);
+	};
+
+	/// <summary>
+	/// <para>soft_bus mixes soft_track and other soft_bus, applies its effects and gain and sends the result to its parent bus.</para>
+	/// <para>NOTE: Tracks and buses attached are references. They detach themselves when destroyed, but don't destroy a bus and its tracks at the same time from different threads.</para>
+	/// </summary>
+	class soft_bus : public NonCopyable, public NonMovable {
+		friend class soft_track;
+	protected:
+		mutable std::mutex m_safe;
+		std::vector<soft_track*> m_tracks;
+		std::vector<soft_bus*> m_buses;
+		std::vector<std::unique_ptr<soft_effect>> m_effects;
+		std::atomic<soft_bus*> m_parent = nullptr;
+
+		std::atomic<float> m_gain = 1.0f;
+		std::atomic<bool> m_muted = false;
+		float m_cur_gain = 1.0f; // mixing thread only
+
+		void _render(float*, const size_t, const unsigned); // adds to buffer, frames <= soft_mix_block
+	public:
+		soft_bus() = default;
+		virtual ~soft_bus();
+
+		/// <summary>
+		/// <para>Attach THIS bus into another bus (or a soft_mixer). Detaches from the old one.</para>
+		/// </summary>
+		/// <param name="{soft_bus}">The parent bus.</param>
+		/// <returns>{bool} True if success (can't attach to itself or to one of its children).</returns>
+		bool attach_to(soft_bus&);
+
+		/// <summary>
+		/// <para>Detach from its parent bus, if any.</para>
+		/// </summary>
+		void detach();
+
+		/// <summary>
+		/// <para>Add an effect to the end of the chain.</para>
+		/// </summary>
+		/// <param name="{Args...}">Arguments to construct the effect.</param>
+		/// <returns>{T&amp;} The effect (valid while it's in here).</returns>
+		template<typename T, typename... Args>
+		T& effect_emplace_back(Args&&...);
+
+		/// <summary>
+		/// <para>Remove all effects.</para>
+		/// </summary>
+		void effect_clear();
+
+		/// <summary>
+		/// <para>Amount of effects.</para>
+		/// </summary>
+		/// <returns>{size_t} Effects in the chain.</returns>
+		size_t effect_size() const;
+
+		/// <summary>
+		/// <para>Amount of tracks attached directly to this.</para>
+		/// </summary>
+		/// <returns>{size_t} Tracks.</returns>
+		size_t tracks_size() const;
+
+		/// <summary>
+		/// <para>Mute this bus (tracks keep going).</para>
+		/// </summary>
+		/// <param name="{bool}">If true, mute, else unmute.</param>
+		void mute(const bool);
+
+		/// <summary>
+		/// <para>Get bus gain.</para>
+		/// </summary>
+		/// <returns>{float} Gain.</returns>
+		float get_gain() const;
+
+		/// <summary>
+		/// <para>Set bus gain.</para>
+		/// </summary>
+		/// <param name="{float}">Gain.</param>
+		void set_gain(const float);
+	};
+
+	/// <summary>
+	/// <para>soft_mixer is the root soft_bus. Everything attached to it is mixed in-process with SIMD kernels and sent to ONE Allegro audio stream.</para>
+	/// <para>Attach the stream to a mixer or voice, like any other Allegro source. Hundreds of soft_track cost one Allegro instance.</para>
+	/// </summary>
+	class soft_mixer : public soft_bus {
+		ALLEGRO_AUDIO_STREAM* m_stream = nullptr;
+		ALLEGRO_EVENT_QUEUE* m_queue = nullptr;
+		std::thread m_thr;
+		std::atomic<bool> m_keep = false;
+		unsigned m_freq = 48000;
+		size_t m_frag = 0;
+		bool m_offline = false; // created without stream and thread
+
+		void _async();
+	public:
+		soft_mixer();
+		~soft_mixer();
+
+		/// <summary>
+		/// <para>Create the output stream and start mixing (on its own thread).</para>
+		/// <para>This needs an audio device (throws like voice if Allegro can't start one).</para>
+		/// </summary>
+		/// <param name="{unsigned}">Frequency.</param>
+		/// <param name="{size_t}">Amount of buffers in the stream (more is safer, less is lower latency).</param>
+		/// <param name="{size_t}">Frames per buffer.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool create(const unsigned = 48000, const size_t = 4, const size_t = 1024);
+
+		/// <summary>
+		/// <para>Set up for offline rendering only: no stream, no thread, no audio device needed.</para>
+		/// <para>Nothing plays by itself, call render() (or use an offline_voice).</para>
+		/// </summary>
+		/// <param name="{unsigned}">Frequency.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool create_offline(const unsigned = 48000);
+
+		/// <summary>
+		/// <para>Stop and destroy the output stream. Tracks and buses are kept.</para>
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// <para>Attach the output stream into a mixer.</para>
+		/// </summary>
+		/// <param name="{mixer}">The mixer.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool attach_to(const mixer&);
+
+		/// <summary>
+		/// <para>Attach the output stream into a voice device.</para>
+		/// </summary>
+		/// <param name="{voice}">The voice.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool attach_to(const voice&);
+
+		/// <summary>
+		/// <para>Mix everything into a buffer (this is what the stream thread does).</para>
+		/// <para>Useful without a stream too (offline rendering).</para>
+		/// </summary>
+		/// <param name="{float*}">Interleaved stereo buffer (2 * frames floats, overwritten).</param>
+		/// <param name="{size_t}">Frames.</param>
+		void render(float*, const size_t);
+
+		/// <summary>
+		/// <para>Mixing frequency.</para>
+		/// </summary>
+		/// <returns>{unsigned} Frequency, in hertz.</returns>
+		unsigned get_frequency() const;
+
+		/// <summary>
+		/// <para>Is the output stream created (or created offline)?</para>
+		/// </summary>
+		/// <returns>{bool} True if exists.</returns>
+		bool exists() const;
+
+		/// <summary>
+		/// <para>Is the output stream created (or created offline)?</para>
+		/// </summary>
+		/// <returns>{bool} True means not ready/set.</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// <para>Is the output stream created (or created offline)?</para>
+		/// </summary>
+		/// <returns>{bool} True if exists.</returns>
+		bool valid() const;
+	};
+}
+
+#include "softmix.ipp"
\ No newline at end of file
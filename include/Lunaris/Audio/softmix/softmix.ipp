@@ -0,0 +1,17 @@
+#include "softmix.h"
+#pragma once
+
+namespace Lunaris {
+
+	template<typename T, typename ...Args>
+	inline T& soft_bus::effect_emplace_back(Args&&... args)
+	{
+		static_assert(std::is_base_of_v<soft_effect, T>, "Effects must be soft_effect!");
+		std::unique_ptr<T> eff = std::make_unique<T>(std::forward<Args>(args)...);
+		T& ref = *eff;
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_effects.push_back(std::move(eff));
+		return ref;
+	}
+
+}
\ No newline at end of file
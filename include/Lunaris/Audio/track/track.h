@@ -11,6 +11,11 @@ namespace Lunaris {
 	/// <para>track is a playable sample commonly attached to a mixer.</para>
 	/// </summary>
 	class track : public NonCopyable {
+		/*
+		* Friend class track_pool: it creates the instances once (without a sample) and reuses them.
+		*/
+		friend class track_pool;
+
 		ALLEGRO_SAMPLE_INSTANCE* playing = nullptr;
 		unsigned paused_at = 0;
 
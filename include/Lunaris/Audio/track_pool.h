@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "track_pool/track_pool.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "track_pool/track_pool.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "track_pool.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL bool track_pool::handle::valid() const
+	{
+		return index != static_cast<size_t>(-1);
+	}
+
+	LUNARIS_DECL track_pool::slot* track_pool::_get(const handle& hdl)
+	{
+		if (hdl.index >= m_slots.size()) return nullptr;
+		slot& sl = m_slots[hdl.index];
+		return sl.generation == hdl.generation ? &sl : nullptr;
+	}
+
+	LUNARIS_DECL bool track_pool::create(const mixer& mx, const size_t amount)
+	{
+		destroy();
+		if (!mx.exists() || amount == 0) return false;
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_slots = std::vector<slot>(amount);
+
+		for (auto& it : m_slots) {
+			if (!it.tk.set(al_create_sample_instance(nullptr)) || !it.tk.attach_to(mx)) {
+				m_slots.clear();
+				return false;
+			}
+			al_set_sample_instance_playing(it.tk.playing, false);
+		}
+		return true;
+	}
+
+	LUNARIS_DECL void track_pool::destroy()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_slots.clear();
+	}
+
+	LUNARIS_DECL track_pool::handle track_pool::play(const sample& sp, const int priority, const float gain, const float pan, const float speed)
+	{
+		if (sp.empty()) return {};
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		slot* pick = nullptr;
+
+		for (auto& it : m_slots) {
+			if (!it.tk.is_playing()) {
+				pick = &it;
+				break;
+			}
+		}
+
+		if (!pick && m_steal != track_pool_steal_e::NONE) {
+			float pick_gain = 0.0f;
+			for (auto& it : m_slots) {
+				if (it.priority > priority) continue;
+				const float gain_now = m_steal == track_pool_steal_e::QUIETEST ? it.tk.get_gain() : 0.0f; // what it sounds like now, not what was asked on play
+				if (!pick || it.priority < pick->priority) {
+					pick = &it;
+					pick_gain = gain_now;
+					continue;
+				}
+				if (it.priority != pick->priority) continue;
+				if (m_steal == track_pool_steal_e::OLDEST ? (it.started < pick->started) : (gain_now < pick_gain)) {
+					pick = &it;
+					pick_gain = gain_now;
+				}
+			}
+		}
+
+		if (!pick) return {}; // dropped
+
+		pick->tk.stop();
+		if (!pick->tk.load(sp)) return {}; // instance is reused, only the sample changes
+		pick->tk.set_play_mode(ALLEGRO_PLAYMODE_ONCE);
+		pick->tk.set_gain(gain);
+		pick->tk.set_pan(pan);
+		pick->tk.set_speed(speed);
+		pick->tk.play();
+
+		pick->priority = priority;
+		pick->started = ++m_counter;
+
+		handle hdl;
+		hdl.index = static_cast<size_t>(pick - m_slots.data());
+		hdl.generation = ++pick->generation;
+		return hdl;
+	}
+
+	LUNARIS_DECL bool track_pool::stop(const handle& hdl)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		slot* sl = _get(hdl);
+		if (!sl || !sl->tk.is_playing()) return false;
+		sl->tk.stop();
+		return true;
+	}
+
+	LUNARIS_DECL bool track_pool::is_playing(const handle& hdl) const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (hdl.index >= m_slots.size()) return false;
+		const slot& sl = m_slots[hdl.index];
+		return sl.generation == hdl.generation && sl.tk.is_playing();
+	}
+
+	LUNARIS_DECL bool track_pool::apply(const handle& hdl, const std::function<void(track&)>& f)
+	{
+		if (!f) return false;
+		std::lock_guard<std::mutex> luck(m_safe);
+		slot* sl = _get(hdl);
+		if (!sl) return false;
+		f(sl->tk);
+		return true;
+	}
+
+	LUNARIS_DECL void track_pool::stop_all()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		for (auto& it : m_slots) it.tk.stop();
+	}
+
+	LUNARIS_DECL void track_pool::set_steal_mode(const track_pool_steal_e mode)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		m_steal = mode;
+	}
+
+	LUNARIS_DECL size_t track_pool::size() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_slots.size();
+	}
+
+	LUNARIS_DECL size_t track_pool::playing_size() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		size_t count = 0;
+		for (const auto& it : m_slots) {
+			if (it.tk.is_playing()) ++count;
+		}
+		return count;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Audio/voice.h>
+#include <Lunaris/Audio/mixer.h>
+#include <Lunaris/Audio/sample.h>
+#include <Lunaris/Audio/track.h>
+
+#include <vector>
+#include <mutex>
+#include <functional>
+
+namespace Lunaris {
+
+	enum class track_pool_steal_e {
+		OLDEST,		// the one playing for longer
+		QUIETEST,	// the one with lowest gain right now
+		NONE		// never steal, drop the new one
+	};
+
+	/// <summary>
+	/// <para>track_pool is a fixed amount of tracks attached once to a mixer and reused for short one-shot sounds (SFX).</para>
+	/// <para>No instance is created or attached while playing. When all are busy, a voice with lower or same priority is stolen (oldest or quietest).</para>
+	/// </summary>
+	class track_pool : public NonCopyable, public NonMovable {
+	public:
+		/// <summary>
+		/// <para>Reference to a sound played by the pool. It gets invalid when the sound ends or its voice is stolen.</para>
+		/// </summary>
+		struct handle {
+			size_t index = static_cast<size_t>(-1);
+			uint64_t generation = 0;
+
+			/// <summary>
+			/// <para>Did the pool play it at all?</para>
+			/// </summary>
+			/// <returns>{bool} False if the sound was dropped.</returns>
+			bool valid() const;
+		};
+	private:
+		struct slot {
+			track tk;
+			int priority = 0;
+			uint64_t generation = 0; // changes every reuse
+			uint64_t started = 0; // play order
+		};
+
+		std::vector<slot> m_slots;
+		mutable std::mutex m_safe;
+		uint64_t m_counter = 0;
+		track_pool_steal_e m_steal = track_pool_steal_e::OLDEST;
+
+		slot* _get(const handle&); // m_safe must be locked
+	public:
+		track_pool() = default;
+
+		/// <summary>
+		/// <para>Create the tracks and attach them to a mixer (destroys old ones, if any).</para>
+		/// </summary>
+		/// <param name="{mixer}">The mixer.</param>
+		/// <param name="{size_t}">Amount of voices.</param>
+		/// <returns>{bool} True if all of them were created and attached.</returns>
+		bool create(const mixer&, const size_t);
+
+		/// <summary>
+		/// <para>Stop and destroy all tracks.</para>
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// <para>Play a sample once on a free voice (or a stolen one).</para>
+		/// </summary>
+		/// <param name="{sample}">The sample (must exist while it plays).</param>
+		/// <param name="{int}">Priority (higher steals lower or same, never the opposite).</param>
+		/// <param name="{float}">Gain.</param>
+		/// <param name="{float}">Pan.</param>
+		/// <param name="{float}">Speed.</param>
+		/// <returns>{handle} The sound handle (not valid if it was dropped).</returns>
+		handle play(const sample&, const int = 0, const float = 1.0f, const float = 0.0f, const float = 1.0f);
+
+		/// <summary>
+		/// <para>Stop a sound (if it still owns its voice).</para>
+		/// </summary>
+		/// <param name="{handle}">The sound handle.</param>
+		/// <returns>{bool} True if it was playing.</returns>
+		bool stop(const handle&);
+
+		/// <summary>
+		/// <para>Is this sound still playing?</para>
+		/// </summary>
+		/// <param name="{handle}">The sound handle.</param>
+		/// <returns>{bool} True if playing.</returns>
+		bool is_playing(const handle&) const;
+
+		/// <summary>
+		/// <para>Do something with the track of a sound (gain, position...), if it still owns its voice.</para>
+		/// </summary>
+		/// <param name="{handle}">The sound handle.</param>
+		/// <param name="{function}">Function called with the track (pool locked while in there).</param>
+		/// <returns>{bool} True if the function was called.</returns>
+		bool apply(const handle&, const std::function<void(track&)>&);
+
+		/// <summary>
+		/// <para>Stop all sounds.</para>
+		/// </summary>
+		void stop_all();
+
+		/// <summary>
+		/// <para>How to choose a voice to steal when all of them are busy.</para>
+		/// </summary>
+		/// <param name="{track_pool_steal_e}">Steal mode.</param>
+		void set_steal_mode(const track_pool_steal_e);
+
+		/// <summary>
+		/// <para>Amount of voices.</para>
+		/// </summary>
+		/// <returns>{size_t} Voices.</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// <para>Amount of voices playing right now.</para>
+		/// </summary>
+		/// <returns>{size_t} Voices playing.</returns>
+		size_t playing_size() const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "track_stream/track_stream.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "track_stream/track_stream.cpp"
+#endif
\ No newline at end of file
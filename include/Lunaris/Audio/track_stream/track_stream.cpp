@@ -0,0 +1,277 @@
+#include "track_stream.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL bool track_stream::set(ALLEGRO_AUDIO_STREAM* st)
+	{
+		if (st) {
+#ifdef LUNARIS_VERBOSE_BUILD
+			if (playing) PRINT_DEBUG("Moved track stream %p <- %p", playing, st);
+			else PRINT_DEBUG("New track stream %p", st);
+#endif
+			destroy();
+			playing = st;
+			al_set_audio_stream_playing(playing, false);
+			return true;
+		}
+		return false;
+	}
+
+	LUNARIS_DECL track_stream::track_stream()
+	{
+		__audio_allegro_start(); // from voice.h
+	}
+
+	LUNARIS_DECL track_stream::~track_stream()
+	{
+		destroy();
+	}
+
+	LUNARIS_DECL track_stream::track_stream(track_stream&& ts) noexcept
+		: playing(ts.playing), fileref(std::move(ts.fileref))
+	{
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Moved track stream new <- %p", ts.playing);
+#endif
+		ts.playing = nullptr;
+	}
+
+	LUNARIS_DECL void track_stream::operator=(track_stream&& ts) noexcept
+	{
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Moved track stream %p <- %p", playing, ts.playing);
+#endif
+		destroy();
+		playing = ts.playing;
+		fileref = std::move(ts.fileref);
+		ts.playing = nullptr;
+	}
+
+	LUNARIS_DECL bool track_stream::load(const std::string& path, const size_t buffers, const unsigned samples)
+	{
+		return set(al_load_audio_stream(path.c_str(), buffers, samples));
+	}
+
+	LUNARIS_DECL bool track_stream::load(const hybrid_memory<file>& ref, const std::string& ident, const size_t buffers, const unsigned samples)
+	{
+		if (ref.empty() || !ref->get_fp()) return false;
+
+		std::string type = ident;
+		if (type.empty()) {
+			const std::string& path = ref->get_path();
+			const size_t dot = path.rfind('.');
+			if (dot == std::string::npos) return false;
+			type = path.substr(dot);
+		}
+
+		destroy();
+
+		hybrid_memory<file> cpy = ref;
+		cpy->seek(0, file::seek_mode_e::BEGIN);
+		cpy->modify_no_destroy(true); // https://www.allegro.cc/manual/5/al_load_audio_stream_f: the stream closes the file when destroyed.
+
+		if (!set(al_load_audio_stream_f(cpy->get_fp(), type.c_str(), buffers, samples))) {
+			cpy->modify_no_destroy(false); // not owned, back to normal
+			return false;
+		}
+
+		fileref = cpy;
+		return true;
+	}
+
+	LUNARIS_DECL void track_stream::destroy()
+	{
+		if (playing) {
+#ifdef LUNARIS_VERBOSE_BUILD
+			PRINT_DEBUG("Del track stream %p", playing);
+#endif
+			al_destroy_audio_stream(playing);
+			playing = nullptr;
+		}
+		if (!fileref.empty()) {
+			fileref->close(); // the handle is gone with the stream, just forget it (no destroy was set)
+			fileref.reset_this();
+		}
+	}
+
+	LUNARIS_DECL bool track_stream::attach_to(const mixer& mx)
+	{
+		return playing && mx.exists() && al_attach_audio_stream_to_mixer(playing, mx.mixing);
+	}
+
+	LUNARIS_DECL bool track_stream::exists() const
+	{
+		return playing != nullptr;
+	}
+
+	LUNARIS_DECL bool track_stream::empty() const
+	{
+		return playing == nullptr;
+	}
+
+	LUNARIS_DECL bool track_stream::valid() const
+	{
+		return playing != nullptr;
+	}
+
+	LUNARIS_DECL void track_stream::play()
+	{
+		if (!exists()) return;
+		if (is_playing()) return;
+		al_set_audio_stream_playing(playing, true);
+	}
+
+	LUNARIS_DECL void track_stream::pause()
+	{
+		if (!exists()) return;
+		al_set_audio_stream_playing(playing, false);
+	}
+
+	LUNARIS_DECL void track_stream::stop()
+	{
+		if (!exists()) return;
+		al_set_audio_stream_playing(playing, false);
+		al_rewind_audio_stream(playing);
+	}
+
+	LUNARIS_DECL bool track_stream::is_playing() const
+	{
+		if (!exists()) return false;
+		return al_get_audio_stream_playing(playing);
+	}
+
+	LUNARIS_DECL ALLEGRO_CHANNEL_CONF track_stream::get_channel_configuration() const
+	{
+		if (!exists()) return {};
+		return al_get_audio_stream_channels(playing);
+	}
+
+	LUNARIS_DECL size_t track_stream::get_channels_num() const
+	{
+		if (!exists()) return 0;
+		return al_get_channel_count(get_channel_configuration());
+	}
+
+	LUNARIS_DECL ALLEGRO_AUDIO_DEPTH track_stream::get_depth() const
+	{
+		if (!exists()) return {};
+		return al_get_audio_stream_depth(playing);
+	}
+
+	LUNARIS_DECL int track_stream::get_depth_bits() const
+	{
+		if (!exists()) return {};
+		switch (al_get_audio_stream_depth(playing)) {
+		case ALLEGRO_AUDIO_DEPTH_INT8:
+		case ALLEGRO_AUDIO_DEPTH_UINT8:
+			return 8;
+		case ALLEGRO_AUDIO_DEPTH_INT16:
+		case ALLEGRO_AUDIO_DEPTH_UINT16:
+			return 16;
+		case ALLEGRO_AUDIO_DEPTH_INT24:
+		case ALLEGRO_AUDIO_DEPTH_UINT24:
+			return 24;
+		case ALLEGRO_AUDIO_DEPTH_FLOAT32:
+			return 32;
+		default:
+			return 0;
+		}
+	}
+
+	LUNARIS_DECL unsigned track_stream::get_frequency() const
+	{
+		if (!exists()) return 0;
+		return al_get_audio_stream_frequency(playing);
+	}
+
+	LUNARIS_DECL unsigned track_stream::get_length_samples() const
+	{
+		if (!exists()) return 0;
+		return static_cast<unsigned>(al_get_audio_stream_length_secs(playing) * get_frequency());
+	}
+
+	LUNARIS_DECL size_t track_stream::get_length_ms() const
+	{
+		if (!exists()) return 0;
+		return static_cast<size_t>(1000.0 * al_get_audio_stream_length_secs(playing));
+	}
+
+	LUNARIS_DECL unsigned track_stream::get_position_samples() const
+	{
+		if (!exists()) return 0;
+		return static_cast<unsigned>(al_get_audio_stream_position_secs(playing) * get_frequency());
+	}
+
+	LUNARIS_DECL void track_stream::set_position_samples(const unsigned pos)
+	{
+		if (!exists() || get_frequency() == 0) return;
+		al_seek_audio_stream_secs(playing, static_cast<double>(pos) / get_frequency());
+	}
+
+	LUNARIS_DECL size_t track_stream::get_position_ms() const
+	{
+		if (!exists()) return 0;
+		return static_cast<size_t>(1000.0 * al_get_audio_stream_position_secs(playing));
+	}
+
+	LUNARIS_DECL void track_stream::set_position_ms(const size_t ms)
+	{
+		if (!exists()) return;
+		al_seek_audio_stream_secs(playing, ms / 1000.0);
+	}
+
+	LUNARIS_DECL float track_stream::get_speed() const
+	{
+		if (!exists()) return 0.0f;
+		return al_get_audio_stream_speed(playing);
+	}
+
+	LUNARIS_DECL void track_stream::set_speed(const float speed)
+	{
+		if (!exists()) return;
+		al_set_audio_stream_speed(playing, speed);
+	}
+
+	LUNARIS_DECL float track_stream::get_gain() const
+	{
+		if (!exists()) return 0.0f;
+		return al_get_audio_stream_gain(playing);
+	}
+
+	LUNARIS_DECL void track_stream::set_gain(const float gain)
+	{
+		if (!exists()) return;
+		al_set_audio_stream_gain(playing, gain);
+	}
+
+	LUNARIS_DECL float track_stream::get_pan() const
+	{
+		if (!exists()) return 0.0f;
+		return al_get_audio_stream_pan(playing);
+	}
+
+	LUNARIS_DECL void track_stream::set_pan(const float pan)
+	{
+		if (!exists()) return;
+		al_set_audio_stream_pan(playing, pan);
+	}
+
+	LUNARIS_DECL float track_stream::get_time_s() const
+	{
+		if (!exists()) return 0.0f;
+		return static_cast<float>(al_get_audio_stream_length_secs(playing));
+	}
+
+	LUNARIS_DECL ALLEGRO_PLAYMODE track_stream::get_play_mode() const
+	{
+		if (!exists()) return {};
+		return al_get_audio_stream_playmode(playing);
+	}
+
+	LUNARIS_DECL void track_stream::set_play_mode(const ALLEGRO_PLAYMODE mode)
+	{
+		if (!exists()) return;
+		al_set_audio_stream_playmode(playing, mode == ALLEGRO_PLAYMODE_BIDIR ? ALLEGRO_PLAYMODE_LOOP : mode);
+	}
+
+}
\ No newline at end of file
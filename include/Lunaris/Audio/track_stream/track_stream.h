@@ -0,0 +1,224 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Audio/voice.h>
+#include <Lunaris/Audio/mixer.h>
+#include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/memory.h>
+
+#include <string>
+
+namespace Lunaris {
+
+	constexpr size_t track_stream_default_buffers = 4;
+	constexpr unsigned track_stream_default_samples = 2048;
+
+	/// <summary>
+	/// <para>track_stream is a playable file decoded little by little while it plays (ALLEGRO_AUDIO_STREAM), commonly attached to a mixer.</para>
+	/// <para>Use this for music and long tracks: only a few buffers are kept in memory and loading is almost instant.</para>
+	/// <para>Decoding happens on Allegro's stream thread. Same controls as track (except BIDIR play mode, not supported by streams).</para>
+	/// </summary>
+	class track_stream : public NonCopyable {
+		ALLEGRO_AUDIO_STREAM* playing = nullptr;
+		hybrid_memory<file> fileref; // if loaded from a file, the stream owns its handle
+
+		bool set(ALLEGRO_AUDIO_STREAM*);
+	public:
+		track_stream();
+		~track_stream();
+
+		track_stream(track_stream&&) noexcept;
+		void operator=(track_stream&&) noexcept;
+
+		/// <summary>
+		/// <para>Open a file to stream. Starts paused.</para>
+		/// </summary>
+		/// <param name="{std::string}">The path to the file.</param>
+		/// <param name="{size_t}">Amount of buffers (more is safer against hiccups, less uses less memory).</param>
+		/// <param name="{unsigned}">Samples per buffer.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool load(const std::string&, const size_t = track_stream_default_buffers, const unsigned = track_stream_default_samples);
+
+		/// <summary>
+		/// <para>Stream from an open file. Starts paused.</para>
+		/// <para>The stream takes the file handle for itself until destroyed. Don't read or close that file while this uses it.</para>
+		/// </summary>
+		/// <param name="{hybrid_memory&lt;file&gt;}">The file (read mode).</param>
+		/// <param name="{std::string}">File type as extension (like ".ogg"). Empty uses the file path extension.</param>
+		/// <param name="{size_t}">Amount of buffers (more is safer against hiccups, less uses less memory).</param>
+		/// <param name="{unsigned}">Samples per buffer.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool load(const hybrid_memory<file>&, const std::string& = {}, const size_t = track_stream_default_buffers, const unsigned = track_stream_default_samples);
+
+		/// <summary>
+		/// <para>Destroy this stream, if exists.</para>
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// <para>Attach this to a mixer.</para>
+		/// </summary>
+		/// <param name="{mixer}">The mixer.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool attach_to(const mixer&);
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if loaded.</returns>
+		bool exists() const;
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if not ready/set.</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// <para>Is this loaded?</para>
+		/// </summary>
+		/// <returns>{bool} True if loaded.</returns>
+		bool valid() const;
+
+		/// <summary>
+		/// <para>Play/Resume.</para>
+		/// </summary>
+		void play();
+
+		/// <summary>
+		/// <para>Pause (position is kept).</para>
+		/// </summary>
+		void pause();
+
+		/// <summary>
+		/// <para>Stop and reset.</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Is it playing?</para>
+		/// </summary>
+		/// <returns>{bool} Playing.</returns>
+		bool is_playing() const;
+
+		/// <summary>
+		/// <para>Get this stream audio configuration.</para>
+		/// </summary>
+		/// <returns>{ALLEGRO_CHANNEL_CONF} Audio configuration.</returns>
+		ALLEGRO_CHANNEL_CONF get_channel_configuration() const;
+
+		/// <summary>
+		/// <para>How many channels does this stream have?</para>
+		/// </summary>
+		/// <returns>{size_t} Number of channels.</returns>
+		size_t get_channels_num() const;
+
+		/// <summary>
+		/// <para>What is the depth/resolution of this stream?</para>
+		/// </summary>
+		/// <returns>{ALLEGRO_AUDIO_DEPTH} The depth.</returns>
+		ALLEGRO_AUDIO_DEPTH get_depth() const;
+
+		/// <summary>
+		/// <para>What is the depth/resolution of this stream?</para>
+		/// </summary>
+		/// <returns>{int} The depth in bits.</returns>
+		int get_depth_bits() const;
+
+		/// <summary>
+		/// <para>What frequency is this stream?</para>
+		/// </summary>
+		/// <returns>{unsigned} Frequency, in hertz.</returns>
+		unsigned get_frequency() const;
+
+		/// <summary>
+		/// <para>Get the full length in samples (if the codec knows it).</para>
+		/// </summary>
+		/// <returns>{unsigned} samples.</returns>
+		unsigned get_length_samples() const;
+
+		/// <summary>
+		/// <para>Full length in milliseconds (if the codec knows it).</para>
+		/// </summary>
+		/// <returns>{size_t} Milliseconds.</returns>
+		size_t get_length_ms() const;
+
+		/// <summary>
+		/// <para>Get the position in samples.</para>
+		/// </summary>
+		/// <returns>{unsigned} samples since start.</returns>
+		unsigned get_position_samples() const;
+
+		/// <summary>
+		/// <para>Set the position in samples (seek).</para>
+		/// </summary>
+		/// <param name="{unsigned}">Position in samples</param>
+		void set_position_samples(const unsigned);
+
+		/// <summary>
+		/// <para>Get position in milliseconds.</para>
+		/// </summary>
+		/// <returns>{size_t} Position in milliseconds.</returns>
+		size_t get_position_ms() const;
+
+		/// <summary>
+		/// <para>Set the position in milliseconds (seek).</para>
+		/// </summary>
+		/// <param name="{size_t}">Position in milliseconds.</param>
+		void set_position_ms(const size_t);
+
+		/// <summary>
+		/// <para>Get current speed.</para>
+		/// </summary>
+		/// <returns>{float} Speed.</returns>
+		float get_speed() const;
+
+		/// <summary>
+		/// <para>Set speed.</para>
+		/// </summary>
+		/// <param name="{float}">Speed.</param>
+		void set_speed(const float);
+
+		/// <summary>
+		/// <para>Get current gain.</para>
+		/// </summary>
+		/// <returns>{float} Gain.</returns>
+		float get_gain() const;
+
+		/// <summary>
+		/// <para>Set gain.</para>
+		/// </summary>
+		/// <param name="{float}">Gain.</param>
+		void set_gain(const float);
+
+		/// <summary>
+		/// <para>Get current pan/balance.</para>
+		/// </summary>
+		/// <returns>{float} Pan.</returns>
+		float get_pan() const;
+
+		/// <summary>
+		/// <para>Set pan/balance.</para>
+		/// </summary>
+		/// <param name="{float}">Pan.</param>
+		void set_pan(const float);
+
+		/// <summary>
+		/// <para>Get full length in seconds (if the codec knows it).</para>
+		/// </summary>
+		/// <returns>{float} Precise length in seconds.</returns>
+		float get_time_s() const;
+
+		/// <summary>
+		/// <para>Get playing mode.</para>
+		/// </summary>
+		/// <returns>{ALLEGRO_PLAYMODE} Mode.</returns>
+		ALLEGRO_PLAYMODE get_play_mode() const;
+
+		/// <summary>
+		/// <para>Set playing mode (ONCE or LOOP).</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_PLAYMODE}">New mode.</param>
+		void set_play_mode(const ALLEGRO_PLAYMODE);
+	};
+}
\ No newline at end of file
@@ -9,6 +9,14 @@ namespace Lunaris {
 			throw std::runtime_error("Can't start Audio or Audio Codec!");
 	}
 
+	LUNARIS_DECL void __audio_allegro_start_headless()
+	{
+		if (!al_is_system_installed() && !al_init()) throw std::runtime_error("Can't start Allegro!");
+		if (!al_is_audio_installed()) al_install_audio(); // may fail without a device, samples and codecs work anyway
+		if (!al_is_acodec_addon_initialized() && !al_init_acodec_addon())
+			throw std::runtime_error("Can't start Audio Codec!");
+	}
+
 	LUNARIS_DECL bool voice::set(ALLEGRO_VOICE* nc)
 	{
 		if (nc) {
@@ -12,6 +12,7 @@ namespace Lunaris {
 	constexpr int voice_audio_samples = LUNARIS_AUTOSET_AUDIO_SAMPLE_AMOUNT;
 
 	void __audio_allegro_start();
+	void __audio_allegro_start_headless(); // no device needed: decoding and soft mixing only (no al_reserve_samples)
 
 	/// <summary>
 	/// <para>voice is an audio device. You can attach ONE mixer to this.</para>
@@ -19,8 +20,10 @@ namespace Lunaris {
 	class voice : public NonCopyable {
 		/*
 		* Friend class mixer: because mixer should link to a voice, and it's better if you just set(voice). get_instance is just another friend-like.
+		* Friend class soft_mixer: its stream should link to a voice the same way.
 		*/
 		friend class mixer;
+		friend class soft_mixer;
 
 		ALLEGRO_VOICE* device = nullptr;
 
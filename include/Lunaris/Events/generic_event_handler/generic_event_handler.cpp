@@ -2,88 +2,255 @@
 
 namespace Lunaris {
 
-	LUNARIS_DECL void generic_event_handler::core::_async()
+	LUNARIS_DECL void event_dispatcher::worker::_async()
+	{
+		while (1) {
+			std::unique_lock<std::mutex> luck(m_safe);
+			m_cond.wait(luck, [this] { return !m_keep || !m_list.empty(); });
+			if (m_list.empty()) return; // !m_keep and nothing left
+
+			auto work = std::move(m_list.front());
+			m_list.pop_front();
+			luck.unlock();
+
+			if (auto targ = work.first.lock(); targ) targ->_deliver(work.second);
+		}
+	}
+
+	LUNARIS_DECL void event_dispatcher::_async()
 	{
-		m_run_confirm = true;
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Event handler thread spawned %p", this);
+		PRINT_DEBUG("Event dispatcher thread spawned %p", this);
 #endif
-
 		for (bool keep = true; keep;) {
 			ALLEGRO_EVENT ev;
-			try {
-				al_wait_for_event(m_queue.get(), &ev);
-
-				switch (ev.type) {
-				case +__internal_events::THREAD_QUIT:
-					keep = false;
-					continue;
+			al_wait_for_event(m_queue.get(), &ev);
+
+			if (ev.any.source == m_custom.get()) {
+				if (ev.type == +__internal_events::THREAD_QUIT) keep = false;
+				else if (ev.type == +__internal_events::INJECTED) {
+					std::unique_lock<std::mutex> luck(m_inject_safe);
+					if (m_injected.empty()) continue;
+					ALLEGRO_EVENT inj = m_injected.front();
+					m_injected.pop_front();
+					luck.unlock();
+					_route(inj);
 				}
-
-				std::lock_guard<std::recursive_mutex> luck(m_safe);
-				if (m_evhlr) m_evhlr(ev);
+				continue;
 			}
-			catch (const std::exception& e) {
+
+			_route(ev);
+		}
 #ifdef LUNARIS_VERBOSE_BUILD
-				PRINT_DEBUG("Event queue exception %p: %s", this, e.what());
+		PRINT_DEBUG("Event dispatcher thread ended %p", this);
 #endif
-				if (m_err) m_err(e);
+	}
+
+	LUNARIS_DECL void event_dispatcher::_route(const ALLEGRO_EVENT& ev)
+	{
+		{
+			std::lock_guard<std::mutex> luck(m_map_safe);
+			auto it = m_map.find(ev.any.source);
+			if (it == m_map.end()) return;
+			m_temp = it->second;
+		}
+
+		std::unique_lock<std::mutex> luck(m_workers_safe);
+		if (m_workers.empty()) {
+			luck.unlock();
+			for (auto& it : m_temp) if (auto targ = it.ref.lock(); targ) targ->_deliver(ev);
+		}
+		else {
+			for (auto& it : m_temp) {
+				worker& wrk = *m_workers[std::hash<const void*>{}(it.id) % m_workers.size()];
+				{
+					std::lock_guard<std::mutex> wluck(wrk.m_safe);
+					wrk.m_list.push_back({ it.ref, ev });
+				}
+				wrk.m_cond.notify_one();
 			}
-			catch (...) {
-#ifdef LUNARIS_VERBOSE_BUILD
-				PRINT_DEBUG("Event queue exception %p: UNCAUGHT", this);
-#endif
-				if (m_err) m_err(std::runtime_error("UNCAUGHT"));
+		}
+	}
+
+	LUNARIS_DECL void event_dispatcher::_stop_workers()
+	{
+		for (auto& it : m_workers) {
+			{
+				std::lock_guard<std::mutex> luck(it->m_safe);
+				it->m_keep = false;
 			}
+			it->m_cond.notify_all();
 		}
-#ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Event handler thread ended %p", this);
-#endif
-		m_run_confirm = false;
+		for (auto& it : m_workers) if (it->m_thr.joinable()) it->m_thr.join();
+		m_workers.clear();
 	}
 
-	LUNARIS_DECL generic_event_handler::core::core()
+	LUNARIS_DECL event_dispatcher::event_dispatcher()
 		: m_queue(make_unique_queue()), m_custom(make_unique_user_event_source())
 	{
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Created event queue %p", this);
+		PRINT_DEBUG("Created event dispatcher %p", this);
 #endif
 		al_register_event_source(m_queue.get(), m_custom.get());
 		m_thr = std::thread([this] { _async(); });
 	}
 
-	LUNARIS_DECL generic_event_handler::core::~core()
+	LUNARIS_DECL event_dispatcher::~event_dispatcher()
+	{
+		_shutdown();
+	}
+
+	LUNARIS_DECL void event_dispatcher::_shutdown()
 	{
+		if (!m_thr.joinable()) return;
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Destroyed event queue %p", this);
+		PRINT_DEBUG("Shutting down event dispatcher %p", this);
 #endif
-		if (m_run_confirm) {
+		ALLEGRO_EVENT ev;
+		ev.user.type = +__internal_events::THREAD_QUIT;
+		ev.user.source = m_custom.get();
+		if (!al_emit_user_event(m_custom.get(), &ev, nullptr)) {
+#ifdef LUNARIS_VERBOSE_BUILD
+			PRINT_DEBUG("Skipped emit user event kill thread @ event dispatcher. Probably already ended?!");
+#endif
+		}
+		m_thr.join();
+
+		{
+			std::lock_guard<std::mutex> luck(m_workers_safe);
+			_stop_workers();
+		}
+		{
+			std::lock_guard<std::mutex> luck(m_inject_safe);
+			m_injected.clear();
+		}
+		std::lock_guard<std::mutex> luck(m_map_safe);
+		m_map.clear();
+		m_queue.reset(); // first
+		m_custom.reset();
+	}
+
+	LUNARIS_DECL event_dispatcher& event_dispatcher::get()
+	{
+		// never deleted: handlers living in static storage may call remove() after this would have been destroyed.
+		static event_dispatcher* disp = new event_dispatcher();
+		// this is destroyed after al_init, so the thread and the Allegro queue are gone before Allegro ends.
+		static const struct __stopper { ~__stopper() { disp->_shutdown(); } } stopper;
+		return *disp;
+	}
+
+	LUNARIS_DECL void event_dispatcher::add(ALLEGRO_EVENT_SOURCE* src, const std::shared_ptr<__event_target>& targ)
+	{
+		if (!src || !targ) return;
+		std::lock_guard<std::mutex> luck(m_map_safe);
+		if (!m_queue) return; // shut down
+		auto& vec = m_map[src];
+		for (const auto& it : vec) if (it.id == targ.get()) return; // already there
+		if (vec.empty()) al_register_event_source(m_queue.get(), src);
+		vec.push_back({ targ.get(), targ });
+	}
+
+	LUNARIS_DECL void event_dispatcher::remove(ALLEGRO_EVENT_SOURCE* src, const __event_target* targ)
+	{
+		if (!src) return;
+		std::lock_guard<std::mutex> luck(m_map_safe);
+		if (!m_queue) return; // shut down, nothing registered
+		auto it = m_map.find(src);
+		if (it == m_map.end()) return;
+		auto& vec = it->second;
+		vec.erase(std::remove_if(vec.begin(), vec.end(), [&](const target_ref& r) { return r.id == targ || r.ref.expired(); }), vec.end());
+		if (vec.empty()) {
+			al_unregister_event_source(m_queue.get(), src);
+			m_map.erase(it);
+		}
+	}
+
+	LUNARIS_DECL bool event_dispatcher::inject(const ALLEGRO_EVENT& ev)
+	{
+		std::lock_guard<std::mutex> luck(m_inject_safe); // keeps order between threads injecting
+		std::lock_guard<std::mutex> luck2(m_map_safe); // shutdown can't happen in between
+		if (!m_custom) return false; // shut down
+		m_injected.push_back(ev);
+
+		ALLEGRO_EVENT wake;
+		wake.user.type = +__internal_events::INJECTED;
+		wake.user.source = m_custom.get();
+		if (!al_emit_user_event(m_custom.get(), &wake, nullptr)) {
+			m_injected.pop_back();
+			return false;
+		}
+		return true;
+	}
+
+	LUNARIS_DECL void event_dispatcher::set_workers(const size_t amount)
+	{
+		std::lock_guard<std::mutex> luck(m_workers_safe);
+		for (const auto& it : m_workers) if (it->m_thr.get_id() == std::this_thread::get_id()) throw std::runtime_error("Can't change event workers from an event worker!");
+		_stop_workers();
+		for (size_t p = 0; p < amount; ++p) {
+			m_workers.push_back(std::make_unique<worker>());
+			worker* wrk = m_workers.back().get();
+			wrk->m_thr = std::thread([wrk] { wrk->_async(); });
+		}
+	}
+
+	LUNARIS_DECL size_t event_dispatcher::get_workers()
+	{
+		std::lock_guard<std::mutex> luck(m_workers_safe);
+		return m_workers.size();
+	}
+
+	LUNARIS_DECL size_t event_dispatcher::size()
+	{
+		std::lock_guard<std::mutex> luck(m_map_safe);
+		return m_map.size();
+	}
+
+	LUNARIS_DECL void generic_event_handler::core::_deliver(const ALLEGRO_EVENT& ref)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (m_dead) return;
+		try {
+			ALLEGRO_EVENT ev = ref;
+			if (m_evhlr) m_evhlr(ev);
+		}
+		catch (const std::exception& e) {
 #ifdef LUNARIS_VERBOSE_BUILD
-			PRINT_DEBUG("Event handler waiting async event thread to stop.");
+			PRINT_DEBUG("Event queue exception %p: %s", this, e.what());
 #endif
-			signal_stop();
-			if (m_thr.joinable()) m_thr.join();
+			if (m_err) m_err(e);
+		}
+		catch (...) {
 #ifdef LUNARIS_VERBOSE_BUILD
-			PRINT_DEBUG("Event handler has ended all tasks.");
+			PRINT_DEBUG("Event queue exception %p: UNCAUGHT", this);
 #endif
+			if (m_err) m_err(std::runtime_error("UNCAUGHT"));
 		}
-		m_queue.reset(); // first
 	}
 
-	LUNARIS_DECL void generic_event_handler::core::signal_stop()
+	LUNARIS_DECL generic_event_handler::core::~core()
 	{
-		if (!m_run_confirm) return; // not running
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Signal stop event queue %p", this);
+		PRINT_DEBUG("Destroyed event handler core %p", this);
 #endif
-		ALLEGRO_EVENT ev;
-		ev.user.type = +__internal_events::THREAD_QUIT;
-		ev.user.source = m_custom.get();
-		if (!al_emit_user_event(m_custom.get(), &ev, nullptr)) {
+		signal_stop();
+	}
+
+	LUNARIS_DECL void generic_event_handler::core::signal_stop()
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe); // waits for any event being handled
+		if (m_dead) return;
 #ifdef LUNARIS_VERBOSE_BUILD
-			PRINT_DEBUG("Skipped emit user event kill thread @ common event. Probably already ended?!");
+		PRINT_DEBUG("Signal stop event handler core %p", this);
 #endif
+		m_dead = true;
+		if (m_sources.size()) {
+			auto& disp = event_dispatcher::get();
+			for (const auto& it : m_sources) disp.remove(it, this);
+			m_sources.clear();
 		}
+		m_evhlr = {};
+		m_err = {};
 	}
 
 	LUNARIS_DECL void generic_event_handler::core::set_event_handler(std::function<void(ALLEGRO_EVENT&)> f)
@@ -100,19 +267,37 @@ namespace Lunaris {
 
 	LUNARIS_DECL void generic_event_handler::core::add_event_source(ALLEGRO_EVENT_SOURCE* src)
 	{
-		if (!src || !m_queue) return;
-		al_register_event_source(m_queue.get(), src);
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (!src || m_dead) return;
+		if (std::find(m_sources.begin(), m_sources.end(), src) != m_sources.end()) return;
+		event_dispatcher::get().add(src, shared_from_this());
+		m_sources.push_back(src);
 	}
 
 	LUNARIS_DECL void generic_event_handler::core::remove_event_source(ALLEGRO_EVENT_SOURCE* src)
 	{
-		if (!src || !m_queue) return;
-		al_unregister_event_source(m_queue.get(), src);
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (!src) return;
+		auto it = std::find(m_sources.begin(), m_sources.end(), src);
+		if (it == m_sources.end()) return;
+		event_dispatcher::get().remove(src, this);
+		m_sources.erase(it);
 	}
 
 	LUNARIS_DECL void generic_event_handler::build_if_none()
 	{
-		if (!m_movable) m_movable = std::make_unique<core>();
+		if (!m_movable) m_movable = std::make_shared<core>();
+	}
+
+	LUNARIS_DECL generic_event_handler::~generic_event_handler()
+	{
+		if (m_movable) m_movable->signal_stop(); // no more events after this, even if a worker still holds core
+	}
+
+	LUNARIS_DECL void generic_event_handler::operator=(generic_event_handler&& oth) noexcept
+	{
+		if (m_movable) m_movable->signal_stop();
+		m_movable = std::move(oth.m_movable);
 	}
 
 	LUNARIS_DECL generic_event_handler::core& generic_event_handler::get_core()
@@ -5,6 +5,11 @@
 
 #include <allegro5/allegro.h>
 #include <functional>
+#include <unordered_map>
+#include <vector>
+#include <deque>
+#include <condition_variable>
+#include <algorithm>
 
 namespace Lunaris {
 
@@ -16,7 +21,9 @@ namespace Lunaris {
 		TOUCH		= 1 << 3
 	};
 	enum class __internal_events {
-		THREAD_QUIT = 2048
+		THREAD_QUIT = 2048,
+		SOURCES_CHANGED,
+		INJECTED
 	};
 
 	constexpr int operator+(__internal_events a) { return static_cast<int>(a); }
@@ -25,24 +32,118 @@ namespace Lunaris {
 	constexpr int operator&(events a, events b) { return (static_cast<int>(a) & static_cast<int>(b)); }
 	constexpr events operator^(events a, events b) { return static_cast<events>(static_cast<int>(a) & static_cast<int>(b)); }
 
+	// anything that can get events from event_dispatcher
+	struct __event_target {
+		virtual ~__event_target() = default;
+		virtual void _deliver(const ALLEGRO_EVENT&) = 0;
+	};
+
+	/// <summary>
+	/// <para>event_dispatcher is the one shared thread and queue that feeds every generic_event_handler (and so mouse, keyboard, display_event_handler, menu_event_handler...).</para>
+	/// <para>Events are routed to handlers by their source through a hash map.</para>
+	/// <para>Optionally, handlers can be fanned out to a small worker pool. A handler always runs on the same worker, so its events keep their order.</para>
+	/// <para>NOTE: Handlers on the same thread run one after another. A handler that blocks (sleep, waiting a future from a thread that waits for events...) stalls all of them. Keep handlers short, post long work somewhere else.</para>
+	/// <para>This is created automatically on first use and is never deleted (its thread stops on exit, before Allegro ends).</para>
+	/// </summary>
+	class event_dispatcher : public NonCopyable, public NonMovable {
+		struct target_ref {
+			const __event_target* id;
+			std::weak_ptr<__event_target> ref;
+		};
+		struct worker {
+			std::thread m_thr;
+			std::mutex m_safe;
+			std::condition_variable m_cond;
+			std::deque<std::pair<std::weak_ptr<__event_target>, ALLEGRO_EVENT>> m_list;
+			bool m_keep = true;
+
+			void _async();
+		};
+
+		std::thread m_thr;
+		queue_unique m_queue;
+		user_unique m_custom;
+		std::mutex m_map_safe;
+		std::unordered_map<ALLEGRO_EVENT_SOURCE*, std::vector<target_ref>> m_map;
+		std::mutex m_workers_safe;
+		std::vector<std::unique_ptr<worker>> m_workers;
+		std::vector<target_ref> m_temp; // dispatcher thread only
+		std::mutex m_inject_safe;
+		std::deque<ALLEGRO_EVENT> m_injected; // one INJECTED user event each
+
+		void _async(); // m_thr run
+		void _route(const ALLEGRO_EVENT&); // dispatcher thread only
+		void _stop_workers(); // m_workers_safe must be locked
+		void _shutdown(); // stop threads and free Allegro objects (the object itself stays valid)
+
+		event_dispatcher();
+	public:
+		~event_dispatcher();
+
+		/// <summary>
+		/// <para>Get the shared dispatcher (starts it if needed).</para>
+		/// </summary>
+		/// <returns>{event_dispatcher&amp;} The dispatcher.</returns>
+		static event_dispatcher& get();
+
+		/// <summary>
+		/// <para>Route events from this source to this target. The source is registered on the shared queue on first use.</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_EVENT_SOURCE*}">Event source.</param>
+		/// <param name="{shared_ptr}">Target.</param>
+		void add(ALLEGRO_EVENT_SOURCE*, const std::shared_ptr<__event_target>&);
+
+		/// <summary>
+		/// <para>Stop routing events from this source to this target. The source is unregistered when no one else uses it.</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_EVENT_SOURCE*}">Event source.</param>
+		/// <param name="{__event_target*}">Target.</param>
+		void remove(ALLEGRO_EVENT_SOURCE*, const __event_target*);
+
+		/// <summary>
+		/// <para>Route an event as if it came from the queue: everyone added to ev.any.source gets it, in order, on the usual threads.</para>
+		/// <para>Unlike al_emit_user_event, no field is overwritten (keyboard, mouse, display and timer events are kept as they are).</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_EVENT}">The event (source must be set).</param>
+		/// <returns>{bool} False if shut down.</returns>
+		bool inject(const ALLEGRO_EVENT&);
+
+		/// <summary>
+		/// <para>Set the amount of worker threads handling events. Zero (default) runs handlers on the dispatcher thread itself.</para>
+		/// <para>NOTE: Don't call this from an event handler.</para>
+		/// </summary>
+		/// <param name="{size_t}">Amount of workers.</param>
+		void set_workers(const size_t);
+
+		/// <summary>
+		/// <para>Amount of worker threads.</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of workers (0 means the dispatcher thread does the work).</returns>
+		size_t get_workers();
+
+		/// <summary>
+		/// <para>How many different sources are registered?</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of event sources.</returns>
+		size_t size();
+	};
+
 	/// <summary>
 	/// <para>generic_event_handler can handle any kind of event from Allegro (or based on ALLEGRO_EVENT_SOURCE).</para>
-	/// <para>This is the basic generic async (it creates its own thread) class you've ever wanted.</para>
+	/// <para>This is the basic generic async (events come from the shared event_dispatcher thread) class you've ever wanted.</para>
 	/// <para>The only downside compared to other event classes is that this is raw events. If you're into ALLEGRO_EVENT, have fun!</para>
 	/// </summary>
 	class generic_event_handler : public NonCopyable {
-		struct core : public NonCopyable, public NonMovable {
-			std::thread m_thr;
+		struct core : public __event_target, public std::enable_shared_from_this<core>, public NonCopyable, public NonMovable {
 			std::recursive_mutex m_safe;
-			bool m_run_confirm = false; // m_thr return
+			bool m_dead = false; // signal_stop was called
 			std::function<void(const std::exception&)> m_err; // on error
 			std::function<void(ALLEGRO_EVENT&)> m_evhlr; // on event
-			queue_unique m_queue;
-			user_unique m_custom;
+			std::vector<ALLEGRO_EVENT_SOURCE*> m_sources; // registered on event_dispatcher
 
-			void _async(); // m_thr run
+			void _deliver(const ALLEGRO_EVENT&) override; // event_dispatcher calls this
 
-			core();
+			core() = default;
 			~core();
 
 			void signal_stop(); // deleting calls this
@@ -51,7 +152,7 @@ namespace Lunaris {
 			void add_event_source(ALLEGRO_EVENT_SOURCE*);
 			void remove_event_source(ALLEGRO_EVENT_SOURCE*);
 		};
-		std::unique_ptr<core> m_movable;
+		std::shared_ptr<core> m_movable;
 
 		void build_if_none();
 	protected:
@@ -59,6 +160,10 @@ namespace Lunaris {
 		core* get_core_ptr() const;
 	public:
 		generic_event_handler() = default;
+		~generic_event_handler();
+
+		generic_event_handler(generic_event_handler&&) noexcept = default;
+		void operator=(generic_event_handler&&) noexcept;
 
 		/// <summary>
 		/// <para>Install one or many common event sources.</para>
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "input_state/input_state.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "input_state/input_state.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "input_state.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL bool input_snapshot::is_key_down(const int id) const
+	{
+		if (id < 0 || id >= ALLEGRO_KEY_MAX) return false;
+		return (keys_down[id / 64] >> (id % 64)) & 1;
+	}
+
+	LUNARIS_DECL bool input_snapshot::is_key_pressed(const int id) const
+	{
+		if (id < 0 || id >= ALLEGRO_KEY_MAX) return false;
+		return (keys_pressed[id / 64] >> (id % 64)) & 1;
+	}
+
+	LUNARIS_DECL bool input_snapshot::is_key_released(const int id) const
+	{
+		if (id < 0 || id >= ALLEGRO_KEY_MAX) return false;
+		return (keys_released[id / 64] >> (id % 64)) & 1;
+	}
+
+	LUNARIS_DECL bool input_snapshot::is_button_down(const int id) const
+	{
+		if (id < 0 || id >= 32) return false;
+		return (buttons_down >> id) & 1;
+	}
+
+	LUNARIS_DECL bool input_snapshot::is_button_pressed(const int id) const
+	{
+		if (id < 0 || id >= 32) return false;
+		return (buttons_pressed >> id) & 1;
+	}
+
+	LUNARIS_DECL bool input_snapshot::is_button_released(const int id) const
+	{
+		if (id < 0 || id >= 32) return false;
+		return (buttons_released >> id) & 1;
+	}
+
+	LUNARIS_DECL void input_state::handle_events(const ALLEGRO_EVENT& ev)
+	{
+		switch (ev.type) {
+		case ALLEGRO_EVENT_KEY_DOWN:
+		case ALLEGRO_EVENT_KEY_UP:
+		{
+			const int id = ev.keyboard.keycode;
+			if (id < 0 || id >= ALLEGRO_KEY_MAX) return;
+			const uint64_t bit = uint64_t{ 1 } << (id % 64);
+
+			if (ev.type == ALLEGRO_EVENT_KEY_DOWN) {
+				m_acc.keys_down[id / 64] |= bit;
+				m_acc.keys_pressed[id / 64] |= bit;
+			}
+			else {
+				m_acc.keys_down[id / 64] &= ~bit;
+				m_acc.keys_released[id / 64] |= bit;
+			}
+		}
+			break;
+		case ALLEGRO_EVENT_MOUSE_AXES:
+		case ALLEGRO_EVENT_MOUSE_WARPED:
+			m_acc.mouse_raw_x = ev.mouse.x;
+			m_acc.mouse_raw_y = ev.mouse.y;
+			m_acc.scroll_z += ev.mouse.dz;
+			m_acc.scroll_w += ev.mouse.dw;
+			break;
+		case ALLEGRO_EVENT_MOUSE_BUTTON_DOWN:
+			if (ev.mouse.button >= 1 && ev.mouse.button <= 32) {
+				m_acc.buttons_down |= 1u << (ev.mouse.button - 1); // starts at #1
+				m_acc.buttons_pressed |= 1u << (ev.mouse.button - 1);
+			}
+			break;
+		case ALLEGRO_EVENT_MOUSE_BUTTON_UP:
+			if (ev.mouse.button >= 1 && ev.mouse.button <= 32) {
+				m_acc.buttons_down &= ~(1u << (ev.mouse.button - 1)); // starts at #1
+				m_acc.buttons_released |= 1u << (ev.mouse.button - 1);
+			}
+			break;
+		case ALLEGRO_EVENT_MOUSE_ENTER_DISPLAY:
+			m_acc.mouse_on_display = true;
+			break;
+		case ALLEGRO_EVENT_MOUSE_LEAVE_DISPLAY:
+			m_acc.mouse_on_display = false;
+			break;
+		}
+	}
+
+	LUNARIS_DECL input_state::input_state()
+		: generic_event_handler()
+	{
+		install(events::KEYBOARD | events::MOUSE);
+		get_core().set_event_handler([this](const ALLEGRO_EVENT& ev) { handle_events(ev); });
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("%p is INPUT_STATE object", get_core_ptr());
+#endif
+	}
+
+	LUNARIS_DECL input_state::input_state(std::function<ALLEGRO_TRANSFORM(void)> f)
+		: input_state()
+	{
+		if (!f) throw std::invalid_argument("Input state needs a valid ALLEGRO_TRANSFORM source if you set one. This is normally given by a display (it should be castable directly).");
+		std::lock_guard<std::mutex> luck(m_pub_safe);
+		current_transform_getter = f;
+	}
+
+	LUNARIS_DECL input_state::~input_state()
+	{
+		get_core().signal_stop();
+	}
+
+	LUNARIS_DECL uint64_t input_state::publish()
+	{
+		std::lock_guard<std::mutex> luck(m_pub_safe);
+		input_snapshot next;
+
+		{ // take what events did so far, start a new frame
+			std::lock_guard<std::recursive_mutex> luck2(get_core().m_safe);
+			next = m_acc;
+			std::memset(m_acc.keys_pressed, 0, sizeof(m_acc.keys_pressed));
+			std::memset(m_acc.keys_released, 0, sizeof(m_acc.keys_released));
+			m_acc.buttons_pressed = m_acc.buttons_released = 0;
+			m_acc.scroll_z = m_acc.scroll_w = 0;
+		}
+
+		next.frame = m_pub.frame + 1;
+		next.mouse_real_x = static_cast<float>(next.mouse_raw_x);
+		next.mouse_real_y = static_cast<float>(next.mouse_raw_y);
+
+		if (current_transform_getter) { // once per frame, no cache needed
+			ALLEGRO_TRANSFORM inv = current_transform_getter();
+			al_invert_transform(&inv);
+
+			float max_x = -1.0f, max_y = -1.0f;
+			al_transform_coordinates(&inv, &max_x, &max_y);
+			al_transform_coordinates(&inv, &next.mouse_real_x, &next.mouse_real_y);
+
+			next.mouse_relative_x = next.mouse_real_x / fabsf(max_x);
+			next.mouse_relative_y = next.mouse_real_y / fabsf(max_y);
+		}
+
+		// seqlock write: odd while writing
+		const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+		m_seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&m_pub, &next, sizeof(input_snapshot));
+		m_seq.store(seq + 2, std::memory_order_release);
+		m_frame = next.frame;
+
+		return next.frame;
+	}
+
+	LUNARIS_DECL input_snapshot input_state::snapshot() const
+	{
+		input_snapshot cpy;
+		uint32_t bef, aft;
+		do {
+			bef = m_seq.load(std::memory_order_acquire);
+			if (bef & 1) { // writer is in there
+				std::this_thread::yield();
+				continue;
+			}
+			std::memcpy(&cpy, &m_pub, sizeof(input_snapshot));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			aft = m_seq.load(std::memory_order_relaxed);
+			if (bef == aft) break;
+		} while (true);
+		return cpy;
+	}
+
+	LUNARIS_DECL uint64_t input_state::get_frame() const
+	{
+		return m_frame;
+	}
+
+	LUNARIS_DECL void input_state::reset()
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+		for (size_t p = 0; p < input_snapshot::key_words; ++p) {
+			m_acc.keys_released[p] |= m_acc.keys_down[p];
+			m_acc.keys_down[p] = 0;
+		}
+		m_acc.buttons_released |= m_acc.buttons_down;
+		m_acc.buttons_down = 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Events/generic_event_handler.h>
+
+#include <allegro5/allegro.h>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+namespace Lunaris {
+
+	/// <summary>
+	/// <para>A frame of input state: all keys, mouse position, buttons and scroll, plus what changed on this frame.</para>
+	/// <para>This is plain data. Copy it around as you wish.</para>
+	/// </summary>
+	struct input_snapshot {
+		static constexpr size_t key_words = (ALLEGRO_KEY_MAX + 63) / 64;
+
+		uint64_t frame = 0; // publish() count
+
+		uint64_t keys_down[key_words]{};
+		uint64_t keys_pressed[key_words]{}; // went down since last frame
+		uint64_t keys_released[key_words]{}; // went up since last frame
+
+		int mouse_raw_x = 0, mouse_raw_y = 0; // display pixels
+		float mouse_real_x = 0.0f, mouse_real_y = 0.0f; // camera coords (same as raw if there's no transform function)
+		float mouse_relative_x = 0.0f, mouse_relative_y = 0.0f; // [-1.0f, 1.0f] if there's a transform function
+		unsigned buttons_down = 0;
+		unsigned buttons_pressed = 0; // "0" is the first mouse button
+		unsigned buttons_released = 0;
+		int scroll_z = 0, scroll_w = 0; // sum of deltas since last frame
+		bool mouse_on_display = false;
+
+		/// <summary>
+		/// <para>Is this key down?</para>
+		/// </summary>
+		/// <param name="{int}">ALLEGRO_KEY_** key value.</param>
+		/// <returns>{bool} True if down.</returns>
+		bool is_key_down(const int) const;
+
+		/// <summary>
+		/// <para>Was this key pressed on this frame (even if released already)?</para>
+		/// </summary>
+		/// <param name="{int}">ALLEGRO_KEY_** key value.</param>
+		/// <returns>{bool} True if pressed since last frame.</returns>
+		bool is_key_pressed(const int) const;
+
+		/// <summary>
+		/// <para>Was this key released on this frame?</para>
+		/// </summary>
+		/// <param name="{int}">ALLEGRO_KEY_** key value.</param>
+		/// <returns>{bool} True if released since last frame.</returns>
+		bool is_key_released(const int) const;
+
+		/// <summary>
+		/// <para>Is this mouse button down? "0" is the first mouse button.</para>
+		/// </summary>
+		/// <param name="{int}">Mouse button.</param>
+		/// <returns>{bool} True if down.</returns>
+		bool is_button_down(const int) const;
+
+		/// <summary>
+		/// <para>Was this mouse button pressed on this frame (even if released already)?</para>
+		/// </summary>
+		/// <param name="{int}">Mouse button.</param>
+		/// <returns>{bool} True if pressed since last frame.</returns>
+		bool is_button_pressed(const int) const;
+
+		/// <summary>
+		/// <para>Was this mouse button released on this frame?</para>
+		/// </summary>
+		/// <param name="{int}">Mouse button.</param>
+		/// <returns>{bool} True if released since last frame.</returns>
+		bool is_button_released(const int) const;
+	};
+
+	/// <summary>
+	/// <para>input_state keeps keyboard and mouse state for polling, no callbacks needed.</para>
+	/// <para>Call publish() once per tick (on one thread, like your main loop) to close a frame. Any thread can then read the latest snapshot() without locks.</para>
+	/// <para>If you give it a transform function (display has one as operator), mouse coords are translated to camera coords like on mouse class.</para>
+	/// </summary>
+	class input_state : protected generic_event_handler {
+		// filled by events (core lock)
+		input_snapshot m_acc;
+		std::function<ALLEGRO_TRANSFORM(void)> current_transform_getter;
+
+		// published (seqlock, one writer)
+		std::atomic<uint32_t> m_seq = 0;
+		input_snapshot m_pub;
+		std::atomic<uint64_t> m_frame = 0;
+		std::mutex m_pub_safe; // only between publishers
+
+		void handle_events(const ALLEGRO_EVENT&);
+	public:
+		/// <summary>
+		/// <para>Input state with raw mouse coords (real ones are the same as raw).</para>
+		/// </summary>
+		input_state();
+
+		/// <summary>
+		/// <para>Input state with mouse coords translated by the inverse of a transform.</para>
+		/// </summary>
+		/// <param name="{function}">A function that gets the current transform.</param>
+		input_state(std::function<ALLEGRO_TRANSFORM(void)>);
+
+		~input_state();
+
+		/// <summary>
+		/// <para>Close this frame: publish the current state and what changed since last publish, and start a new frame.</para>
+		/// </summary>
+		/// <returns>{uint64_t} The frame number published.</returns>
+		uint64_t publish();
+
+		/// <summary>
+		/// <para>Latest published state. Lock-free, any thread, any rate.</para>
+		/// </summary>
+		/// <returns>{input_snapshot} Copy of the latest frame.</returns>
+		input_snapshot snapshot() const;
+
+		/// <summary>
+		/// <para>Latest published frame number (cheap way to know if there's something new).</para>
+		/// </summary>
+		/// <returns>{uint64_t} Frame number.</returns>
+		uint64_t get_frame() const;
+
+		/// <summary>
+		/// <para>Forget all keys and buttons down (like when the display loses focus and key up events are lost).</para>
+		/// <para>Applied on next publish().</para>
+		/// </summary>
+		void reset();
+
+		using generic_event_handler::install_other; // extra sources, like event_replayer
+		using generic_event_handler::uninstall_other;
+		using generic_event_handler::hook_exception_handler;
+		using generic_event_handler::unhook_exception_handler;
+	};
+
+}
\ No newline at end of file
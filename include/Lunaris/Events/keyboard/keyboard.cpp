@@ -2,65 +2,102 @@
 
 namespace Lunaris {
 	
-	LUNARIS_DECL std::string keyboard::gen_output() const
-	{
-		std::string outt;
-		for (size_t p = 0; p < data.size(); p++) tool_conv(outt, p);
-		return outt;
-	}
-
 	LUNARIS_DECL void keyboard::handle_events(const ALLEGRO_EVENT& ev)
 	{
 		if (ev.type != ALLEGRO_EVENT_KEY_CHAR) return;
 
 		const bool was_enter = ev.keyboard.keycode == ALLEGRO_KEY_ENTER || ev.keyboard.keycode == ALLEGRO_KEY_PAD_ENTER;
 
-		if (ev.keyboard.unichar >= 32)
-		{
-			data.push_back(ev.keyboard.unichar);
-			if (each_key) each_key(*this, ev.keyboard.unichar);
-
-			if (each_combined) {
-				std::string rightnow = gen_output();
-				each_combined(*this, rightnow);
-			}
+		switch (ev.keyboard.keycode) {
+		case ALLEGRO_KEY_LEFT:
+			if (m_cursor > 0) --m_cursor;
+			return;
+		case ALLEGRO_KEY_RIGHT:
+			if (m_cursor < m_offsets.size()) ++m_cursor;
+			return;
+		case ALLEGRO_KEY_HOME:
+			m_cursor = 0;
+			return;
+		case ALLEGRO_KEY_END:
+			m_cursor = m_offsets.size();
+			return;
+		case ALLEGRO_KEY_BACKSPACE:
+			if (m_cursor > 0) _erase(m_cursor - 1, 1);
 
+			if (each_key) each_key(*this, '\b');
+			if (each_combined) each_combined(*this, m_text);
+			return;
+		case ALLEGRO_KEY_DELETE:
+			if (m_cursor < m_offsets.size()) _erase(m_cursor, 1);
+
+			if (each_key) each_key(*this, 127);
+			if (each_combined) each_combined(*this, m_text);
+			return;
+		default:
+			break;
 		}
-		else if (ev.keyboard.keycode == ALLEGRO_KEY_BACKSPACE)
+
+		if (ev.keyboard.unichar >= 32)
 		{
-			if (data.size()) data.pop_back();
+			char multibyte[8] = { 0 };
+			const size_t len = al_utf8_encode(multibyte, ev.keyboard.unichar); // unichar is for sure >= 32.
 
-			if (each_key) each_key(*this, '\b');
+			if (len == 0 || len > 4) throw std::runtime_error("Unexpected invalid UTF8 translation.");
 
-			if (each_combined) {
-				std::string rightnow = gen_output();
-				each_combined(*this, rightnow);
-			}
+			_insert(multibyte, len);
+			if (each_key) each_key(*this, ev.keyboard.unichar);
+			if (each_combined) each_combined(*this, m_text);
 		}
 		else if (was_enter || ev.keyboard.keycode == ALLEGRO_KEY_ESCAPE)
 		{
 			if (enter_combined || each_key) {
+				if (each_combined) each_combined(*this, m_text);
+				if (enter_combined) enter_combined(*this, m_text);
+			}
+		}
+	}
 
-				std::string rightnow = gen_output();
+	LUNARIS_DECL size_t keyboard::_byte_at(const size_t pos) const
+	{
+		return pos < m_offsets.size() ? m_offsets[pos] : m_text.size();
+	}
 
-				if (each_combined) each_combined(*this, rightnow);
-				if (enter_combined) enter_combined(*this, rightnow);
-			}
+	LUNARIS_DECL size_t keyboard::_insert(const char* src, const size_t len)
+	{
+		if (len == 0) return 0;
+
+		const size_t at = _byte_at(m_cursor);
+		m_text.insert(at, src, len);
+
+		std::vector<size_t> news;
+		for (size_t b = 0; b < len; ++b) {
+			if ((static_cast<unsigned char>(src[b]) & 0xC0) != 0x80) news.push_back(at + b); // not a continuation byte, new codepoint
 		}
+
+		// later codepoints move len bytes forward, then the new ones go in at once
+		for (size_t p = m_cursor; p < m_offsets.size(); ++p) m_offsets[p] += len;
+		m_offsets.insert(m_offsets.begin() + m_cursor, news.begin(), news.end());
+
+		m_cursor += news.size();
+		return news.size();
 	}
 
-	LUNARIS_DECL void keyboard::tool_conv(std::string& str, const size_t pos) const
+	LUNARIS_DECL size_t keyboard::_erase(size_t first, size_t count)
 	{
-		if (pos >= data.size()) return;
+		if (first >= m_offsets.size() || count == 0) return 0;
+		if (count > m_offsets.size() - first) count = m_offsets.size() - first;
 
-		const int& arg = data[pos];
+		const size_t beg = _byte_at(first);
+		const size_t len = _byte_at(first + count) - beg;
 
-		char multibyte[8] = { 0 };
-		size_t len = al_utf8_encode(multibyte, arg); // data[pos] is for sure >= 32.
+		m_text.erase(beg, len);
+		m_offsets.erase(m_offsets.begin() + first, m_offsets.begin() + first + count);
+		for (size_t p = first; p < m_offsets.size(); ++p) m_offsets[p] -= len;
 
-		if (len > 8) throw std::runtime_error("Unexpected invalid UTF8 translation.");
+		if (m_cursor >= first + count) m_cursor -= count;
+		else if (m_cursor > first) m_cursor = first;
 
-		for (size_t a = 0; a < len; a++) str += multibyte[a];
+		return count;
 	}
 
 	LUNARIS_DECL keyboard::keyboard() : generic_event_handler()
@@ -79,13 +116,13 @@ namespace Lunaris {
 		each_key = f;
 	}
 
-	LUNARIS_DECL void keyboard::hook_each_key_phrase_event(const std::function<void(keyboard&, const std::string&)> f)
+	LUNARIS_DECL void keyboard::hook_each_key_phrase_event(const std::function<void(keyboard&, const std::string_view)> f)
 	{
 		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
 		each_combined = f;
 	}
 
-	LUNARIS_DECL void keyboard::hook_enter_line_phrase_event(const std::function<void(keyboard&, const std::string&)> f)
+	LUNARIS_DECL void keyboard::hook_enter_line_phrase_event(const std::function<void(keyboard&, const std::string_view)> f)
 	{
 		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
 		enter_combined = f;
@@ -112,7 +149,65 @@ namespace Lunaris {
 	LUNARIS_DECL void keyboard::clear()
 	{
 		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
-		data.clear();
+		m_text.clear();
+		m_offsets.clear();
+		m_cursor = 0;
+	}
+
+	LUNARIS_DECL std::string keyboard::copy_text() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core_ptr()->m_safe);
+		return m_text;
+	}
+
+	LUNARIS_DECL std::string_view keyboard::get_text() const
+	{
+		return m_text;
+	}
+
+	LUNARIS_DECL size_t keyboard::size() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core_ptr()->m_safe);
+		return m_offsets.size();
+	}
+
+	LUNARIS_DECL size_t keyboard::get_cursor() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core_ptr()->m_safe);
+		return m_cursor;
+	}
+
+	LUNARIS_DECL size_t keyboard::get_cursor_byte() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core_ptr()->m_safe);
+		return _byte_at(m_cursor);
+	}
+
+	LUNARIS_DECL void keyboard::set_cursor(const size_t pos)
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+		m_cursor = pos > m_offsets.size() ? m_offsets.size() : pos;
+	}
+
+	LUNARIS_DECL void keyboard::move_cursor(const int off)
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+		const int64_t to = static_cast<int64_t>(m_cursor) + off;
+		m_cursor = to < 0 ? 0 : (static_cast<size_t>(to) > m_offsets.size() ? m_offsets.size() : static_cast<size_t>(to));
+	}
+
+	LUNARIS_DECL void keyboard::insert(const std::string_view str)
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+		if (_insert(str.data(), str.size()) && each_combined) each_combined(*this, m_text);
+	}
+
+	LUNARIS_DECL size_t keyboard::erase(const size_t first, const size_t count)
+	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+		const size_t removed = _erase(first, count);
+		if (removed && each_combined) each_combined(*this, m_text);
+		return removed;
 	}
 
 }
\ No newline at end of file
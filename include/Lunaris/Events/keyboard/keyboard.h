@@ -5,6 +5,7 @@
 
 #include <allegro5/allegro.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <thread>
@@ -15,16 +16,20 @@ namespace Lunaris {
 	/// <para>keyboard is meant to handle keyboard input as string.</para>
 	/// <para>Each key press can be combined to a modifier and generate a string. This class does this for you.</para>
 	/// <para>Keyboard events on a display can be easily translated to pure UTF8 string on the fly.</para>
+	/// <para>The UTF8 string is kept updated as keys come (no re-encoding), with a cursor you can move (LEFT, RIGHT, HOME, END) and edit at (BACKSPACE, DELETE).</para>
 	/// </summary>
 	class keyboard : protected generic_event_handler {
-		std::vector<int> data;
+		std::string m_text; // UTF8, always up to date
+		std::vector<size_t> m_offsets; // byte offset of each codepoint in m_text
+		size_t m_cursor = 0; // in codepoints, [0, m_offsets.size()]
 		std::function<void(keyboard&, const int)> each_key; // all keyboard keys
-		std::function<void(keyboard&, const std::string&)> each_combined, enter_combined; // only valid input
+		std::function<void(keyboard&, const std::string_view)> each_combined, enter_combined; // only valid input
 
-		std::string gen_output() const;
 		void handle_events(const ALLEGRO_EVENT&);
 
-		void tool_conv(std::string&, const size_t) const; // to, pos in vector
+		size_t _byte_at(const size_t) const; // codepoint index to byte offset
+		size_t _insert(const char*, const size_t); // raw UTF8 at cursor, returns codepoints added
+		size_t _erase(size_t, size_t); // first, count (codepoints), returns codepoints removed
 	public:
 		keyboard();
 
@@ -37,15 +42,17 @@ namespace Lunaris {
 		/// <summary>
 		/// <para>Hook a function that will get the latest combined string (so far).</para>
 		/// <para>Useful when you want to show the user their input in real time on screen.</para>
+		/// <para>The view is only valid inside the function. Copy it if you need it later.</para>
 		/// </summary>
 		/// <param name="{function}">A function that gets the current string translated input in UTF8.</param>
-		void hook_each_key_phrase_event(const std::function<void(keyboard&, const std::string&)>);
+		void hook_each_key_phrase_event(const std::function<void(keyboard&, const std::string_view)>);
 
 		/// <summary>
 		/// <para>Hook a function to get the final (pos-ENTER) user input!</para>
+		/// <para>The view is only valid inside the function. Copy it if you need it later.</para>
 		/// </summary>
 		/// <param name="{function}">A function to get the final string in UTF8.</param>
-		void hook_enter_line_phrase_event(const std::function<void(keyboard&, const std::string&)>);
+		void hook_enter_line_phrase_event(const std::function<void(keyboard&, const std::string_view)>);
 
 		/// <summary>
 		/// <para>Unhook the each-key hooked function.</para>
@@ -67,6 +74,66 @@ namespace Lunaris {
 		/// </summary>
 		void clear();
 
+		/// <summary>
+		/// <para>Copy of the current input.</para>
+		/// </summary>
+		/// <returns>{std::string} UTF8 string.</returns>
+		std::string copy_text() const;
+
+		/// <summary>
+		/// <para>View of the current input, without copying.</para>
+		/// <para>NOTE: Only valid until the next key event or edit. If events may be coming, prefer copy_text() or the hooked functions.</para>
+		/// </summary>
+		/// <returns>{std::string_view} UTF8 string view.</returns>
+		std::string_view get_text() const;
+
+		/// <summary>
+		/// <para>Amount of characters (codepoints) in the input.</para>
+		/// </summary>
+		/// <returns>{size_t} Codepoints.</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// <para>Where the cursor is (in characters, from the beginning).</para>
+		/// </summary>
+		/// <returns>{size_t} Cursor position, [0, size()].</returns>
+		size_t get_cursor() const;
+
+		/// <summary>
+		/// <para>Byte offset of the cursor in the UTF8 string (useful to measure the text before it).</para>
+		/// </summary>
+		/// <returns>{size_t} Byte offset.</returns>
+		size_t get_cursor_byte() const;
+
+		/// <summary>
+		/// <para>Set cursor position (in characters). It's clamped to the text.</para>
+		/// </summary>
+		/// <param name="{size_t}">Position.</param>
+		void set_cursor(const size_t);
+
+		/// <summary>
+		/// <para>Move cursor by some characters (negative goes left). It's clamped to the text.</para>
+		/// </summary>
+		/// <param name="{int}">Offset.</param>
+		void move_cursor(const int);
+
+		/// <summary>
+		/// <para>Insert UTF8 text at the cursor (like a paste). The cursor goes to the end of it.</para>
+		/// <para>The phrase event is triggered once.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Valid UTF8 text.</param>
+		void insert(const std::string_view);
+
+		/// <summary>
+		/// <para>Erase characters starting at a position. The phrase event is triggered once, if anything was removed.</para>
+		/// </summary>
+		/// <param name="{size_t}">First character.</param>
+		/// <param name="{size_t}">Amount of characters.</param>
+		/// <returns>{size_t} Characters removed.</returns>
+		size_t erase(const size_t, const size_t);
+
+		using generic_event_handler::install_other; // extra sources, like event_replayer
+		using generic_event_handler::uninstall_other;
 		using generic_event_handler::hook_exception_handler;
 		using generic_event_handler::unhook_exception_handler;
 	};
@@ -49,6 +49,8 @@ namespace Lunaris {
 		/// <returns>{bool} True means it is pressed.</returns>
 		bool is_key_pressed(const int); // by keycode
 
+		using generic_event_handler::install_other; // extra sources, like event_replayer
+		using generic_event_handler::uninstall_other;
 		using generic_event_handler::hook_exception_handler;
 		using generic_event_handler::unhook_exception_handler;
 	};
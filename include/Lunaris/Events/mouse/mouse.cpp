@@ -36,37 +36,82 @@ namespace Lunaris {
         mouse_rn.scroll_event |= (1 << (val > 0 ? (axis * 2) : ((axis * 2) + 1)));
     }
 
+    LUNARIS_DECL void mouse::refresh_inverse()
+    {
+        ALLEGRO_TRANSFORM curr_transf;
+
+        if (current_transform_version) {
+            // version first: the display writes the transform, then the version. Read the other way, a new version could come with the old transform and stay cached.
+            const uint64_t ver = current_transform_version();
+            if (inv_valid && ver == inv_version) return;
+            curr_transf = current_transform_getter();
+            inv_version = ver;
+        }
+        else {
+            curr_transf = current_transform_getter();
+            if (inv_valid && memcmp(&curr_transf, &inv_source, sizeof(ALLEGRO_TRANSFORM)) == 0) return;
+            inv_source = curr_transf;
+        }
+
+        al_invert_transform(&curr_transf);
+        inv_cached = curr_transf;
+
+        inv_max_x = -1.0f;
+        inv_max_y = -1.0f;
+        al_transform_coordinates(&inv_cached, &inv_max_x, &inv_max_y);
+        inv_valid = true;
+    }
+
+    LUNARIS_DECL void mouse::apply_axes(const ALLEGRO_MOUSE_EVENT& mev)
+    {
+        refresh_inverse();
+
+        float quick_mx, quick_my;
+        quick_mx = mev.x;
+        quick_my = mev.y;
+
+        al_transform_coordinates(&inv_cached, &quick_mx, &quick_my);
+
+        mouse_rn.raw_mouse_event = mev;
+        mouse_rn.real_posx = quick_mx;
+        mouse_rn.real_posy = quick_my;
+        mouse_rn.relative_posx = mouse_rn.real_posx * 1.0 / fabsf(inv_max_x);
+        mouse_rn.relative_posy = mouse_rn.real_posy * 1.0 / fabsf(inv_max_y);
+
+        if (event_handler) event_handler(ALLEGRO_EVENT_MOUSE_AXES, mouse_rn);
+        mouse_rn.scroll_event = 0; // always reset
+    }
+
 	LUNARIS_DECL void mouse::handle_events(const ALLEGRO_EVENT& ev)
     {
         switch (ev.type) {
+        case ALLEGRO_EVENT_TIMER:
+            if (coalesce_timer && ev.timer.source == coalesce_timer.get()) flush_coalesced();
+            break;
         case ALLEGRO_EVENT_MOUSE_AXES:
         {
             if (ev.mouse.dw != 0) set_mouse_axis_plus(0, ev.mouse.dw);
             if (ev.mouse.dz != 0) set_mouse_axis_plus(1, ev.mouse.dz);
 
-            ALLEGRO_TRANSFORM curr_transf = current_transform_getter();
-
-            float max_x = -1.0f, max_y = -1.0f;
-            float quick_mx, quick_my;
-            quick_mx = ev.mouse.x;
-            quick_my = ev.mouse.y;
-
-            al_invert_transform(&curr_transf);
-
-            al_transform_coordinates(&curr_transf, &max_x, &max_y);
-            al_transform_coordinates(&curr_transf, &quick_mx, &quick_my);
-
-            mouse_rn.raw_mouse_event = ev.mouse;
-            mouse_rn.real_posx = quick_mx;
-            mouse_rn.real_posy = quick_my;
-            mouse_rn.relative_posx = mouse_rn.real_posx * 1.0 / fabsf(max_x);
-            mouse_rn.relative_posy = mouse_rn.real_posy * 1.0 / fabsf(max_y);
+            if (coalesce_on) {
+                if (coalesce_has) { // keep latest position, sum deltas
+                    const ALLEGRO_MOUSE_EVENT old = coalesce_pending;
+                    coalesce_pending = ev.mouse;
+                    coalesce_pending.dx += old.dx;
+                    coalesce_pending.dy += old.dy;
+                    coalesce_pending.dz += old.dz;
+                    coalesce_pending.dw += old.dw;
+                }
+                else coalesce_pending = ev.mouse;
+                coalesce_has = true;
+                break;
+            }
 
-            if (event_handler) event_handler(ALLEGRO_EVENT_MOUSE_AXES, mouse_rn);
-            mouse_rn.scroll_event = 0; // always reset
+            apply_axes(ev.mouse);
         }
             break;
         case ALLEGRO_EVENT_MOUSE_BUTTON_DOWN:
+            flush_coalesced(); // movement before the edge
             mouse_rn.raw_mouse_event = ev.mouse;
             if (ev.mouse.button <= 32) {
                 mouse_rn.buttons_pressed |= 1 << (ev.mouse.button - 1); // starts at #1
@@ -77,6 +122,7 @@ namespace Lunaris {
             }
             break;
         case ALLEGRO_EVENT_MOUSE_BUTTON_UP:
+            flush_coalesced(); // movement before the edge
             mouse_rn.raw_mouse_event = ev.mouse;
             if (ev.mouse.button <= 32) {
                 mouse_rn.buttons_pressed &= ~(1 << (ev.mouse.button - 1)); // starts at #1
@@ -90,11 +136,17 @@ namespace Lunaris {
     }
 
     LUNARIS_DECL mouse::mouse(std::function<ALLEGRO_TRANSFORM(void)> f) 
+        : mouse(f, {})
+    {
+    }
+
+    LUNARIS_DECL mouse::mouse(std::function<ALLEGRO_TRANSFORM(void)> f, std::function<uint64_t(void)> v)
         : generic_event_handler(), mouse_rn(*this)
     {
         if (!f) throw std::invalid_argument("Mouse needs a valid ALLEGRO_TRANSFORM source. This is normally given by a display (it should be castable directly).");
 
         current_transform_getter = f;
+        current_transform_version = v;
         install(events::MOUSE);
         get_core().set_event_handler([this](const ALLEGRO_EVENT& ev) { handle_events(ev); });
 #ifdef LUNARIS_VERBOSE_BUILD
@@ -102,6 +154,36 @@ namespace Lunaris {
 #endif
     }
 
+    LUNARIS_DECL mouse::~mouse()
+    {
+        get_core().signal_stop(); // no events while the timer is gone
+    }
+
+    LUNARIS_DECL void mouse::set_coalescing(const double interval)
+    {
+        std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+        flush_coalesced();
+
+        if (coalesce_timer) {
+            uninstall(coalesce_timer);
+            coalesce_timer.reset();
+        }
+
+        coalesce_on = interval >= 0.0;
+        if (interval > 0.0) {
+            coalesce_timer = make_unique_timer(interval, true);
+            install(coalesce_timer);
+        }
+    }
+
+    LUNARIS_DECL void mouse::flush_coalesced()
+    {
+        std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
+        if (!coalesce_has) return;
+        coalesce_has = false;
+        apply_axes(coalesce_pending);
+    }
+
 	LUNARIS_DECL void mouse::hook_event(const std::function<void(const int, const mouse_event&)> f)
     {
         std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
@@ -7,6 +7,7 @@
 #include <thread>
 #include <mutex>
 #include <functional>
+#include <cstring>
 
 namespace Lunaris {
 
@@ -59,13 +60,52 @@ namespace Lunaris {
 
 		std::function<void(const int, const mouse_event&)> event_handler;
 		std::function<ALLEGRO_TRANSFORM(void)> current_transform_getter;
+		std::function<uint64_t(void)> current_transform_version; // optional, if set the inverse is only rebuilt when this changes
+
+		// cached inverse of the display transform
+		ALLEGRO_TRANSFORM inv_source{}; // if there's no version function, compare this
+		ALLEGRO_TRANSFORM inv_cached{};
+		uint64_t inv_version = 0;
+		bool inv_valid = false;
+		float inv_max_x = -1.0f, inv_max_y = -1.0f;
+
+		// coalescing (axes merged until flush)
+		timer_unique coalesce_timer{ nullptr, al_destroy_timer };
+		ALLEGRO_MOUSE_EVENT coalesce_pending{};
+		bool coalesce_on = false;
+		bool coalesce_has = false;
 
 		void set_mouse_axis_plus(const int, const int); // which axis (w, ...), value (-1, 1, 0)
+		void refresh_inverse();
+		void apply_axes(const ALLEGRO_MOUSE_EVENT&);
 
 		void handle_events(const ALLEGRO_EVENT&);
 	public:
 		mouse(std::function<ALLEGRO_TRANSFORM(void)>);
 
+		/// <summary>
+		/// <para>Create the mouse with a transform version function too (display has get_transform_version_function()).</para>
+		/// <para>The inverse transform is only calculated again when the version changes.</para>
+		/// </summary>
+		/// <param name="{function}">A function that gets the current transform.</param>
+		/// <param name="{function}">A function that gets the current transform version.</param>
+		mouse(std::function<ALLEGRO_TRANSFORM(void)>, std::function<uint64_t(void)>);
+
+		~mouse();
+
+		/// <summary>
+		/// <para>Merge mouse axes events and only update (and call the hooked function) once per interval.</para>
+		/// <para>Scroll deltas are summed and button events flush pending movement first, so nothing is lost.</para>
+		/// <para>Zero interval only merges until flush_coalesced() is called (like once per frame). Negative disables it (default).</para>
+		/// </summary>
+		/// <param name="{double}">Interval in seconds (0 = manual flush, less than 0 = disabled).</param>
+		void set_coalescing(const double);
+
+		/// <summary>
+		/// <para>Send any merged axes event now.</para>
+		/// </summary>
+		void flush_coalesced();
+
 		/// <summary>
 		/// <para>Hook a function to handle mouse events.</para>
 		/// </summary>
@@ -79,10 +119,13 @@ namespace Lunaris {
 
 		/// <summary>
 		/// <para>Read the latest mouse value (the values may change, but the memory is valid while the object exists).</para>
+		/// <para>If you need a consistent copy from another thread, use input_state instead.</para>
 		/// </summary>
 		/// <returns>{mouse_event} Latest mouse event reference (may update itself while reading).</returns>
 		const mouse_event& current_mouse() const;
 
+		using generic_event_handler::install_other; // extra sources, like event_replayer
+		using generic_event_handler::uninstall_other;
 		using generic_event_handler::hook_exception_handler;
 		using generic_event_handler::unhook_exception_handler;
 	};
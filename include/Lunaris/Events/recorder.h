@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "recorder/recorder.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "recorder/recorder.cpp"
+#endif
\ No newline at end of file
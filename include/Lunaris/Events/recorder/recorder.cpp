@@ -0,0 +1,347 @@
+#include "recorder.h"
+
+namespace Lunaris {
+
+	template<typename T> inline void __rec_put(std::vector<char>& buf, const T& val)
+	{
+		const char* p = reinterpret_cast<const char*>(&val);
+		buf.insert(buf.end(), p, p + sizeof(T));
+	}
+
+	template<typename T> inline bool __rec_get(const std::vector<char>& buf, size_t& off, T& val)
+	{
+		if (off + sizeof(T) > buf.size()) return false;
+		std::memcpy(&val, buf.data() + off, sizeof(T));
+		off += sizeof(T);
+		return true;
+	}
+
+	// false if it's not a kind that can be saved (user events and others carry pointers only valid in this run)
+	LUNARIS_DECL bool __rec_kind_of(const ALLEGRO_EVENT_TYPE type, event_record_kind& kind)
+	{
+		switch (type) {
+		case ALLEGRO_EVENT_KEY_DOWN:
+		case ALLEGRO_EVENT_KEY_CHAR:
+		case ALLEGRO_EVENT_KEY_UP:
+			kind = event_record_kind::KEYBOARD;
+			return true;
+		case ALLEGRO_EVENT_MOUSE_AXES:
+		case ALLEGRO_EVENT_MOUSE_BUTTON_DOWN:
+		case ALLEGRO_EVENT_MOUSE_BUTTON_UP:
+		case ALLEGRO_EVENT_MOUSE_ENTER_DISPLAY:
+		case ALLEGRO_EVENT_MOUSE_LEAVE_DISPLAY:
+		case ALLEGRO_EVENT_MOUSE_WARPED:
+			kind = event_record_kind::MOUSE;
+			return true;
+		case ALLEGRO_EVENT_DISPLAY_EXPOSE:
+		case ALLEGRO_EVENT_DISPLAY_RESIZE:
+		case ALLEGRO_EVENT_DISPLAY_CLOSE:
+		case ALLEGRO_EVENT_DISPLAY_LOST:
+		case ALLEGRO_EVENT_DISPLAY_FOUND:
+		case ALLEGRO_EVENT_DISPLAY_SWITCH_IN:
+		case ALLEGRO_EVENT_DISPLAY_SWITCH_OUT:
+		case ALLEGRO_EVENT_DISPLAY_ORIENTATION:
+			kind = event_record_kind::DISPLAY;
+			return true;
+		case ALLEGRO_EVENT_TIMER:
+			kind = event_record_kind::TIMER;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	LUNARIS_DECL void event_recorder::handle_events(const ALLEGRO_EVENT& ev)
+	{
+		std::lock_guard<std::mutex> luck(m_file_safe);
+		event_record_kind kind{};
+		if (!m_recording || !__rec_kind_of(ev.type, kind)) return;
+
+		if (m_first < 0.0) m_first = ev.any.timestamp;
+		const double now = ev.any.timestamp - m_first;
+
+		__rec_put(m_buf, now);
+		__rec_put(m_buf, static_cast<uint32_t>(ev.type));
+		__rec_put(m_buf, static_cast<uint8_t>(kind));
+
+		switch (kind) {
+		case event_record_kind::KEYBOARD:
+			__rec_put(m_buf, static_cast<int32_t>(ev.keyboard.keycode));
+			__rec_put(m_buf, static_cast<int32_t>(ev.keyboard.unichar));
+			__rec_put(m_buf, static_cast<uint32_t>(ev.keyboard.modifiers));
+			__rec_put(m_buf, static_cast<uint8_t>(ev.keyboard.repeat ? 1 : 0));
+			break;
+		case event_record_kind::MOUSE:
+			for (const int it : { ev.mouse.x, ev.mouse.y, ev.mouse.z, ev.mouse.w, ev.mouse.dx, ev.mouse.dy, ev.mouse.dz, ev.mouse.dw }) __rec_put(m_buf, static_cast<int32_t>(it));
+			__rec_put(m_buf, static_cast<uint32_t>(ev.mouse.button));
+			__rec_put(m_buf, ev.mouse.pressure);
+			break;
+		case event_record_kind::DISPLAY:
+			for (const int it : { ev.display.x, ev.display.y, ev.display.width, ev.display.height, ev.display.orientation }) __rec_put(m_buf, static_cast<int32_t>(it));
+			break;
+		case event_record_kind::TIMER:
+			__rec_put(m_buf, static_cast<int64_t>(ev.timer.count));
+			__rec_put(m_buf, ev.timer.error);
+			break;
+		}
+
+		++m_count;
+		if (m_buf.size() >= event_record_buffer_flush) flush_buffer();
+	}
+
+	LUNARIS_DECL void event_recorder::flush_buffer()
+	{
+		if (m_buf.empty() || m_fp.empty()) return;
+		m_fp.write(m_buf.data(), m_buf.size());
+		m_buf.clear();
+	}
+
+	LUNARIS_DECL event_recorder::event_recorder()
+		: generic_event_handler()
+	{
+		get_core().set_event_handler([this](const ALLEGRO_EVENT& ev) { handle_events(ev); });
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("%p is RECORDER object", get_core_ptr());
+#endif
+	}
+
+	LUNARIS_DECL event_recorder::~event_recorder()
+	{
+		get_core().signal_stop(); // no more events while members are being destroyed
+		stop();
+	}
+
+	LUNARIS_DECL bool event_recorder::start(const std::string& path)
+	{
+		stop();
+
+		std::lock_guard<std::mutex> luck(m_file_safe);
+		if (!m_fp.open(path, file::open_mode_e::WRITE_REPLACE)) return false;
+
+		m_buf.reserve(event_record_buffer_flush + 64);
+		m_buf.insert(m_buf.end(), std::begin(event_record_magic), std::end(event_record_magic));
+		__rec_put(m_buf, event_record_version);
+
+		m_count = 0;
+		m_first = -1.0;
+		m_recording = true;
+		return true;
+	}
+
+	LUNARIS_DECL void event_recorder::stop()
+	{
+		std::lock_guard<std::mutex> luck(m_file_safe);
+		if (!m_recording) return;
+		m_recording = false;
+		flush_buffer();
+		m_fp.flush();
+		m_fp.close();
+	}
+
+	LUNARIS_DECL bool event_recorder::is_recording() const
+	{
+		return m_recording;
+	}
+
+	LUNARIS_DECL size_t event_recorder::size() const
+	{
+		return m_count;
+	}
+
+	LUNARIS_DECL void event_replayer::_async(const double speed)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		event_record_kind kind{};
+
+		for (const auto& it : m_events) {
+			if (speed > 0.0) {
+				const auto when = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(it.time / speed));
+				std::unique_lock<std::mutex> luck(m_safe);
+				if (m_cond.wait_until(luck, when, [this] { return !m_keep; })) break;
+			}
+			else if (!m_keep) break;
+
+			ALLEGRO_EVENT ev = it.ev;
+			ALLEGRO_DISPLAY* disp = m_display;
+			ev.any.source = m_source.get();
+			ev.any.timestamp = al_get_time();
+
+			if (__rec_kind_of(ev.type, kind)) switch (kind) {
+			case event_record_kind::KEYBOARD:
+				if (al_is_keyboard_installed()) ev.any.source = al_get_keyboard_event_source();
+				ev.keyboard.display = disp;
+				break;
+			case event_record_kind::MOUSE:
+				if (al_is_mouse_installed()) ev.any.source = al_get_mouse_event_source();
+				ev.mouse.display = disp;
+				break;
+			case event_record_kind::DISPLAY:
+				if (disp) ev.any.source = al_get_display_event_source(disp);
+				break;
+			default: // timers from another run don't exist here, so they stay on this replayer's source
+				break;
+			}
+			event_dispatcher::get().inject(ev);
+		}
+
+		m_playing = false;
+	}
+
+	LUNARIS_DECL event_replayer::event_replayer()
+		: m_source(make_unique_user_event_source())
+	{
+	}
+
+	LUNARIS_DECL event_replayer::~event_replayer()
+	{
+		stop();
+	}
+
+	LUNARIS_DECL bool event_replayer::load(const std::string& path)
+	{
+		stop();
+		m_events.clear();
+
+		file fp;
+		if (!fp.open(path, file::open_mode_e::READ_TRY)) return false;
+
+		std::vector<char> buf(fp.size());
+		if (buf.size() < sizeof(event_record_magic) + sizeof(event_record_version)) return false;
+		if (fp.read(buf.data(), buf.size()) != buf.size()) return false;
+		if (std::memcmp(buf.data(), event_record_magic, sizeof(event_record_magic)) != 0) return false;
+
+		size_t off = sizeof(event_record_magic);
+		uint16_t version = 0;
+		if (!__rec_get(buf, off, version) || version != event_record_version) return false;
+
+		while (off < buf.size()) {
+			recorded_event rec;
+			uint32_t type = 0;
+			uint8_t kind = 0;
+			bool good = __rec_get(buf, off, rec.time) && __rec_get(buf, off, type) && __rec_get(buf, off, kind);
+
+			switch (static_cast<event_record_kind>(kind)) {
+			case event_record_kind::KEYBOARD:
+			{
+				int32_t keycode = 0, unichar = 0;
+				uint32_t modifiers = 0;
+				uint8_t repeat = 0;
+				good = good && __rec_get(buf, off, keycode) && __rec_get(buf, off, unichar) && __rec_get(buf, off, modifiers) && __rec_get(buf, off, repeat);
+				rec.ev.keyboard.keycode = keycode;
+				rec.ev.keyboard.unichar = unichar;
+				rec.ev.keyboard.modifiers = modifiers;
+				rec.ev.keyboard.repeat = repeat != 0;
+			}
+				break;
+			case event_record_kind::MOUSE:
+			{
+				int32_t vals[8]{};
+				uint32_t button = 0;
+				for (auto& it : vals) good = good && __rec_get(buf, off, it);
+				good = good && __rec_get(buf, off, button) && __rec_get(buf, off, rec.ev.mouse.pressure);
+				rec.ev.mouse.x = vals[0];
+				rec.ev.mouse.y = vals[1];
+				rec.ev.mouse.z = vals[2];
+				rec.ev.mouse.w = vals[3];
+				rec.ev.mouse.dx = vals[4];
+				rec.ev.mouse.dy = vals[5];
+				rec.ev.mouse.dz = vals[6];
+				rec.ev.mouse.dw = vals[7];
+				rec.ev.mouse.button = button;
+			}
+				break;
+			case event_record_kind::DISPLAY:
+			{
+				int32_t vals[5]{};
+				for (auto& it : vals) good = good && __rec_get(buf, off, it);
+				rec.ev.display.x = vals[0];
+				rec.ev.display.y = vals[1];
+				rec.ev.display.width = vals[2];
+				rec.ev.display.height = vals[3];
+				rec.ev.display.orientation = vals[4];
+			}
+				break;
+			case event_record_kind::TIMER:
+			{
+				int64_t count = 0;
+				good = good && __rec_get(buf, off, count) && __rec_get(buf, off, rec.ev.timer.error);
+				rec.ev.timer.count = count;
+			}
+				break;
+			default:
+				good = false;
+				break;
+			}
+
+			if (!good) { // truncated or broken, keep what was good
+#ifdef LUNARIS_VERBOSE_BUILD
+				PRINT_DEBUG("Event record %s is truncated at %zu", path.c_str(), off);
+#endif
+				break;
+			}
+
+			rec.ev.type = type;
+			rec.ev.any.source = nullptr;
+			m_events.push_back(rec);
+		}
+
+		return true;
+	}
+
+	LUNARIS_DECL bool event_replayer::play(const double speed)
+	{
+		stop();
+		if (m_events.empty()) return false;
+
+		m_keep = true;
+		m_playing = true;
+		m_thr = std::thread([this, speed] { _async(speed); });
+		return true;
+	}
+
+	LUNARIS_DECL void event_replayer::stop()
+	{
+		{
+			std::lock_guard<std::mutex> luck(m_safe);
+			m_keep = false;
+		}
+		m_cond.notify_all();
+		if (m_thr.joinable()) m_thr.join();
+	}
+
+	LUNARIS_DECL void event_replayer::wait()
+	{
+		if (m_thr.joinable()) m_thr.join();
+	}
+
+	LUNARIS_DECL bool event_replayer::is_playing() const
+	{
+		return m_playing;
+	}
+
+	LUNARIS_DECL void event_replayer::set_display(ALLEGRO_DISPLAY* disp)
+	{
+		m_display = disp;
+	}
+
+	LUNARIS_DECL size_t event_replayer::size() const
+	{
+		return m_events.size();
+	}
+
+	LUNARIS_DECL double event_replayer::duration() const
+	{
+		return m_events.empty() ? 0.0 : m_events.back().time;
+	}
+
+	LUNARIS_DECL ALLEGRO_EVENT_SOURCE* event_replayer::get_event_source() const
+	{
+		return m_source.get();
+	}
+
+	LUNARIS_DECL event_replayer::operator std::vector<ALLEGRO_EVENT_SOURCE*>() const
+	{
+		return { m_source.get() };
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Events/shared_start.h>
+#include <Lunaris/Events/generic_event_handler.h>
+#include <Lunaris/Utility/file.h>
+
+#include <allegro5/allegro.h>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+
+namespace Lunaris {
+
+	constexpr char event_record_magic[4] = { 'L', 'N', 'R', 'P' };
+	constexpr uint16_t event_record_version = 1;
+	constexpr size_t event_record_buffer_flush = 1 << 14; // write to file every 16 KB
+
+	enum class event_record_kind : uint8_t {
+		KEYBOARD,	// keycode, unichar, modifiers, repeat
+		MOUSE,		// x, y, z, w, dx, dy, dz, dw, button, pressure
+		DISPLAY,	// x, y, width, height, orientation
+		TIMER		// count, error
+	};
+
+	/// <summary>
+	/// <para>A recorded event: seconds since the first recorded event and the event itself (only the member of its kind is set).</para>
+	/// </summary>
+	struct recorded_event {
+		double time = 0.0;
+		ALLEGRO_EVENT ev{};
+	};
+
+	/// <summary>
+	/// <para>event_recorder records the timestamped event stream of the installed sources into a compact binary file.</para>
+	/// <para>Install the sources you want (keyboard, mouse, a display...) and start().</para>
+	/// <para>Only keyboard, mouse, display and timer events are saved (pointers inside them, like display, are not). Anything else is ignored.</para>
+	/// </summary>
+	class event_recorder : protected generic_event_handler {
+		std::mutex m_file_safe;
+		file m_fp;
+		std::vector<char> m_buf;
+		double m_first = -1.0; // timestamp of the first recorded event
+		std::atomic<size_t> m_count = 0;
+		std::atomic<bool> m_recording = false;
+
+		void handle_events(const ALLEGRO_EVENT&);
+		void flush_buffer(); // m_file_safe must be locked
+	public:
+		event_recorder();
+		~event_recorder();
+
+		/// <summary>
+		/// <para>Start recording into a file (replaces it). Time is the event timestamp, counted from the first recorded event.</para>
+		/// </summary>
+		/// <param name="{std::string}">File path.</param>
+		/// <returns>{bool} True if file was opened.</returns>
+		bool start(const std::string&);
+
+		/// <summary>
+		/// <para>Stop recording and close the file.</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Is it recording?</para>
+		/// </summary>
+		/// <returns>{bool} True if recording.</returns>
+		bool is_recording() const;
+
+		/// <summary>
+		/// <para>How many events were recorded since start().</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of events.</returns>
+		size_t size() const;
+
+		using generic_event_handler::install;
+		using generic_event_handler::uninstall;
+		using generic_event_handler::install_other;
+		using generic_event_handler::uninstall_other;
+		using generic_event_handler::hook_exception_handler;
+		using generic_event_handler::unhook_exception_handler;
+	};
+
+	/// <summary>
+	/// <para>event_replayer loads a file from event_recorder and sends the events again as if they came from its own event source.</para>
+	/// <para>Install its source on the handlers you want to feed (install_other(get_event_source()) on mouse, keyboard, keys, display_event_handler...).</para>
+	/// <para>Events go through event_dispatcher::inject, not al_emit_user_event (that would overwrite part of keyboard, mouse, display and timer data), so only handlers of this library get them.</para>
+	/// <para>Events keep their type and data and get the replay time as timestamp. Keyboard and mouse events come from the keyboard and mouse sources (if installed), display events from the display set by set_display(), so handlers of those get them as if they were live.</para>
+	/// <para>Anything without a live source (timer events, or no display set) comes from this replayer's own source (get_event_source()).</para>
+	/// </summary>
+	class event_replayer : public NonCopyable, public NonMovable {
+		user_unique m_source;
+		std::vector<recorded_event> m_events;
+		std::thread m_thr;
+		std::mutex m_safe;
+		std::condition_variable m_cond;
+		std::atomic<bool> m_playing = false;
+		std::atomic<bool> m_keep = false;
+		std::atomic<ALLEGRO_DISPLAY*> m_display = nullptr;
+
+		void _async(const double);
+	public:
+		event_replayer();
+		~event_replayer();
+
+		/// <summary>
+		/// <para>Load a recorded file. Stops any playback.</para>
+		/// </summary>
+		/// <param name="{std::string}">File path.</param>
+		/// <returns>{bool} True if it's a valid record file.</returns>
+		bool load(const std::string&);
+
+		/// <summary>
+		/// <para>Start replaying from the beginning on its own thread.</para>
+		/// </summary>
+		/// <param name="{double}">Speed (1.0 is real time, 2.0 twice as fast). Zero or less emits everything as fast as possible.</param>
+		/// <returns>{bool} True if started (there's something to play).</returns>
+		bool play(const double = 1.0);
+
+		/// <summary>
+		/// <para>Stop replaying (if playing).</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Wait for the replay to end.</para>
+		/// </summary>
+		void wait();
+
+		/// <summary>
+		/// <para>Is it replaying right now?</para>
+		/// </summary>
+		/// <returns>{bool} True if playing.</returns>
+		bool is_playing() const;
+
+		/// <summary>
+		/// <para>Set the display keyboard, mouse and display events are replayed on (their display pointer and, for display events, the source).</para>
+		/// </summary>
+		/// <param name="{ALLEGRO_DISPLAY*}">The display, or nullptr to send display events from this replayer's source.</param>
+		void set_display(ALLEGRO_DISPLAY*);
+
+		/// <summary>
+		/// <para>Amount of events loaded.</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of events.</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// <para>Duration of the record (time of last event).</para>
+		/// </summary>
+		/// <returns>{double} Seconds.</returns>
+		double duration() const;
+
+		/// <summary>
+		/// <para>The event source replayed events come from.</para>
+		/// </summary>
+		/// <returns>{ALLEGRO_EVENT_SOURCE*} Event source.</returns>
+		ALLEGRO_EVENT_SOURCE* get_event_source() const;
+
+		/// <summary>
+		/// <para>Operator used for events.</para>
+		/// </summary>
+		operator std::vector<ALLEGRO_EVENT_SOURCE*>() const;
+	};
+
+}
\ No newline at end of file
@@ -87,4 +87,32 @@ namespace Lunaris {
 		return _r;
 	}
 
+	LUNARIS_DECL size_t event_source_notifier::subscribe(std::function<void(void)> f)
+	{
+		if (!f) return 0;
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_list.push_back({ ++m_counter, f });
+		return m_counter;
+	}
+
+	LUNARIS_DECL void event_source_notifier::unsubscribe(const size_t id)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+			if (it->first == id) {
+				m_list.erase(it);
+				return;
+			}
+		}
+	}
+
+	LUNARIS_DECL void event_source_notifier::notify()
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (size_t p = 0; p < m_list.size(); ++p) { // by index, a subscriber may unsubscribe on call
+			const auto f = m_list[p].second;
+			f();
+		}
+	}
+
 }
\ No newline at end of file
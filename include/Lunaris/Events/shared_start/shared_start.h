@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Lunaris {
 
@@ -71,4 +72,34 @@ namespace Lunaris {
 	/// <returns>{timer_shared} A std::shared_ptr to a ALLEGRO_TIMER ready to go.</returns>
 	timer_shared make_shared_timer(const double, const bool);
 
+	/// <summary>
+	/// <para>Objects that own event sources that may change (like display and menu) have one of these.</para>
+	/// <para>Event handlers subscribe to it and are told right away when the set of event sources changes (no polling).</para>
+	/// </summary>
+	class event_source_notifier : public NonCopyable, public NonMovable {
+		std::recursive_mutex m_safe;
+		std::vector<std::pair<size_t, std::function<void(void)>>> m_list;
+		size_t m_counter = 0;
+	public:
+		event_source_notifier() = default;
+
+		/// <summary>
+		/// <para>Call this function every time the event sources change.</para>
+		/// </summary>
+		/// <param name="{function}">A function to run on change.</param>
+		/// <returns>{size_t} An ID to unsubscribe later.</returns>
+		size_t subscribe(std::function<void(void)>);
+
+		/// <summary>
+		/// <para>Stop calling a subscribed function. After this returns, it won't be called anymore.</para>
+		/// </summary>
+		/// <param name="{size_t}">The ID from subscribe.</param>
+		void unsubscribe(const size_t);
+
+		/// <summary>
+		/// <para>Tell every subscriber the event sources have changed.</para>
+		/// </summary>
+		void notify();
+	};
+
 }
\ No newline at end of file
@@ -5,12 +5,19 @@
 
 #include <allegro5/allegro.h>
 #include <functional>
+#include <atomic>
+#include <type_traits>
 
 namespace Lunaris {
 
+	// true if T has event_source_notifier& get_event_source_notifier()
+	template<class T, class = void> struct __has_event_source_notifier : std::false_type {};
+	template<class T> struct __has_event_source_notifier<T, std::void_t<decltype(std::declval<T&>().get_event_source_notifier())>> : std::true_type {};
+
 	/// <summary>
 	/// <para>Build a generic event handler that handles events with this class.</para>
 	/// <para>IMPORTANT NOTE: The class MUST EXIST while THIS THING HERE exists. MAKE SURE IT EXISTS!</para>
+	/// <para>If SourceClass has get_event_source_notifier() (like display and menu), sources are updated on the event thread as soon as they change. If not, they're checked every 0.5 second.</para>
 	/// </summary>
 	/// <typeparam name="{EventHandlerType}">The class that eats an ALLEGRO_EVENT and transforms it to another class object easier or fancier (enhancing the event). This is the type handled by the function.</typeparam>
 	/// <typeparam name="{SourceClass}">The source of the event(s). This class must be castable to a vector of ALLEGRO_SOURCE_EVENT* so if you reload your object this can reset the event sources easily (reload-proof).</typeparam>
@@ -19,14 +26,18 @@ namespace Lunaris {
 
 		std::function<void(EventHandlerType&)> generic_event;
 		std::vector<ALLEGRO_EVENT_SOURCE*> last_event_source;
-		timer_unique timer;
+		timer_unique timer; // only if SourceClass has no notifier
+		user_unique notify_source; // only if SourceClass has a notifier: the notifier posts here, so check_sources runs on the event thread
+		std::atomic<bool> sources_dirty = false; // an event is on its way already
+		size_t notify_id = 0;
 
 		void handle_events(const ALLEGRO_EVENT&);
-		void check_time();
+		void check_sources(const bool = false); // true: drop and add every source again (on SOURCES_CHANGED)
 
 		SourceClass& __ref;
 	public:
 		specific_event_handler(SourceClass&);
+		~specific_event_handler();
 
 		/// <summary>
 		/// <para>Hook a function to handle the EventHandlerType class object (that resulted from an ALLEGRO_EVENT).</para>
@@ -39,6 +50,8 @@ namespace Lunaris {
 		/// </summary>
 		void unhook_event_handler();
 
+		using generic_event_handler::install_other; // extra sources, like event_replayer
+		using generic_event_handler::uninstall_other;
 		using generic_event_handler::hook_exception_handler;
 		using generic_event_handler::unhook_exception_handler;
 	};
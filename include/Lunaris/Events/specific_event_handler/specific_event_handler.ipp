@@ -6,8 +6,13 @@ namespace Lunaris {
 	template<class EventHandlerType, class SourceClass>
 	inline void specific_event_handler<EventHandlerType, SourceClass>::handle_events(const ALLEGRO_EVENT& ev)
 	{
-		if (ev.type == ALLEGRO_EVENT_TIMER && ev.timer.source == timer.get()) {
-			check_time();
+		if (timer && ev.type == ALLEGRO_EVENT_TIMER && ev.timer.source == timer.get()) {
+			check_sources();
+			return;
+		}
+		if (notify_source && ev.type == +__internal_events::SOURCES_CHANGED && ev.any.source == notify_source.get()) {
+			sources_dirty = false; // before, so a change while checking posts again
+			check_sources(true);
 			return;
 		}
 		if (generic_event) {
@@ -17,9 +22,17 @@ namespace Lunaris {
 	}
 	
 	template<class EventHandlerType, class SourceClass>
-	inline void specific_event_handler<EventHandlerType, SourceClass>::check_time()
+	inline void specific_event_handler<EventHandlerType, SourceClass>::check_sources(const bool reset_all)
 	{
+		std::lock_guard<std::recursive_mutex> luck(get_core().m_safe);
 		std::vector<ALLEGRO_EVENT_SOURCE*> nevs = __ref;
+
+		if (reset_all) { // a destroyed source may come back with the same address, so a diff can't tell it apart
+			for (auto& e : last_event_source) if (e) get_core().remove_event_source(e);
+			for (auto& e : nevs) if (e) get_core().add_event_source(e);
+			last_event_source = nevs;
+			return;
+		}
 	
 		std::vector<ALLEGRO_EVENT_SOURCE*> removing;
 		std::vector<ALLEGRO_EVENT_SOURCE*> adding;
@@ -52,14 +65,37 @@ namespace Lunaris {
 	
 	template<class EventHandlerType, class SourceClass>
 	inline specific_event_handler<EventHandlerType, SourceClass>::specific_event_handler(SourceClass& rf)
-		: generic_event_handler(), __ref(rf), timer(make_unique_timer(0.5, true))
+		: generic_event_handler(), __ref(rf), timer(nullptr, al_destroy_timer), notify_source(nullptr, specific::__del_user_event)
 	{
-		install(timer);
 		get_core().set_event_handler([this](const ALLEGRO_EVENT& ev) { handle_events(ev); });
+		if constexpr (__has_event_source_notifier<SourceClass>::value) {
+			notify_source = make_unique_user_event_source();
+			install(notify_source);
+			// called by whoever changed the sources (maybe holding its own locks): only post, never lock here
+			notify_id = __ref.get_event_source_notifier().subscribe([this] {
+				if (sources_dirty.exchange(true)) return;
+				ALLEGRO_EVENT ev;
+				ev.user.type = +__internal_events::SOURCES_CHANGED;
+				ev.user.source = notify_source.get();
+				if (!al_emit_user_event(notify_source.get(), &ev, nullptr)) sources_dirty = false;
+			});
+		}
+		else {
+			timer = make_unique_timer(0.5, true);
+			install(timer);
+		}
 #ifdef LUNARIS_VERBOSE_BUILD
 		PRINT_DEBUG("%p is SPECIFIC object (class: %s)", get_core_ptr(), typeid(SourceClass).name());
 #endif
-		check_time();
+		check_sources();
+	}
+
+	template<class EventHandlerType, class SourceClass>
+	inline specific_event_handler<EventHandlerType, SourceClass>::~specific_event_handler()
+	{
+		if constexpr (__has_event_source_notifier<SourceClass>::value) {
+			__ref.get_event_source_notifier().unsubscribe(notify_id);
+		}
 	}
 	
 	template<class EventHandlerType, class SourceClass>
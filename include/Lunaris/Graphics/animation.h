@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "animation/animation.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "animation/animation.cpp"
+#endif
\ No newline at end of file
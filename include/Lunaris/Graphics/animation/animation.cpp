@@ -0,0 +1,312 @@
+#include "animation.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL double animation_sequence::total() const
+	{
+		return ends.empty() ? 0.0 : ends.back();
+	}
+
+	LUNARIS_DECL size_t animation_sequence::frame_at(const double t) const
+	{
+		if (ends.empty()) return 0;
+		const size_t idx = static_cast<size_t>(std::upper_bound(ends.begin(), ends.end(), t) - ends.begin());
+		return idx >= ends.size() ? ends.size() - 1 : idx;
+	}
+
+	LUNARIS_DECL animation_sequence& animation_clip::_get_or_create(const std::string& name)
+	{
+		for (auto& it : m_seqs) {
+			if (it.name == name) return it;
+		}
+		animation_sequence seq;
+		seq.name = name;
+		m_seqs.push_back(std::move(seq));
+		return m_seqs.back();
+	}
+
+	LUNARIS_DECL size_t animation_clip::sequence_create(const std::string& name, const animation_loop_mode mode)
+	{
+		_get_or_create(name).mode = mode;
+		return sequence_find(name);
+	}
+
+	LUNARIS_DECL void animation_clip::frame_push_back(const std::string& name, const hybrid_memory<texture>& tex, const double duration)
+	{
+		if (tex.empty() || tex->empty()) throw std::runtime_error("Invalid texture for animation frame!");
+		if (duration <= 0.0) throw std::runtime_error("Animation frame duration must be positive!");
+
+		animation_sequence& seq = _get_or_create(name);
+		seq.frames.push_back({ tex, {}, duration });
+		seq.ends.push_back(seq.total() + duration);
+	}
+
+	LUNARIS_DECL void animation_clip::frame_push_back(const std::string& name, const hybrid_memory<texture>& atlas, const int px, const int py, const int dx, const int dy, const double duration)
+	{
+		if (atlas.empty() || atlas->empty()) throw std::runtime_error("Invalid atlas for animation frame!");
+		if (duration <= 0.0) throw std::runtime_error("Animation frame duration must be positive!");
+
+		hybrid_memory<texture> atl = atlas;
+		hybrid_memory<texture> piece = make_hybrid<texture>(atl->create_sub(px, py, dx, dy));
+
+		animation_sequence& seq = _get_or_create(name);
+		seq.frames.push_back({ piece, atlas, duration });
+		seq.ends.push_back(seq.total() + duration);
+	}
+
+	LUNARIS_DECL void animation_clip::frames_from_grid(const std::string& name, const hybrid_memory<texture>& atlas, const int cell_w, const int cell_h, const size_t first, const size_t count, const double duration)
+	{
+		if (atlas.empty() || atlas->empty()) throw std::runtime_error("Invalid atlas for animation frame!");
+		if (cell_w <= 0 || cell_h <= 0) throw std::runtime_error("Invalid cell size for animation grid!");
+
+		const size_t cols = static_cast<size_t>(atlas->get_width() / cell_w);
+		const size_t rows = static_cast<size_t>(atlas->get_height() / cell_h);
+		if (first + count > cols * rows) throw std::out_of_range("Grid cells out of range!");
+
+		for (size_t p = first; p < first + count; ++p) {
+			frame_push_back(name, atlas, static_cast<int>(p % cols) * cell_w, static_cast<int>(p / cols) * cell_h, cell_w, cell_h, duration);
+		}
+	}
+
+	LUNARIS_DECL size_t animation_clip::sequence_find(const std::string& name) const
+	{
+		for (size_t p = 0; p < m_seqs.size(); ++p) {
+			if (m_seqs[p].name == name) return p;
+		}
+		return npos;
+	}
+
+	LUNARIS_DECL size_t animation_clip::sequence_size() const
+	{
+		return m_seqs.size();
+	}
+
+	LUNARIS_DECL const animation_sequence& animation_clip::sequence_index(const size_t index) const
+	{
+		if (index >= m_seqs.size()) throw std::out_of_range("index out of range");
+		return m_seqs[index];
+	}
+
+	LUNARIS_DECL void animation_playhead::_apply_pending()
+	{
+		std::lock_guard<std::mutex> luck(m_pend_safe);
+		if (m_pend_clip) {
+			m_clip = m_pend_clip_ref; // the frame being drawn is held by m_cur_frame, the old clip can go now
+			m_pend_clip_ref.reset_this();
+			m_pend_clip = false;
+		}
+		m_seq = m_pend_seq;
+		m_time = 0.0;
+		m_finished = false;
+		m_pending = false;
+	}
+
+	LUNARIS_DECL void animation_playhead::_refresh()
+	{
+		if (m_clip.empty() || m_seq >= m_clip->sequence_size()) {
+			_set_current(nullptr);
+			return;
+		}
+
+		const animation_sequence& seq = m_clip->sequence_index(m_seq);
+		if (seq.frames.empty()) {
+			_set_current(nullptr);
+			return;
+		}
+
+		const double total = seq.total();
+		double t = m_time;
+
+		switch (seq.mode) {
+		case animation_loop_mode::ONCE:
+			if (t >= total) {
+				t = total;
+				m_finished = true;
+			}
+			else if (t < 0.0) {
+				t = 0.0;
+				m_finished = true;
+			}
+			m_time = t;
+			break;
+		case animation_loop_mode::LOOP:
+			t = std::fmod(t, total);
+			if (t < 0.0) t += total;
+			m_time = t; // keep it small
+			break;
+		case animation_loop_mode::PING_PONG:
+			t = std::fmod(t, 2.0 * total);
+			if (t < 0.0) t += 2.0 * total;
+			m_time = t;
+			if (t >= total) t = 2.0 * total - t;
+			break;
+		}
+
+		const size_t frame = seq.frame_at(t);
+		m_frame = frame;
+		m_seq_now = m_seq;
+		_set_current(&seq.frames[frame]);
+	}
+
+	LUNARIS_DECL void animation_playhead::_set_current(const animation_frame* fr)
+	{
+		const texture* tex = fr ? fr->tex.get() : nullptr;
+		if (tex == m_current && (fr || m_cur_frame.tex.empty())) return; // same frame, nothing to copy
+
+		std::lock_guard<std::mutex> luck(m_cur_safe);
+		if (fr) m_cur_frame = *fr;
+		else m_cur_frame = animation_frame{};
+		m_current = tex;
+	}
+
+	LUNARIS_DECL animation_playhead::~animation_playhead()
+	{
+		if (animation_group* grp = m_group.load(); grp) grp->remove(*this);
+	}
+
+	LUNARIS_DECL void animation_playhead::set_clip(const hybrid_memory<animation_clip>& clip)
+	{
+		std::lock_guard<std::mutex> luck(m_pend_safe);
+		m_pend_clip = true;
+		m_pend_clip_ref = clip;
+		m_pend_seq = 0;
+		m_pending = true;
+		// m_current is only changed on advance(): a pending clip can be replaced again before that, freeing its frames
+	}
+
+	LUNARIS_DECL bool animation_playhead::play(const std::string& name)
+	{
+		std::lock_guard<std::mutex> luck(m_pend_safe);
+		const hybrid_memory<animation_clip>& ref = m_pend_clip ? m_pend_clip_ref : m_clip;
+		if (ref.empty()) return false;
+		const size_t idx = ref->sequence_find(name);
+		if (idx == animation_clip::npos) return false;
+		m_pend_seq = idx;
+		m_pending = true;
+		return true;
+	}
+
+	LUNARIS_DECL bool animation_playhead::play(const size_t idx)
+	{
+		std::lock_guard<std::mutex> luck(m_pend_safe);
+		const hybrid_memory<animation_clip>& ref = m_pend_clip ? m_pend_clip_ref : m_clip;
+		if (ref.empty() || idx >= ref->sequence_size()) return false;
+		m_pend_seq = idx;
+		m_pending = true;
+		return true;
+	}
+
+	LUNARIS_DECL void animation_playhead::set_speed(const float spd)
+	{
+		m_speed = spd;
+	}
+
+	LUNARIS_DECL float animation_playhead::get_speed() const
+	{
+		return m_speed;
+	}
+
+	LUNARIS_DECL void animation_playhead::set_paused(const bool pause)
+	{
+		m_paused = pause;
+	}
+
+	LUNARIS_DECL bool animation_playhead::is_paused() const
+	{
+		return m_paused;
+	}
+
+	LUNARIS_DECL bool animation_playhead::is_finished() const
+	{
+		return m_finished;
+	}
+
+	LUNARIS_DECL size_t animation_playhead::get_sequence() const
+	{
+		return m_seq_now;
+	}
+
+	LUNARIS_DECL size_t animation_playhead::get_frame() const
+	{
+		return m_frame;
+	}
+
+	LUNARIS_DECL const texture* animation_playhead::current() const
+	{
+		return m_current;
+	}
+
+	LUNARIS_DECL animation_frame animation_playhead::current_frame() const
+	{
+		std::lock_guard<std::mutex> luck(m_cur_safe);
+		return m_cur_frame;
+	}
+
+	LUNARIS_DECL void animation_playhead::advance(const double dt)
+	{
+		if (m_pending) _apply_pending();
+
+		if (!m_paused && !m_finished) m_time += dt * static_cast<double>(m_speed.load());
+		_refresh();
+	}
+
+	LUNARIS_DECL animation_group::~animation_group()
+	{
+		clear();
+	}
+
+	LUNARIS_DECL void animation_group::push_back(animation_playhead& ph)
+	{
+		if (animation_group* grp = ph.m_group.load(); grp && grp != this) grp->remove(ph); // one group at a time
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		if (ph.m_group == this) return;
+		m_list.push_back(&ph);
+		ph.m_group = this;
+	}
+
+	LUNARIS_DECL bool animation_group::remove(const animation_playhead& ph)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+			if (*it == &ph) {
+				(*it)->m_group = nullptr;
+				m_list.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	LUNARIS_DECL void animation_group::clear()
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		for (auto& it : m_list) it->m_group = nullptr;
+		m_list.clear();
+	}
+
+	LUNARIS_DECL size_t animation_group::size() const
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		return m_list.size();
+	}
+
+	LUNARIS_DECL void animation_group::update()
+	{
+		const auto now = std::chrono::steady_clock::now(); // the only clock read for all of them
+
+		std::lock_guard<std::mutex> luck(m_safe);
+		const double dt = m_started ? std::chrono::duration<double>(now - m_last).count() : 0.0;
+		m_last = now;
+		m_started = true;
+
+		for (auto& it : m_list) it->advance(dt);
+	}
+
+	LUNARIS_DECL void animation_group::update(const double dt)
+	{
+		std::lock_guard<std::mutex> luck(m_safe);
+		for (auto& it : m_list) it->advance(dt);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Graphics/texture.h>
+#include <Lunaris/Utility/memory.h>
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Lunaris {
+
+	class animation_group;
+
+	enum class animation_loop_mode {
+		ONCE,		// stops on last frame (finished)
+		LOOP,		// back to first frame
+		PING_PONG	// forward then backwards, forever
+	};
+
+	/// <summary>
+	/// <para>A single frame of an animation: a texture (can be a piece of an atlas) and how long it stays.</para>
+	/// </summary>
+	struct animation_frame {
+		hybrid_memory<texture> tex;
+		hybrid_memory<texture> atlas; // if tex is a piece of an atlas, keep it alive
+		double duration = 0.0; // seconds
+	};
+
+	/// <summary>
+	/// <para>A sequence of frames with a name and a loop mode.</para>
+	/// </summary>
+	struct animation_sequence {
+		std::string name;
+		std::vector<animation_frame> frames;
+		std::vector<double> ends; // cumulative duration of frames (same size as frames)
+		animation_loop_mode mode = animation_loop_mode::LOOP;
+
+		/// <summary>
+		/// <para>Total duration of this sequence (one way).</para>
+		/// </summary>
+		/// <returns>{double} Seconds.</returns>
+		double total() const;
+
+		/// <summary>
+		/// <para>Which frame is shown at this time (already wrapped by the loop mode).</para>
+		/// </summary>
+		/// <param name="{double}">Time in seconds inside [0, total()).</param>
+		/// <returns>{size_t} Frame index.</returns>
+		size_t frame_at(const double) const;
+	};
+
+	/// <summary>
+	/// <para>animation_clip is a shared animation resource: a set of named frame sequences.</para>
+	/// <para>Build it once and share it (hybrid_memory) between as many playheads (blocks) as you want.</para>
+	/// <para>NOTE: It is read without locks while animating and drawing. Build it BEFORE setting it on any playhead!</para>
+	/// </summary>
+	class animation_clip : public NonCopyable {
+		std::vector<animation_sequence> m_seqs;
+
+		animation_sequence& _get_or_create(const std::string&);
+	public:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		animation_clip() = default;
+
+		/// <summary>
+		/// <para>Create (or update the loop mode of) a sequence.</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <param name="{animation_loop_mode}">Loop mode.</param>
+		/// <returns>{size_t} Sequence index.</returns>
+		size_t sequence_create(const std::string&, const animation_loop_mode = animation_loop_mode::LOOP);
+
+		/// <summary>
+		/// <para>Add a frame to the end of a sequence (created if it does not exist).</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <param name="{hybrid_memory&lt;texture&gt;}">A valid texture.</param>
+		/// <param name="{double}">Frame duration in seconds (must be positive).</param>
+		void frame_push_back(const std::string&, const hybrid_memory<texture>&, const double);
+
+		/// <summary>
+		/// <para>Add a frame to the end of a sequence using a region of an atlas texture.</para>
+		/// <para>The atlas is kept alive by the frame.</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <param name="{hybrid_memory&lt;texture&gt;}">The atlas.</param>
+		/// <param name="{int}">Offset X.</param>
+		/// <param name="{int}">Offset Y.</param>
+		/// <param name="{int}">Width.</param>
+		/// <param name="{int}">Height.</param>
+		/// <param name="{double}">Frame duration in seconds (must be positive).</param>
+		void frame_push_back(const std::string&, const hybrid_memory<texture>&, const int, const int, const int, const int, const double);
+
+		/// <summary>
+		/// <para>Add many frames from an atlas organized as a grid (left to right, top to bottom).</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <param name="{hybrid_memory&lt;texture&gt;}">The atlas.</param>
+		/// <param name="{int}">Cell width.</param>
+		/// <param name="{int}">Cell height.</param>
+		/// <param name="{size_t}">First cell index.</param>
+		/// <param name="{size_t}">Amount of cells.</param>
+		/// <param name="{double}">Duration of each frame in seconds (must be positive).</param>
+		void frames_from_grid(const std::string&, const hybrid_memory<texture>&, const int, const int, const size_t, const size_t, const double);
+
+		/// <summary>
+		/// <para>Find a sequence by name.</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <returns>{size_t} Sequence index or npos.</returns>
+		size_t sequence_find(const std::string&) const;
+
+		/// <summary>
+		/// <para>How many sequences are there?</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of sequences.</returns>
+		size_t sequence_size() const;
+
+		/// <summary>
+		/// <para>Get a sequence by index.</para>
+		/// </summary>
+		/// <param name="{size_t}">Index.</param>
+		/// <returns>{animation_sequence} Sequence reference (throws if out of range).</returns>
+		const animation_sequence& sequence_index(const size_t) const;
+	};
+
+	/// <summary>
+	/// <para>animation_playhead is the per-object state of an animation: which clip and sequence, and where in time.</para>
+	/// <para>advance() is the only place where time moves. Drawing only takes the latest frame (a short lock, no clock).</para>
+	/// <para>Changes (clip, sequence) are applied on the next advance().</para>
+	/// </summary>
+	class animation_playhead : public NonCopyable, public NonMovable {
+		hybrid_memory<animation_clip> m_clip;
+		size_t m_seq = 0;
+		double m_time = 0.0;
+
+		std::atomic<const texture*> m_current = nullptr;
+		animation_frame m_cur_frame; // holds the frame shown (and its atlas), even if the clip is gone meanwhile
+		mutable std::mutex m_cur_safe;
+		std::atomic<animation_group*> m_group = nullptr; // group this is in, if any
+		std::atomic<size_t> m_frame = 0;
+		std::atomic<size_t> m_seq_now = 0;
+		std::atomic<bool> m_finished = false;
+		std::atomic<bool> m_paused = false;
+		std::atomic<float> m_speed = 1.0f;
+
+		std::mutex m_pend_safe;
+		std::atomic<bool> m_pending = false;
+		bool m_pend_clip = false;
+		hybrid_memory<animation_clip> m_pend_clip_ref;
+		size_t m_pend_seq = 0;
+
+		void _apply_pending();
+		void _refresh();
+		void _set_current(const animation_frame*);
+
+		friend class animation_group;
+	public:
+		animation_playhead() = default;
+
+		/// <summary>
+		/// <para>Leaves its animation_group, if in one.</para>
+		/// </summary>
+		~animation_playhead();
+
+		/// <summary>
+		/// <para>Set the clip this will play. Starts on the first sequence.</para>
+		/// <para>The current frame changes on the next advance().</para>
+		/// </summary>
+		/// <param name="{hybrid_memory&lt;animation_clip&gt;}">Shared clip (empty to disable).</param>
+		void set_clip(const hybrid_memory<animation_clip>&);
+
+		/// <summary>
+		/// <para>Play (from the beginning) a sequence by name.</para>
+		/// </summary>
+		/// <param name="{std::string}">Sequence name.</param>
+		/// <returns>{bool} True if the sequence exists on the (latest set) clip.</returns>
+		bool play(const std::string&);
+
+		/// <summary>
+		/// <para>Play (from the beginning) a sequence by index.</para>
+		/// </summary>
+		/// <param name="{size_t}">Sequence index.</param>
+		/// <returns>{bool} True if the sequence exists on the (latest set) clip.</returns>
+		bool play(const size_t);
+
+		/// <summary>
+		/// <para>Set time scale (1.0 is normal, negative plays backwards).</para>
+		/// </summary>
+		/// <param name="{float}">Speed.</param>
+		void set_speed(const float);
+
+		/// <summary>
+		/// <para>Current time scale.</para>
+		/// </summary>
+		/// <returns>{float} Speed.</returns>
+		float get_speed() const;
+
+		/// <summary>
+		/// <para>Pause or resume.</para>
+		/// </summary>
+		/// <param name="{bool}">Paused?</param>
+		void set_paused(const bool);
+
+		/// <summary>
+		/// <para>Is this paused?</para>
+		/// </summary>
+		/// <returns>{bool} True if paused.</returns>
+		bool is_paused() const;
+
+		/// <summary>
+		/// <para>A ONCE sequence reached its end?</para>
+		/// </summary>
+		/// <returns>{bool} True if finished.</returns>
+		bool is_finished() const;
+
+		/// <summary>
+		/// <para>Sequence index being played.</para>
+		/// </summary>
+		/// <returns>{size_t} Sequence index.</returns>
+		size_t get_sequence() const;
+
+		/// <summary>
+		/// <para>Frame index (in the sequence) being shown.</para>
+		/// </summary>
+		/// <returns>{size_t} Frame index.</returns>
+		size_t get_frame() const;
+
+		/// <summary>
+		/// <para>Texture of the current frame.</para>
+		/// <para>The pointer is only valid while that frame is shown. To draw from another thread, use current_frame().</para>
+		/// </summary>
+		/// <returns>{texture*} Current texture or null if there's no clip/frame.</returns>
+		const texture* current() const;
+
+		/// <summary>
+		/// <para>Copy of the current frame. It keeps its texture (and atlas) alive, even if the clip changes or is destroyed meanwhile.</para>
+		/// </summary>
+		/// <returns>{animation_frame} Current frame (empty texture if there's no clip/frame).</returns>
+		animation_frame current_frame() const;
+
+		/// <summary>
+		/// <para>Move time forward (or backwards, with negative speed) and update current frame.</para>
+		/// <para>You don't need to call this if this is on an animation_group.</para>
+		/// </summary>
+		/// <param name="{double}">Delta time in seconds.</param>
+		void advance(const double);
+	};
+
+	/// <summary>
+	/// <para>animation_group advances many playheads at once from a single clock read.</para>
+	/// <para>Call update() once per frame (before drawing, usually).</para>
+	/// <para>A playhead is in one group at a time. Destroying a playhead removes it from its group.</para>
+	/// </summary>
+	class animation_group : public NonCopyable {
+		std::vector<animation_playhead*> m_list;
+		mutable std::mutex m_safe;
+		std::chrono::steady_clock::time_point m_last;
+		bool m_started = false;
+	public:
+		animation_group() = default;
+
+		/// <summary>
+		/// <para>Releases all playheads.</para>
+		/// </summary>
+		~animation_group();
+
+		/// <summary>
+		/// <para>Add a playhead to this group (it leaves the group it was in, if any).</para>
+		/// </summary>
+		/// <param name="{animation_playhead&amp;}">Playhead reference.</param>
+		void push_back(animation_playhead&);
+
+		/// <summary>
+		/// <para>Remove a playhead from this group.</para>
+		/// </summary>
+		/// <param name="{animation_playhead&amp;}">Playhead reference.</param>
+		/// <returns>{bool} True if found.</returns>
+		bool remove(const animation_playhead&);
+
+		/// <summary>
+		/// <para>Remove all playheads.</para>
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		/// <para>Amount of playheads in this group.</para>
+		/// </summary>
+		/// <returns>{size_t} Size.</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// <para>Read the clock once and advance all playheads by the time since last update.</para>
+		/// <para>The first call only starts the clock.</para>
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// <para>Advance all playheads by a fixed delta (does not touch the clock).</para>
+		/// </summary>
+		/// <param name="{double}">Delta time in seconds.</param>
+		void update(const double);
+	};
+
+}
\ No newline at end of file
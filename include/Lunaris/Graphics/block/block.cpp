@@ -49,6 +49,12 @@ namespace Lunaris {
 
 		// assume pos0 for now:
 
+		if (m_anim.current()) { // clip: frame already selected by advance(), no clock
+			const animation_frame fast = m_anim.current_frame(); // keeps the texture alive while drawing
+			if (!fast.tex.empty() && !fast.tex->empty()) generic_draw_no_lock(*fast.tex);
+			return;
+		}
+
 		if (textures.empty()) return;
 
 		auto lock = mu_shared_read_control();
@@ -137,4 +143,14 @@ namespace Lunaris {
 		textures.clear();
 	}
 
+	LUNARIS_DECL animation_playhead& block::get_animation()
+	{
+		return m_anim;
+	}
+
+	LUNARIS_DECL const animation_playhead& block::get_animation() const
+	{
+		return m_anim;
+	}
+
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <Lunaris/Graphics/transform.h>
 #include <Lunaris/Graphics/sprite.h>
 #include <Lunaris/Graphics/texture.h>
+#include <Lunaris/Graphics/animation.h>
 
 #include <vector>
 #include <shared_mutex>
@@ -62,6 +63,8 @@ namespace Lunaris {
 
 	/// <summary>
 	/// <para>block is a sprite with texture and extra animation features.</para>
+	/// <para>For many animated blocks, prefer a shared animation_clip on the playhead (get_animation()) advanced by an animation_group.</para>
+	/// <para>If the playhead has a clip, it is used instead of the texture list.</para>
 	/// </summary>
 	class block :
 		public sprite,
@@ -73,6 +76,7 @@ namespace Lunaris {
 		// variables
 		mutable std::shared_mutex textures_mtx;
 		std::vector<hybrid_memory<texture>> textures;
+		animation_playhead m_anim; // clip based animation (fast path)
 		//_block_drawing_references_fast _draw_fast;
 
 		// funcs
@@ -129,6 +133,18 @@ namespace Lunaris {
 		/// </summary>
 		void texture_remove_all();
 
+		/// <summary>
+		/// <para>The animation playhead of this block. Set a clip and push it into an animation_group.</para>
+		/// </summary>
+		/// <returns>{animation_playhead&amp;} This block's playhead.</returns>
+		animation_playhead& get_animation();
+
+		/// <summary>
+		/// <para>The animation playhead of this block.</para>
+		/// </summary>
+		/// <returns>{animation_playhead&amp;} This block's playhead.</returns>
+		const animation_playhead& get_animation() const;
+
 		// inheritance
 		using sprite::set;
 		using sprite::get;
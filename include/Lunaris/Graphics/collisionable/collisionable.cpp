@@ -95,6 +95,32 @@ namespace Lunaris {
 		if (s != generated_on_think.size()) generated_on_think.resize(s);
 	}
 
+	LUNARIS_DECL void collisionable_base::world_apply_points()
+	{
+		transform tf;
+		{
+			std::lock_guard<std::mutex> luck(world_safe);
+			if (!use_world) return;
+			tf = world;
+		}
+		for (auto& it : generated_on_think) tf.transform_coords(it.px, it.py);
+	}
+
+	LUNARIS_DECL void collisionable_base::world_direction_to_local(float& dx, float& dy) const
+	{
+		transform tf;
+		{
+			std::lock_guard<std::mutex> luck(world_safe);
+			if (!use_world) return;
+			tf = world;
+		}
+		float ox = 0.0f, oy = 0.0f;
+		tf.transform_inverse_coords(ox, oy);
+		tf.transform_inverse_coords(dx, dy);
+		dx -= ox;
+		dy -= oy;
+	}
+
 	LUNARIS_DECL collisionable_base::collisionable_base() :
 		fixed_multi_map_work<static_cast<size_t>(enum_collisionable_float_e::_SIZE), float, enum_collisionable_float_e>(default_collisionable_float_il),
 		fixed_multi_map_work<static_cast<size_t>(enum_collisionable_boolean_e::_SIZE), bool, enum_collisionable_boolean_e>(default_collisionable_boolean_il)
@@ -112,6 +138,7 @@ namespace Lunaris {
 		bool& oth_last_was_collision = oth.get<bool>(enum_collisionable_boolean_e::RO_LAST_WAS_COLLISION);
 
 		if (last_was_collision && oth_last_was_collision) return; // already col
+		if (get<bool>(enum_collisionable_boolean_e::DISABLED) || oth.get<bool>(enum_collisionable_boolean_e::DISABLED)) return; // hidden / not here
 
 		const auto& me_pts = read_points();
 		const auto& oth_pts = oth.read_points();
@@ -206,6 +233,7 @@ namespace Lunaris {
 
 	LUNARIS_DECL bool collisionable_base::collide_test(const collisionable_base& oth) const
 	{
+		if (get<bool>(enum_collisionable_boolean_e::DISABLED) || oth.get<bool>(enum_collisionable_boolean_e::DISABLED)) return false;
 		const auto me_pts = read_points();
 		const auto oth_pts = oth.read_points();
 		bool col_once = false;
@@ -220,6 +248,7 @@ namespace Lunaris {
 
 	LUNARIS_DECL bool collisionable_base::collide_test(const float& x, const float& y) const
 	{
+		if (get<bool>(enum_collisionable_boolean_e::DISABLED)) return false;
 		const auto me_pts = read_points();
 		return polygon_is_point_inside({ x, y }, me_pts);
 	}
@@ -246,6 +275,19 @@ namespace Lunaris {
 		}
 	}
 
+	LUNARIS_DECL void collisionable_base::set_world_transform(const transform& oth)
+	{
+		std::lock_guard<std::mutex> luck(world_safe);
+		world = oth;
+		use_world = true;
+	}
+
+	LUNARIS_DECL void collisionable_base::reset_world_transform()
+	{
+		std::lock_guard<std::mutex> luck(world_safe);
+		use_world = false;
+	}
+
 	LUNARIS_DECL collisionable_sprite::collisionable_sprite(sprite& s) : 
 		fixed_multi_map_work<static_cast<size_t>(enum_collisionable_sprite_float_e::_SIZE), float, enum_collisionable_sprite_float_e>(default_collisionable_sprite_float_il),
 		collisionable_base(),
@@ -259,8 +301,9 @@ namespace Lunaris {
 		const bool& last_was_collision = get<bool>(enum_collisionable_boolean_e::RO_LAST_WAS_COLLISION);
 
 		if (last_was_collision) {
-			const float& direction_x_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_X_FINAL);
-			const float& direction_y_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_Y_FINAL);
+			float direction_x_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_X_FINAL);
+			float direction_y_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_Y_FINAL);
+			world_direction_to_local(direction_x_final, direction_y_final);
 			const float& reflectiveness = get<float>(enum_collisionable_sprite_float_e::REFLECTIVENESS);
 
 			ref.set<float>(enum_sprite_float_e::POS_X, ref.get<float>(enum_sprite_float_e::POS_X) + direction_x_final * 1.000001f);
@@ -309,6 +352,7 @@ namespace Lunaris {
 		vec_get_at(2).py = ref.get<float>(enum_sprite_float_e::RO_THINK_POINT_SOUTHEAST_Y);
 		vec_get_at(3).px = ref.get<float>(enum_sprite_float_e::RO_THINK_POINT_SOUTHWEST_X);
 		vec_get_at(3).py = ref.get<float>(enum_sprite_float_e::RO_THINK_POINT_SOUTHWEST_Y);
+		world_apply_points();
 	}
 
 	LUNARIS_DECL float collisionable_vertexes::get_center_x() const
@@ -342,8 +386,9 @@ namespace Lunaris {
 		const bool& last_was_collision = get<bool>(enum_collisionable_boolean_e::RO_LAST_WAS_COLLISION);
 
 		if (last_was_collision) {
-			const float& direction_x_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_X_FINAL);
-			const float& direction_y_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_Y_FINAL);
+			float direction_x_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_X_FINAL);
+			float direction_y_final = get<float>(enum_collisionable_float_e::RO_DIRECTION_Y_FINAL);
+			world_direction_to_local(direction_x_final, direction_y_final);
 
 			ref.translate(direction_x_final * 1.000001f, direction_y_final * 1.000001f);
 		}
@@ -364,6 +409,7 @@ namespace Lunaris {
 		ref.generate_transformed();
 		vec_fit(ref.size());
 		ref.csafe_transformed([&](const std::vector<vertex_point>& vec) { for (size_t p = 0; p < vec.size(); ++p) { vec_get_at(p).px = vec[p].x; vec_get_at(p).py = vec[p].y; } });
+		world_apply_points();
 
 		if (!last_was_collision) {
 			direction_x_revert = last_px - entcenter[0];
@@ -396,6 +442,7 @@ namespace Lunaris {
 		auto ptr = std::unique_ptr<collisionable_base>(new collisionable_sprite(s));
 		if (f) f((collisionable_sprite*)ptr.get());
 		ptr->set<bool>(enum_collisionable_boolean_e::LOCKED, lckd);
+		std::unique_lock<std::shared_mutex> luck(objs_safe);
 		objs.push_back(std::move(ptr));
 	}
 
@@ -404,9 +451,27 @@ namespace Lunaris {
 		auto ptr = std::unique_ptr<collisionable_base>(new collisionable_vertexes(s));
 		if (f) f((collisionable_vertexes*)ptr.get());
 		ptr->set<bool>(enum_collisionable_boolean_e::LOCKED, lckd);
+		std::unique_lock<std::shared_mutex> luck(objs_safe);
 		objs.push_back(std::move(ptr));
 	}
 
+	LUNARIS_DECL bool collisionable_manager::remove(const collisionable_base* ptr)
+	{
+		if (thinking_thread == std::this_thread::get_id()) { // from a callback, objs_safe is locked by think_all already
+			remove_later.push_back(ptr);
+			return true;
+		}
+
+		std::unique_lock<std::shared_mutex> luck(objs_safe);
+		for (auto it = objs.begin(); it != objs.end(); ++it) {
+			if (it->get() == ptr) {
+				objs.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
 	LUNARIS_DECL size_t collisionable_manager::size() const
 	{
 		return objs.size();
@@ -441,6 +506,7 @@ namespace Lunaris {
 	LUNARIS_DECL void collisionable_manager::think_all()
 	{
 		std::unique_lock<std::shared_mutex> luck(objs_safe);
+		thinking_thread = std::this_thread::get_id();
 
 		for (auto& it : objs) it->think_once(); // think()
 
@@ -455,5 +521,12 @@ namespace Lunaris {
 		}
 
 		for (auto& it : objs) it->apply(); // do move if needed (based on collision)
+		thinking_thread = std::thread::id();
+
+		for (const auto& ptr : remove_later) {
+			auto it = std::find_if(objs.begin(), objs.end(), [&](const std::unique_ptr<collisionable_base>& o) { return o.get() == ptr; });
+			if (it != objs.end()) objs.erase(it);
+		}
+		remove_later.clear();
 	}
 }
\ No newline at end of file
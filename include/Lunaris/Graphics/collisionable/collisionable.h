@@ -3,6 +3,7 @@
 #include <Lunaris/__macro/macros.h>
 #include <Lunaris/Graphics/sprite.h>
 #include <Lunaris/Graphics/vertex.h>
+#include <Lunaris/Graphics/transform.h>
 #include <Lunaris/Utility/random.h>
 #include <Lunaris/Utility/mutex.h>
 
@@ -11,6 +12,9 @@
 #include <optional>
 #include <memory>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <thread>
 
 #undef max
 #undef min
@@ -53,6 +57,7 @@ namespace Lunaris {
 
 		// REFERENCE DATA (set by user)
 		LOCKED,								// (default: false) Lock any changes by collision in position?
+		DISABLED,							// (default: false) Skip this object on collision tests (like if it was not there). Used by scene_node when hidden.
 
 		_SIZE
 	};
@@ -88,7 +93,8 @@ namespace Lunaris {
 		{false,			enum_collisionable_boolean_e::RO_LAST_WAS_COLLISION},
 
 		// REFERENCE DATA (set by user)
-		{false,			enum_collisionable_boolean_e::LOCKED}
+		{false,			enum_collisionable_boolean_e::LOCKED},
+		{false,			enum_collisionable_boolean_e::DISABLED}
 	};
 
 	const std::initializer_list<multi_pair<float, enum_collisionable_sprite_float_e>>	default_collisionable_sprite_float_il = {
@@ -116,6 +122,14 @@ namespace Lunaris {
 
 		std::vector<supported_fast_point_2d> generated_on_think; // commonly based on screen position (for easier "real" collision)
 		std::function<void(collisionable_base*)> on_collision_do;
+		transform world; // applied on generated points if use_world (like when in a scene_node)
+		bool use_world = false;
+		mutable std::mutex world_safe; // world is set by the scene thread and read by the collision thread
+
+		// Apply world transform (if set) on generated_on_think
+		void world_apply_points();
+		// Direction in world coordinates back to local (if world transform set)
+		void world_direction_to_local(float&, float&) const;
 
 		// Easy get index of vector (always valid, but vec_fit() first is recommended)
 		supported_fast_point_2d& vec_get_at(const size_t);
@@ -177,6 +191,17 @@ namespace Lunaris {
 		/// </summary>
 		void apply();
 
+		/// <summary>
+		/// <para>Points are generated in local coordinates of this transform (like a scene_node world transform), so they're tested where they're drawn.</para>
+		/// </summary>
+		/// <param name="{transform}">Transform (copied).</param>
+		void set_world_transform(const transform&);
+
+		/// <summary>
+		/// <para>Remove the world transform set by set_world_transform.</para>
+		/// </summary>
+		void reset_world_transform();
+
 		using fixed_multi_map_work<static_cast<size_t>(enum_collisionable_float_e::_SIZE), float, enum_collisionable_float_e>::set;
 		using fixed_multi_map_work<static_cast<size_t>(enum_collisionable_float_e::_SIZE), float, enum_collisionable_float_e>::get;
 		using fixed_multi_map_work<static_cast<size_t>(enum_collisionable_float_e::_SIZE), float, enum_collisionable_float_e>::index;
@@ -258,6 +283,8 @@ namespace Lunaris {
 	protected:
 		std::vector<std::unique_ptr<collisionable_base>> objs;
 		mutable std::shared_mutex objs_safe;
+		std::atomic<std::thread::id> thinking_thread; // thread inside think_all (remove from it is done when think_all ends)
+		std::vector<const collisionable_base*> remove_later; // only used by thinking_thread
 	public:
 		/// <summary>
 		/// <para>Add a reference to a sprite (automatically builds collision object inside referencing this).</para>
@@ -289,6 +316,14 @@ namespace Lunaris {
 		/// <param name="{bool}">Lock this sprite movement (from this)?</param>
 		void push_back(vertexes&, std::function<void(collisionable_vertexes*)>, const bool = false);
 
+		/// <summary>
+		/// <para>Remove (and destroy) a collisionable from this.</para>
+		/// <para>If called from a collision callback (inside think_all), it is removed when think_all ends, so keep what it references alive until then.</para>
+		/// </summary>
+		/// <param name="{collisionable_base*}">The collisionable, as given by push_back.</param>
+		/// <returns>{bool} True if found and removed.</returns>
+		bool remove(const collisionable_base*);
+
 		/// <summary>
 		/// <para>The amount of collisionables in here.</para>
 		/// </summary>
@@ -222,6 +222,14 @@ namespace Lunaris {
 		}
 	}
 
+	LUNARIS_DECL void display::refresh_latest_transform()
+	{
+		auto* c = al_get_current_transform();
+		if (!c || memcmp(c, &latest_transform, sizeof(ALLEGRO_TRANSFORM)) == 0) return;
+		latest_transform = *c;
+		++latest_transform_version;
+	}
+
 	LUNARIS_DECL bool display::auto_get_next_event(ALLEGRO_EVENT& rev)
 	{
 		return ev_qu ? ((wait_for_display_flip_before_drop && timed_draw) ? (al_wait_for_event_timed(ev_qu, &rev, max_time_wait_for_event)) : (al_get_next_event(ev_qu, &rev))) : false;
@@ -287,6 +295,7 @@ namespace Lunaris {
 		al_set_target_backbuffer(window);
 
 		al_identity_transform(&latest_transform);
+		++latest_transform_version;
 
 		economy_fps = conf.min_frames < 0.0 ? 0.0 : conf.min_frames;
 		default_fps = conf.max_frames < 0.0 ? 0.0 : conf.max_frames;
@@ -294,7 +303,9 @@ namespace Lunaris {
 
 		fix_timers();
 
-		if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+		refresh_latest_transform();
+
+		sources_changed.notify();
 
 #ifdef LUNARIS_VERBOSE_BUILD
 		if (window != nullptr) PRINT_DEBUG("Display %p successfully launched", this);
@@ -549,6 +560,7 @@ namespace Lunaris {
 				last_icon_handle = nullptr;
 			}
 #endif
+			sources_changed.notify();
 #ifdef LUNARIS_VERBOSE_BUILD
 			PRINT_DEBUG("Display %p successfully destroyed everything", this);
 #endif
@@ -581,6 +593,11 @@ namespace Lunaris {
 		return get_event_sources();
 	}
 
+	LUNARIS_DECL event_source_notifier& display::get_event_source_notifier()
+	{
+		return sources_changed;
+	}
+
 	LUNARIS_DECL std::function<ALLEGRO_TRANSFORM(void)> display::get_current_transform_function()
 	{
 		return [&] {return latest_transform; };
@@ -591,6 +608,11 @@ namespace Lunaris {
 		return [&] {return latest_transform; };
 	}
 
+	LUNARIS_DECL std::function<uint64_t(void)> display::get_transform_version_function()
+	{
+		return [&] {return latest_transform_version.load(); };
+	}
+
 	LUNARIS_DECL void display::set_as_target() const
 	{
 		if (window) al_set_target_backbuffer(window);
@@ -615,7 +637,7 @@ namespace Lunaris {
 
 					economy_mode = false;
 					fix_timers();
-					if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+					refresh_latest_transform();
 
 					break;
 
@@ -624,7 +646,7 @@ namespace Lunaris {
 
 					economy_mode = true;
 					fix_timers();
-					if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+					refresh_latest_transform();
 
 					break;
 
@@ -639,26 +661,26 @@ namespace Lunaris {
 
 					al_acknowledge_drawing_resume(window);
 					hold_draw(false);
-					if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+					refresh_latest_transform();
 
 					break;
 
 				case ALLEGRO_EVENT_DISPLAY_RESIZE:
 
 					acknowledge_resize();
-					if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+					refresh_latest_transform();
 
 					break;
 
 				case static_cast<int>(custom_events::DISPLAY_FLAG_TOGGLE):
 
-					if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+					refresh_latest_transform();
 					break;
 
 				case ALLEGRO_EVENT_TIMER: // DRAW EVENT!
 
 					if (ev.timer.source == update_tasks) {
-						if (auto* c = al_get_current_transform(); c) latest_transform = *c;
+						refresh_latest_transform();
 
 						if (promises.size()) {
 							promises.safe([](std::vector<promise<bool>>& vec) { for (auto& i : vec) { i.set_value(true); } vec.clear(); });
@@ -22,6 +22,8 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <cstring>
 
 namespace Lunaris {
 
@@ -110,9 +112,11 @@ namespace Lunaris {
 		ALLEGRO_TIMER* timed_draw = nullptr;
 		ALLEGRO_TIMER* update_tasks = nullptr;
 		ALLEGRO_EVENT_SOURCE evsrc; // on toggle, because it's broken somehow lol
+		event_source_notifier sources_changed; // create/destroy tell event handlers right away
 		std::string latest_window_title;
 
 		ALLEGRO_TRANSFORM latest_transform{}; // useful elsewhere, trust me (see mouse)
+		std::atomic<uint64_t> latest_transform_version = 0; // changes when latest_transform changes (mouse caches its inverse)
 
 		bool economy_mode = false;
 		bool totally_hold_draw = false;
@@ -128,6 +132,7 @@ namespace Lunaris {
 		HICON last_icon_handle = nullptr;
 #endif
 		void fix_timers();
+		void refresh_latest_transform(); // copy current transform and bump version if it changed
 
 		// automatically handle wait_for_display_flip_before_drop property and wait or get directly (or max_time_wait_for_event)
 		bool auto_get_next_event(ALLEGRO_EVENT&);
@@ -374,6 +379,12 @@ namespace Lunaris {
 		/// </summary>
 		operator std::vector<ALLEGRO_EVENT_SOURCE*>() const;
 
+		/// <summary>
+		/// <para>Notifier called when the event sources change (create/destroy). Event handlers use this.</para>
+		/// </summary>
+		/// <returns>{event_source_notifier&amp;} The notifier.</returns>
+		event_source_notifier& get_event_source_notifier();
+
 		/// <summary>
 		/// <para>Get a function that copy the latest display transformation.</para>
 		/// <para>This is used on things that depends on display transformation to work right, like mouse related stuff.</para>
@@ -387,6 +398,13 @@ namespace Lunaris {
 		/// </summary>
 		operator std::function<ALLEGRO_TRANSFORM(void)>() const;
 
+		/// <summary>
+		/// <para>Get a function that reads the version of the latest display transformation (it changes when the transformation changes).</para>
+		/// <para>Give this to mouse with the transform function so it only inverts the transformation when needed.</para>
+		/// </summary>
+		/// <returns>{function} A function that gets the latest transformation version.</returns>
+		std::function<uint64_t(void)> get_transform_version_function();
+
 		/// <summary>
 		/// <para>Force set this as the target for this thread.</para>
 		/// <para>WARNING: you should do this only on the thread the display was created, or things may break.</para>
@@ -545,6 +545,7 @@ namespace Lunaris {
         oth.curr.menu = nullptr; // really really sure
         oth.ev_source = nullptr;
         oth.last_applied_display = nullptr;
+        oth.sources_changed.notify();
     }
 
     LUNARIS_DECL menu::menu(const std::initializer_list<menu_quick> lst)
@@ -584,8 +585,9 @@ namespace Lunaris {
     LUNARIS_DECL menu::~menu()
     {
         if (!curr.menu) return;
-        al_disable_menu_event_source(curr.menu);
         ev_source = nullptr;
+        sources_changed.notify(); // handlers drop it while it's still valid
+        al_disable_menu_event_source(curr.menu);
         al_destroy_menu(curr.menu);
         curr.menu = nullptr;
     }
@@ -791,6 +793,11 @@ namespace Lunaris {
         return ev_source;
     }
 
+    LUNARIS_DECL event_source_notifier& menu::get_event_source_notifier()
+    {
+        return sources_changed;
+    }
+
     LUNARIS_DECL menu_event::menu_event(menu& mn, const ALLEGRO_EVENT& ev)
         : _ref(mn)
     {
@@ -379,6 +379,7 @@ namespace Lunaris {
 		__menu_structure curr;
 		std::atomic<uint16_t> _counter = 0;
 		ALLEGRO_EVENT_SOURCE* ev_source = nullptr;
+		event_source_notifier sources_changed; // tell event handlers when ev_source changes
 		const menu_type mmt = menu_type::BAR;
 		ALLEGRO_DISPLAY* last_applied_display = nullptr;
 
@@ -571,6 +572,12 @@ namespace Lunaris {
 		/// </summary>
 		/// <returns>{ALLEGRO_EVENT_SOURCE*} Menu event source.</returns>
 		ALLEGRO_EVENT_SOURCE* get_event_source() const;
+
+		/// <summary>
+		/// <para>Notifier called when the event source changes. Event handlers use this.</para>
+		/// </summary>
+		/// <returns>{event_source_notifier&amp;} The notifier.</returns>
+		event_source_notifier& get_event_source_notifier();
 	};
 
 	/// <summary>
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "scene/scene.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "scene/scene.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "scene.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL scene_node::scene_node(scene_node* par)
+		: m_parent(par)
+	{
+		m_world.identity();
+	}
+
+	LUNARIS_DECL void scene_node::mark_dirty()
+	{
+		m_dirty = true;
+		for (scene_node* p = m_parent; p && !p->m_child_dirty.exchange(true); p = p->m_parent); // stops where it was already set
+	}
+
+	LUNARIS_DECL void scene_node::_update(const transform* parent_world, const bool parent_visible, const bool force)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+
+		const bool rebuild = force || m_dirty;
+		if (!rebuild && !m_child_dirty) return; // nothing changed in here
+
+		if (rebuild) {
+			m_world.build_transform(m_pos_x, m_pos_y, m_scale_x, m_scale_y, m_rotation);
+			if (parent_world) m_world.compose(*parent_world);
+
+			for (auto& it : m_collisions) it.col->set_world_transform(m_world);
+
+			const bool vis = parent_visible && m_visible;
+			if (vis != m_world_visible) {
+				m_world_visible = vis;
+				for (auto& it : m_collisions) it.col->set<bool>(enum_collisionable_boolean_e::DISABLED, !vis);
+			}
+			m_dirty = false;
+		}
+		m_child_dirty = false;
+
+		for (auto& it : m_children) it->_update(&m_world, m_world_visible, rebuild);
+	}
+
+	LUNARIS_DECL void scene_node::_draw(const transform& camera)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (!m_world_visible) return;
+
+		if (m_sprites.size() || m_vertexes.size()) {
+			transform combo = m_world;
+			combo.compose(camera);
+			combo.apply();
+
+			for (auto& it : m_sprites) it->draw();
+			for (auto& it : m_vertexes) it->draw();
+		}
+
+		for (auto& it : m_children) it->_draw(camera);
+	}
+
+	LUNARIS_DECL void scene_node::_register_collisions(collisionable_manager& mng)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		const auto has = [&](const void* src) { return std::find_if(m_collisions.begin(), m_collisions.end(), [&](const registered& r) { return r.src == src && r.mng == &mng; }) != m_collisions.end(); };
+		const auto hold = [&](collisionable_base* c, const void* src) {
+			m_collisions.push_back({ c, &mng, src });
+			c->set_world_transform(m_world);
+			c->set<bool>(enum_collisionable_boolean_e::DISABLED, !m_world_visible);
+		};
+
+		for (auto& it : m_sprites) if (!has(it)) mng.push_back(*it, [&](collisionable_sprite* c) { hold(c, it); });
+		for (auto& it : m_vertexes) if (!has(it)) mng.push_back(*it, [&](collisionable_vertexes* c) { hold(c, it); });
+		for (auto& it : m_children) it->_register_collisions(mng);
+	}
+
+	LUNARIS_DECL void scene_node::_unregister(const void* src)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_collisions.begin(); it != m_collisions.end();) {
+			if (!src || it->src == src) {
+				it->mng->remove(it->col);
+				it = m_collisions.erase(it);
+			}
+			else ++it;
+		}
+	}
+
+	LUNARIS_DECL void scene_node::_unregister_tree(collisionable_manager& mng)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_collisions.begin(); it != m_collisions.end();) {
+			if (it->mng == &mng) {
+				it->mng->remove(it->col);
+				it = m_collisions.erase(it);
+			}
+			else ++it;
+		}
+		for (auto& it : m_children) it->_unregister_tree(mng);
+	}
+
+	LUNARIS_DECL scene_node::scene_node()
+		: scene_node(nullptr)
+	{
+	}
+
+	LUNARIS_DECL scene_node::~scene_node()
+	{
+		_unregister(nullptr); // children do the same on their own destructor
+	}
+
+	LUNARIS_DECL scene_node& scene_node::create_child()
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_children.push_back(std::unique_ptr<scene_node>(new scene_node(this)));
+		m_children.back()->mark_dirty();
+		return *m_children.back();
+	}
+
+	LUNARIS_DECL bool scene_node::remove_child(const scene_node& chl)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_children.begin(); it != m_children.end(); ++it) {
+			if (it->get() == &chl) {
+				m_children.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	LUNARIS_DECL size_t scene_node::children_size() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		return m_children.size();
+	}
+
+	LUNARIS_DECL scene_node* scene_node::child_index(const size_t index) const
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (index >= m_children.size()) return nullptr;
+		return m_children[index].get();
+	}
+
+	LUNARIS_DECL scene_node* scene_node::get_parent() const
+	{
+		return m_parent;
+	}
+
+	LUNARIS_DECL void scene_node::attach(sprite& spr)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_sprites.push_back(&spr);
+	}
+
+	LUNARIS_DECL void scene_node::attach(vertexes& vtx)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_vertexes.push_back(&vtx);
+	}
+
+	LUNARIS_DECL bool scene_node::detach(const sprite& spr)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_sprites.begin(); it != m_sprites.end(); ++it) {
+			if (*it == &spr) {
+				_unregister(&spr);
+				m_sprites.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	LUNARIS_DECL bool scene_node::detach(const vertexes& vtx)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		for (auto it = m_vertexes.begin(); it != m_vertexes.end(); ++it) {
+			if (*it == &vtx) {
+				_unregister(&vtx);
+				m_vertexes.erase(it);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	LUNARIS_DECL void scene_node::detach_all()
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		_unregister(nullptr);
+		m_sprites.clear();
+		m_vertexes.clear();
+	}
+
+	LUNARIS_DECL void scene_node::register_collisions(collisionable_manager& mng)
+	{
+		update(); // get latest visibility
+		_register_collisions(mng);
+	}
+
+	LUNARIS_DECL void scene_node::unregister_collisions(collisionable_manager& mng)
+	{
+		_unregister_tree(mng);
+	}
+
+	LUNARIS_DECL void scene_node::set_position(const float x, const float y)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_pos_x = x;
+		m_pos_y = y;
+		mark_dirty();
+	}
+
+	LUNARIS_DECL void scene_node::set_rotation(const float r)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_rotation = r;
+		mark_dirty();
+	}
+
+	LUNARIS_DECL void scene_node::set_scale(const float x, const float y)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_scale_x = x;
+		m_scale_y = y;
+		mark_dirty();
+	}
+
+	LUNARIS_DECL void scene_node::translate(const float x, const float y)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_pos_x += x;
+		m_pos_y += y;
+		mark_dirty();
+	}
+
+	LUNARIS_DECL float scene_node::get_position_x() const
+	{
+		return m_pos_x;
+	}
+
+	LUNARIS_DECL float scene_node::get_position_y() const
+	{
+		return m_pos_y;
+	}
+
+	LUNARIS_DECL float scene_node::get_rotation() const
+	{
+		return m_rotation;
+	}
+
+	LUNARIS_DECL float scene_node::get_scale_x() const
+	{
+		return m_scale_x;
+	}
+
+	LUNARIS_DECL float scene_node::get_scale_y() const
+	{
+		return m_scale_y;
+	}
+
+	LUNARIS_DECL void scene_node::set_visible(const bool vis)
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		if (m_visible == vis) return;
+		m_visible = vis;
+		mark_dirty();
+	}
+
+	LUNARIS_DECL bool scene_node::is_visible() const
+	{
+		return m_visible;
+	}
+
+	LUNARIS_DECL bool scene_node::is_visible_in_tree() const
+	{
+		return m_world_visible;
+	}
+
+	LUNARIS_DECL void scene_node::update()
+	{
+		if (m_parent) {
+			std::lock_guard<std::recursive_mutex> pluck(m_parent->m_safe); // parent first, like a full update from the root
+			_update(&m_parent->m_world, m_parent->m_world_visible, false);
+		}
+		else _update(nullptr, true, false);
+	}
+
+	LUNARIS_DECL void scene_node::draw()
+	{
+		update();
+
+		transform camera;
+		if (!camera.get_current_transform()) return;
+		_draw(camera);
+		camera.apply(); // reset transformation
+	}
+
+	LUNARIS_DECL transform scene_node::copy_world_transform() const
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		return m_world;
+	}
+
+	LUNARIS_DECL void scene_node::local_to_world(float& x, float& y) const
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_world.transform_coords(x, y);
+	}
+
+	LUNARIS_DECL void scene_node::world_to_local(float& x, float& y) const
+	{
+		std::lock_guard<std::recursive_mutex> luck(m_safe);
+		m_world.transform_inverse_coords(x, y);
+	}
+
+}
\ No newline at end of file
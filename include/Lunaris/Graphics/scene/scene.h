@@ -0,0 +1,249 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Graphics/transform.h>
+#include <Lunaris/Graphics/sprite.h>
+#include <Lunaris/Graphics/vertex.h>
+#include <Lunaris/Graphics/collisionable.h>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+namespace Lunaris {
+
+	/// <summary>
+	/// <para>scene_node is a node of a scene graph. Each node has a local transform (position, rotation and scale) relative to its parent.</para>
+	/// <para>Sprites (and so block and text) and vertexes attached to a node are drawn with the node's world transform applied on top of the camera, so moving a node moves everything below it at once.</para>
+	/// <para>World transforms are only rebuilt for the subtrees that changed since the last update() (dirty flags).</para>
+	/// <para>Hidden nodes (or nodes with a hidden parent) don't draw and their registered collisionables are DISABLED.</para>
+	/// <para>NOTE: attached objects are references. They MUST EXIST while attached!</para>
+	/// </summary>
+	class scene_node : public NonCopyable, public NonMovable {
+		scene_node* m_parent = nullptr;
+		std::vector<std::unique_ptr<scene_node>> m_children;
+		std::vector<sprite*> m_sprites;
+		std::vector<vertexes*> m_vertexes;
+		struct registered {
+			collisionable_base* col;
+			collisionable_manager* mng;
+			const void* src; // sprite or vertexes it was made from
+		};
+		std::vector<registered> m_collisions;
+		mutable std::recursive_mutex m_safe;
+
+		transform m_world;
+		float m_pos_x = 0.0f, m_pos_y = 0.0f, m_rotation = 0.0f, m_scale_x = 1.0f, m_scale_y = 1.0f;
+		bool m_visible = true; // user set
+		bool m_world_visible = true; // combined with parents
+		bool m_dirty = true; // this node (and so its children) needs a new world transform
+		std::atomic<bool> m_child_dirty = false; // some node below needs update (set by children without this lock)
+
+		scene_node(scene_node*);
+
+		void mark_dirty(); // sets dirty and tells parents there's work below
+		void _update(const transform*, const bool, const bool); // parent world (null if root), parent visible, force
+		void _draw(const transform&); // camera
+		void _register_collisions(collisionable_manager&);
+		void _unregister(const void*); // collisionables made from this object (null = all of this node)
+		void _unregister_tree(collisionable_manager&); // this and children, from this manager
+	public:
+		scene_node();
+
+		/// <summary>
+		/// <para>Removes the collisionables it registered and destroys its children.</para>
+		/// </summary>
+		~scene_node();
+
+		/// <summary>
+		/// <para>Create a new child node. The node is owned by this one.</para>
+		/// </summary>
+		/// <returns>{scene_node&amp;} The new child.</returns>
+		scene_node& create_child();
+
+		/// <summary>
+		/// <para>Destroy a child node (and all its children).</para>
+		/// </summary>
+		/// <param name="{scene_node&amp;}">A direct child of this node.</param>
+		/// <returns>{bool} True if found and removed.</returns>
+		bool remove_child(const scene_node&);
+
+		/// <summary>
+		/// <para>How many direct children are there?</para>
+		/// </summary>
+		/// <returns>{size_t} Amount of direct children.</returns>
+		size_t children_size() const;
+
+		/// <summary>
+		/// <para>Get a direct child by index.</para>
+		/// </summary>
+		/// <param name="{size_t}">Index.</param>
+		/// <returns>{scene_node*} The child or null if out of range.</returns>
+		scene_node* child_index(const size_t) const;
+
+		/// <summary>
+		/// <para>The parent of this node.</para>
+		/// </summary>
+		/// <returns>{scene_node*} Parent, or null if this is a root.</returns>
+		scene_node* get_parent() const;
+
+		/// <summary>
+		/// <para>Attach a sprite (or block, text...) to this node.</para>
+		/// </summary>
+		/// <param name="{sprite&amp;}">Sprite reference (must exist while attached).</param>
+		void attach(sprite&);
+
+		/// <summary>
+		/// <para>Attach a vertexes to this node.</para>
+		/// </summary>
+		/// <param name="{vertexes&amp;}">Vertexes reference (must exist while attached).</param>
+		void attach(vertexes&);
+
+		/// <summary>
+		/// <para>Detach a sprite from this node.</para>
+		/// <para>Its collisionables are removed from their managers (when called from a collision callback, after that think_all ends).</para>
+		/// </summary>
+		/// <param name="{sprite&amp;}">Sprite reference.</param>
+		/// <returns>{bool} True if found.</returns>
+		bool detach(const sprite&);
+
+		/// <summary>
+		/// <para>Detach a vertexes from this node.</para>
+		/// <para>Its collisionables are removed from their managers (when called from a collision callback, after that think_all ends).</para>
+		/// </summary>
+		/// <param name="{vertexes&amp;}">Vertexes reference.</param>
+		/// <returns>{bool} True if found.</returns>
+		bool detach(const vertexes&);
+
+		/// <summary>
+		/// <para>Remove all attached objects from this node (children are kept).</para>
+		/// </summary>
+		void detach_all();
+
+		/// <summary>
+		/// <para>Push every attached sprite and vertexes of this node and its children into a collisionable_manager.</para>
+		/// <para>The created collisionables follow the node world transform and visibility (DISABLED while hidden).</para>
+		/// <para>Objects already registered on that manager are skipped. Detaching (or destroying the node) removes them from the manager.</para>
+		/// </summary>
+		/// <param name="{collisionable_manager&amp;}">The manager (must exist while this node exists).</param>
+		void register_collisions(collisionable_manager&);
+
+		/// <summary>
+		/// <para>Remove from a collisionable_manager everything this node and its children registered there.</para>
+		/// </summary>
+		/// <param name="{collisionable_manager&amp;}">The manager.</param>
+		void unregister_collisions(collisionable_manager&);
+
+		/// <summary>
+		/// <para>Set local position (relative to parent).</para>
+		/// </summary>
+		/// <param name="{float}">Position X.</param>
+		/// <param name="{float}">Position Y.</param>
+		void set_position(const float, const float);
+
+		/// <summary>
+		/// <para>Set local rotation (relative to parent).</para>
+		/// </summary>
+		/// <param name="{float}">Angle (rad).</param>
+		void set_rotation(const float);
+
+		/// <summary>
+		/// <para>Set local scale (relative to parent).</para>
+		/// </summary>
+		/// <param name="{float}">Scale X.</param>
+		/// <param name="{float}">Scale Y.</param>
+		void set_scale(const float, const float);
+
+		/// <summary>
+		/// <para>Move local position by some offset.</para>
+		/// </summary>
+		/// <param name="{float}">Offset X.</param>
+		/// <param name="{float}">Offset Y.</param>
+		void translate(const float, const float);
+
+		/// <summary>
+		/// <para>Local position X.</para>
+		/// </summary>
+		/// <returns>{float} Position X.</returns>
+		float get_position_x() const;
+
+		/// <summary>
+		/// <para>Local position Y.</para>
+		/// </summary>
+		/// <returns>{float} Position Y.</returns>
+		float get_position_y() const;
+
+		/// <summary>
+		/// <para>Local rotation.</para>
+		/// </summary>
+		/// <returns>{float} Angle (rad).</returns>
+		float get_rotation() const;
+
+		/// <summary>
+		/// <para>Local scale X.</para>
+		/// </summary>
+		/// <returns>{float} Scale X.</returns>
+		float get_scale_x() const;
+
+		/// <summary>
+		/// <para>Local scale Y.</para>
+		/// </summary>
+		/// <returns>{float} Scale Y.</returns>
+		float get_scale_y() const;
+
+		/// <summary>
+		/// <para>Show or hide this node (and everything below it).</para>
+		/// </summary>
+		/// <param name="{bool}">Visible?</param>
+		void set_visible(const bool);
+
+		/// <summary>
+		/// <para>Is this node set as visible? (this does not check parents)</para>
+		/// </summary>
+		/// <returns>{bool} True if set visible.</returns>
+		bool is_visible() const;
+
+		/// <summary>
+		/// <para>Is this node visible considering its parents? Updated on update().</para>
+		/// </summary>
+		/// <returns>{bool} True if this and all parents are visible.</returns>
+		bool is_visible_in_tree() const;
+
+		/// <summary>
+		/// <para>Rebuild world transforms and visibility of dirty subtrees only.</para>
+		/// <para>draw() does this automatically. Call it yourself if you need world data on another thread first.</para>
+		/// <para>NOTE: Call this from the root node.</para>
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// <para>Update and draw this node and all visible children using current transform as camera.</para>
+		/// <para>NOTE: Call this from the root node in the drawing thread.</para>
+		/// </summary>
+		void draw();
+
+		/// <summary>
+		/// <para>Get the latest world transform (without camera) of this node.</para>
+		/// </summary>
+		/// <returns>{transform} World transform.</returns>
+		transform copy_world_transform() const;
+
+		/// <summary>
+		/// <para>Transform local coordinates of this node into world coordinates (without camera).</para>
+		/// </summary>
+		/// <param name="{float}">Coordinate X.</param>
+		/// <param name="{float}">Coordinate Y.</param>
+		void local_to_world(float&, float&) const;
+
+		/// <summary>
+		/// <para>Transform world coordinates (without camera) into this node's local coordinates.</para>
+		/// </summary>
+		/// <param name="{float}">Coordinate X.</param>
+		/// <param name="{float}">Coordinate Y.</param>
+		void world_to_local(float&, float&) const;
+	};
+
+}
\ No newline at end of file
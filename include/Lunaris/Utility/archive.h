@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "archive/archive.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "archive/archive.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,514 @@
+#include "archive.h"
+
+namespace Lunaris {
+
+	namespace __archive {
+
+		inline uint32_t read32(const unsigned char* p)
+		{
+			uint32_t v;
+			memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint32_t hash4(const unsigned char* p)
+		{
+			return (read32(p) * 2654435761u) >> (32 - 16);
+		}
+
+		inline void put_len(unsigned char*& op, size_t len)
+		{
+			while (len >= 255) {
+				*op++ = 255;
+				len -= 255;
+			}
+			*op++ = static_cast<unsigned char>(len);
+		}
+
+		inline void put_u32(char* p, const uint32_t v)
+		{
+			for (size_t k = 0; k < 4; ++k) p[k] = static_cast<char>((v >> (8 * k)) & 0xFF);
+		}
+
+		inline void put_u64(char* p, const uint64_t v)
+		{
+			for (size_t k = 0; k < 8; ++k) p[k] = static_cast<char>((v >> (8 * k)) & 0xFF);
+		}
+
+		inline uint32_t get_u32(const char* p)
+		{
+			uint32_t v = 0;
+			for (size_t k = 0; k < 4; ++k) v |= static_cast<uint32_t>(static_cast<unsigned char>(p[k])) << (8 * k);
+			return v;
+		}
+
+		inline uint64_t get_u64(const char* p)
+		{
+			uint64_t v = 0;
+			for (size_t k = 0; k < 8; ++k) v |= static_cast<uint64_t>(static_cast<unsigned char>(p[k])) << (8 * k);
+			return v;
+		}
+	}
+
+	LUNARIS_DECL size_t archive_lz4_bound(const size_t len)
+	{
+		return len + len / 255 + 16;
+	}
+
+	LUNARIS_DECL size_t archive_lz4_compress(const char* src, const size_t len, char* dst)
+	{
+		constexpr size_t min_match = 4;
+		constexpr size_t last_literals = 5;	// block always ends with literals
+		constexpr size_t match_limit = 12;	// last match starts before this
+
+		const unsigned char* const base = reinterpret_cast<const unsigned char*>(src);
+		const unsigned char* const end = base + len;
+		const unsigned char* ip = base;
+		const unsigned char* anchor = base;
+		unsigned char* op = reinterpret_cast<unsigned char*>(dst);
+
+		const auto emit = [&](const unsigned char* lit, const size_t lit_len, const size_t off, const size_t match_len) {
+			unsigned char* token = op++;
+			*token = static_cast<unsigned char>((lit_len >= 15 ? 15 : lit_len) << 4);
+			if (lit_len >= 15) __archive::put_len(op, lit_len - 15);
+			memcpy(op, lit, lit_len);
+			op += lit_len;
+			if (match_len == 0) return; // last literals
+			*op++ = static_cast<unsigned char>(off & 0xFF);
+			*op++ = static_cast<unsigned char>(off >> 8);
+			const size_t ml = match_len - min_match;
+			*token |= static_cast<unsigned char>(ml >= 15 ? 15 : ml);
+			if (ml >= 15) __archive::put_len(op, ml - 15);
+		};
+
+		if (len > match_limit) {
+			std::vector<uint32_t> table(1 << 16, 0); // position + 1 (0 = none)
+			const unsigned char* const mflimit = end - match_limit;
+			const unsigned char* const matchlimit = end - last_literals;
+
+			while (ip < mflimit) {
+				const uint32_t h = __archive::hash4(ip);
+				const uint32_t prev = table[h];
+				table[h] = static_cast<uint32_t>(ip - base) + 1;
+
+				if (prev != 0) {
+					const unsigned char* ref = base + (prev - 1);
+					if (static_cast<size_t>(ip - ref) <= 65535 && __archive::read32(ref) == __archive::read32(ip)) {
+						size_t ml = min_match;
+						while (ip + ml < matchlimit && ref[ml] == ip[ml]) ++ml;
+
+						emit(anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - ref), ml);
+						ip += ml;
+						anchor = ip;
+						if (ip < mflimit) table[__archive::hash4(ip - 2)] = static_cast<uint32_t>(ip - 2 - base) + 1;
+						continue;
+					}
+				}
+				++ip;
+			}
+		}
+
+		emit(anchor, static_cast<size_t>(end - anchor), 0, 0);
+		return static_cast<size_t>(op - reinterpret_cast<unsigned char*>(dst));
+	}
+
+	LUNARIS_DECL bool archive_lz4_decompress(const char* src, const size_t len, char* dst, const size_t dst_len)
+	{
+		const unsigned char* ip = reinterpret_cast<const unsigned char*>(src);
+		const unsigned char* const iend = ip + len;
+		unsigned char* const obase = reinterpret_cast<unsigned char*>(dst);
+		unsigned char* op = obase;
+		unsigned char* const oend = obase + dst_len;
+
+		const auto get_len = [&](size_t& v) {
+			unsigned char b;
+			do {
+				if (ip >= iend) return false;
+				b = *ip++;
+				v += b;
+			} while (b == 255);
+			return true;
+		};
+
+		while (ip < iend) {
+			const unsigned char token = *ip++;
+
+			size_t lit = token >> 4;
+			if (lit == 15 && !get_len(lit)) return false;
+			if (lit > static_cast<size_t>(iend - ip) || lit > static_cast<size_t>(oend - op)) return false;
+			memcpy(op, ip, lit);
+			op += lit;
+			ip += lit;
+
+			if (ip == iend) break; // last literals
+
+			if (iend - ip < 2) return false;
+			const size_t off = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+			ip += 2;
+			if (off == 0 || off > static_cast<size_t>(op - obase)) return false;
+
+			size_t ml = token & 15;
+			if (ml == 15 && !get_len(ml)) return false;
+			ml += 4;
+			if (ml > static_cast<size_t>(oend - op)) return false;
+
+			const unsigned char* ref = op - off;
+			if (off >= ml) memcpy(op, ref, ml);
+			else for (size_t k = 0; k < ml; ++k) op[k] = ref[k]; // overlapping (repeats)
+			op += ml;
+		}
+
+		return op == oend;
+	}
+
+	LUNARIS_DECL archive_file::~archive_file()
+	{
+		close();
+	}
+
+	LUNARIS_DECL bool archive_file::open(std::shared_ptr<const void> keep, const char* ptr, const size_t len, const std::string& name)
+	{
+		__file_allegro_start();
+		close();
+		if (!ptr || len == 0) return false;
+
+		this->fp = std::unique_ptr<ALLEGRO_FILE, bool(*)(ALLEGRO_FILE*)>(al_open_memfile(const_cast<char*>(ptr), static_cast<int64_t>(len), "r"), al_fclose);
+		if (!this->fp) return false;
+
+		m_keep = std::move(keep);
+		this->path = name;
+		return true;
+	}
+
+	LUNARIS_DECL bool archive_file::open(std::unique_ptr<char[]>&& mem, const size_t len, const std::string& name)
+	{
+		__file_allegro_start();
+		close();
+		if (!mem || len == 0) return false;
+
+		this->fp = std::unique_ptr<ALLEGRO_FILE, bool(*)(ALLEGRO_FILE*)>(al_open_memfile(mem.get(), static_cast<int64_t>(len), "r"), al_fclose);
+		if (!this->fp) return false;
+
+		m_own = std::move(mem);
+		this->path = name;
+		return true;
+	}
+
+	LUNARIS_DECL void archive_file::close()
+	{
+		this->file::close(); // ALLEGRO_FILE first, it points to the memory
+		m_keep.reset();
+		m_own.reset();
+	}
+
+	LUNARIS_DECL const archive_entry* archive::_find(const std::string_view name) const
+	{
+		const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), name, [](const archive_entry& e, const std::string_view n) { return std::string_view(e.name) < n; });
+		if (it == m_entries.end() || it->name != name) return nullptr;
+		return &(*it);
+	}
+
+	LUNARIS_DECL bool archive::_check(const archive_entry& e, const char* data, const bool force) const
+	{
+		if (!m_verify && !force) return true;
+
+		const size_t idx = static_cast<size_t>(&e - m_entries.data());
+		if (!force && m_checked[idx]) return true;
+
+		sha256_hasher ctx;
+		ctx.update(reinterpret_cast<const unsigned char*>(data), static_cast<size_t>(e.size));
+		const bool good = ctx.final_bytes() == e.sha256;
+		if (good) m_checked[idx] = true;
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		if (!good) PRINT_DEBUG("Archive %p entry '%s' failed SHA256 check", this, e.name.c_str());
+#endif
+		return good;
+	}
+
+	LUNARIS_DECL const char* archive::_stored(const archive_entry& e) const
+	{
+		return m_map->data() + e.offset;
+	}
+
+	LUNARIS_DECL bool archive::open(const std::string& pth)
+	{
+		close();
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Opening archive %p <- '%s'", this, pth.c_str());
+#endif
+
+		auto map = std::make_shared<mmapfile>();
+		if (!map->open(pth)) return false;
+
+		const std::string_view all = map->view();
+		if (all.size() < archive_header_size || memcmp(all.data(), archive_magic, sizeof(archive_magic)) != 0) return false;
+
+		const char* head = all.data();
+		if (__archive::get_u32(head + 4) != archive_version) return false;
+		const uint64_t count = __archive::get_u32(head + 12);
+		const uint64_t index_off = __archive::get_u64(head + 16);
+		const uint64_t index_len = __archive::get_u64(head + 24);
+		if (index_off < archive_header_size || index_off > all.size() || index_len > all.size() - index_off) return false;
+
+		const std::string_view index = all.substr(static_cast<size_t>(index_off), static_cast<size_t>(index_len));
+		sha256_hasher ctx;
+		ctx.update(index);
+		const auto index_hash = ctx.final_bytes();
+		if (memcmp(index_hash.data(), head + 32, index_hash.size()) != 0) return false;
+
+		std::vector<archive_entry> entries;
+		if (!deserialize(index, entries) || entries.size() != count) return false;
+
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const auto& e = entries[i];
+			if (i > 0 && !(entries[i - 1].name < e.name)) return false; // must be sorted, no duplicates
+			if (e.offset < archive_header_size || e.offset > all.size() || e.stored_size > all.size() - e.offset) return false;
+			if (e.method == archive_method_e::STORE && e.stored_size != e.size) return false;
+			if (e.method != archive_method_e::STORE && e.method != archive_method_e::LZ4) return false;
+		}
+
+		m_map = std::move(map);
+		m_entries = std::move(entries);
+		m_checked = std::unique_ptr<std::atomic<bool>[]>(new std::atomic<bool>[m_entries.size()]());
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Opened archive %p <- '%s' [%zu entries]", this, pth.c_str(), m_entries.size());
+#endif
+
+		return true;
+	}
+
+	LUNARIS_DECL void archive::close()
+	{
+		m_map.reset(); // files from it keep their own reference
+		m_entries.clear();
+		m_checked.reset();
+	}
+
+	LUNARIS_DECL bool archive::is_open() const
+	{
+		return m_map != nullptr;
+	}
+
+	LUNARIS_DECL void archive::set_verify(const bool b)
+	{
+		m_verify = b;
+	}
+
+	LUNARIS_DECL bool archive::has(const std::string_view name) const
+	{
+		return _find(name) != nullptr;
+	}
+
+	LUNARIS_DECL const archive_entry* archive::info(const std::string_view name) const
+	{
+		return _find(name);
+	}
+
+	LUNARIS_DECL const std::vector<archive_entry>& archive::entries() const
+	{
+		return m_entries;
+	}
+
+	LUNARIS_DECL bool archive::read(const std::string_view name, std::vector<char>& out) const
+	{
+		const archive_entry* e = _find(name);
+		if (!e) return false;
+
+		out.resize(static_cast<size_t>(e->size));
+		if (e->size == 0) return _check(*e, out.data());
+
+		if (e->method == archive_method_e::STORE) memcpy(out.data(), _stored(*e), out.size());
+		else if (!archive_lz4_decompress(_stored(*e), static_cast<size_t>(e->stored_size), out.data(), out.size())) {
+			out.clear();
+			return false;
+		}
+
+		if (!_check(*e, out.data())) {
+			out.clear();
+			return false;
+		}
+		return true;
+	}
+
+	LUNARIS_DECL std::string_view archive::view(const std::string_view name) const
+	{
+		const archive_entry* e = _find(name);
+		if (!e || e->method != archive_method_e::STORE || !_check(*e, _stored(*e))) return {};
+		return std::string_view(_stored(*e), static_cast<size_t>(e->size));
+	}
+
+	LUNARIS_DECL bool archive::get_file(const std::string_view name, hybrid_memory<file>& out) const
+	{
+		const archive_entry* e = _find(name);
+		if (!e) return false;
+		if (e->size == 0) { // nothing to open (memfiles can't be empty), but it is there
+			if (!_check(*e, _stored(*e))) return false;
+			out.reset_this();
+			return true;
+		}
+
+		hybrid_memory<file> res = make_hybrid_derived<file, archive_file>();
+		archive_file* fp = static_cast<archive_file*>(res.get());
+
+		if (e->method == archive_method_e::STORE) {
+			if (!_check(*e, _stored(*e)) || !fp->open(m_map, _stored(*e), static_cast<size_t>(e->size), e->name)) return false;
+		}
+		else {
+			std::unique_ptr<char[]> mem(new char[static_cast<size_t>(e->size)]);
+			if (!archive_lz4_decompress(_stored(*e), static_cast<size_t>(e->stored_size), mem.get(), static_cast<size_t>(e->size)) || !_check(*e, mem.get())) return false;
+			if (!fp->open(std::move(mem), static_cast<size_t>(e->size), e->name)) return false;
+		}
+
+		out = std::move(res);
+		return true;
+	}
+
+	LUNARIS_DECL hybrid_memory<file> archive::get_file(const std::string_view name) const
+	{
+		hybrid_memory<file> res;
+		get_file(name, res);
+		return res;
+	}
+
+	LUNARIS_DECL bool archive::verify_all() const
+	{
+		std::vector<char> buf;
+		for (const auto& e : m_entries) {
+			if (e.method == archive_method_e::STORE) {
+				if (!_check(e, _stored(e), true)) return false;
+				continue;
+			}
+			buf.resize(static_cast<size_t>(e.size));
+			if (!archive_lz4_decompress(_stored(e), static_cast<size_t>(e.stored_size), buf.data(), buf.size()) || !_check(e, buf.data(), true)) return false;
+		}
+		return true;
+	}
+
+	LUNARIS_DECL void archive_writer::add(const std::string_view name, const std::string_view data, const bool compress)
+	{
+		auto& it = m_items[std::string(name)];
+		it.data.assign(data.begin(), data.end());
+		it.compress = compress;
+	}
+
+	LUNARIS_DECL bool archive_writer::add_file(const std::string_view name, const std::string& pth, const bool compress)
+	{
+		std::ifstream fp(pth, std::ios::binary | std::ios::ate);
+		if (!fp.is_open()) return false;
+
+		std::vector<char> data(static_cast<size_t>(fp.tellg()));
+		fp.seekg(0);
+		if (!data.empty() && !fp.read(data.data(), static_cast<std::streamsize>(data.size()))) return false;
+
+		auto& it = m_items[std::string(name)];
+		it.data = std::move(data);
+		it.compress = compress;
+		return true;
+	}
+
+	LUNARIS_DECL bool archive_writer::remove(const std::string_view name)
+	{
+		const auto it = m_items.find(name);
+		if (it == m_items.end()) return false;
+		m_items.erase(it);
+		return true;
+	}
+
+	LUNARIS_DECL size_t archive_writer::size() const
+	{
+		return m_items.size();
+	}
+
+	LUNARIS_DECL void archive_writer::clear()
+	{
+		m_items.clear();
+	}
+
+	LUNARIS_DECL bool archive_writer::save(const std::string& pth, const size_t alignment) const
+	{
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0 || m_items.size() > 0xFFFFFFFFull) return false;
+
+		const std::string tmp = pth + ".tmp";
+		std::ofstream fp(tmp, std::ios::binary | std::ios::trunc);
+		if (!fp.is_open()) return false;
+
+		const std::vector<char> zeros(alignment > archive_header_size ? alignment : archive_header_size, 0);
+		fp.write(zeros.data(), archive_header_size); // filled at the end
+		uint64_t pos = archive_header_size;
+
+		std::vector<archive_entry> entries;
+		entries.reserve(m_items.size());
+		std::vector<char> packed;
+
+		for (const auto& [name, it] : m_items) {
+			archive_entry e;
+			e.name = name;
+			e.size = it.data.size();
+
+			sha256_hasher ctx;
+			ctx.update(it.data);
+			e.sha256 = ctx.final_bytes();
+
+			const char* out = it.data.data();
+			size_t out_len = it.data.size();
+
+			if (it.compress && !it.data.empty()) {
+				packed.resize(archive_lz4_bound(it.data.size()));
+				const size_t len = archive_lz4_compress(it.data.data(), it.data.size(), packed.data());
+				if (len <= it.data.size() - it.data.size() / 10) { // worth it
+					e.method = archive_method_e::LZ4;
+					out = packed.data();
+					out_len = len;
+				}
+			}
+
+			const size_t pad = static_cast<size_t>((alignment - (pos % alignment)) % alignment);
+			fp.write(zeros.data(), static_cast<std::streamsize>(pad));
+			pos += pad;
+
+			e.offset = pos;
+			e.stored_size = out_len;
+			fp.write(out, static_cast<std::streamsize>(out_len));
+			pos += out_len;
+
+			entries.push_back(std::move(e));
+		}
+
+		const std::vector<char> index = serialize(entries);
+		fp.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+		char head[archive_header_size]{};
+		memcpy(head, archive_magic, sizeof(archive_magic));
+		__archive::put_u32(head + 4, archive_version);
+		__archive::put_u32(head + 8, static_cast<uint32_t>(alignment));
+		__archive::put_u32(head + 12, static_cast<uint32_t>(entries.size()));
+		__archive::put_u64(head + 16, pos);
+		__archive::put_u64(head + 24, index.size());
+		sha256_hasher ctx;
+		ctx.update(index);
+		const auto index_hash = ctx.final_bytes();
+		memcpy(head + 32, index_hash.data(), index_hash.size());
+
+		fp.seekp(0);
+		fp.write(head, sizeof(head));
+		fp.close();
+
+		if (!fp) {
+			std::error_code err;
+			std::filesystem::remove(tmp, err);
+			return false;
+		}
+
+		std::error_code err;
+		std::filesystem::rename(tmp, pth, err);
+		if (err) {
+			std::filesystem::remove(tmp, err);
+			return false;
+		}
+		return true;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/memory.h>
+#include <Lunaris/Utility/hash.h>
+#include <Lunaris/Utility/serialize.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+namespace Lunaris {
+
+	constexpr char archive_magic[4] = { 'L', 'P', 'A', 'K' };
+	constexpr uint32_t archive_version = 1;
+	constexpr size_t archive_header_size = 64;
+	constexpr size_t archive_default_alignment = 64; // every entry starts at a multiple of this (from the start of the file)
+
+	enum class archive_method_e : uint8_t {
+		STORE,	// as is (can be used straight from the mapping)
+		LZ4		// LZ4 block
+	};
+
+	/// <summary>
+	/// <para>Directory entry of an archive.</para>
+	/// </summary>
+	struct archive_entry {
+		std::string name;
+		uint64_t offset = 0;		// from the start of the archive
+		uint64_t stored_size = 0;	// size in the archive
+		uint64_t size = 0;			// original size
+		archive_method_e method = archive_method_e::STORE;
+		std::array<unsigned char, _SHA256::DIGEST_SIZE> sha256{}; // of the original data
+
+		LUNARIS_SERIALIZE(name, offset, stored_size, size, method, sha256)
+	};
+
+	/// <summary>
+	/// <para>Worst case size of LZ4 compressed data.</para>
+	/// </summary>
+	/// <param name="{size_t}">Original size.</param>
+	/// <returns>{size_t} Max compressed size.</returns>
+	size_t archive_lz4_bound(const size_t);
+
+	/// <summary>
+	/// <para>Compress with LZ4 (block format, fast greedy matching).</para>
+	/// </summary>
+	/// <param name="{char*}">Source.</param>
+	/// <param name="{size_t}">Source size.</param>
+	/// <param name="{char*}">Destination, at least archive_lz4_bound(size) bytes.</param>
+	/// <returns>{size_t} Compressed size.</returns>
+	size_t archive_lz4_compress(const char*, const size_t, char*);
+
+	/// <summary>
+	/// <para>Decompress LZ4 block (safe against bad input).</para>
+	/// </summary>
+	/// <param name="{char*}">Source.</param>
+	/// <param name="{size_t}">Source size.</param>
+	/// <param name="{char*}">Destination.</param>
+	/// <param name="{size_t}">Exact original size.</param>
+	/// <returns>{bool} True if the data was valid and filled the destination.</returns>
+	bool archive_lz4_decompress(const char*, const size_t, char*, const size_t);
+
+	/// <summary>
+	/// <para>A file from an archive. Either a read only view on the archive mapping (stored entries) or its own decompressed memory.</para>
+	/// <para>The path is the entry name (font and others use its extension).</para>
+	/// </summary>
+	class archive_file : public file {
+		std::shared_ptr<const void> m_keep; // keeps the archive mapping alive
+		std::unique_ptr<char[]> m_own;
+	public:
+		archive_file() = default;
+		~archive_file();
+
+		/// <summary>
+		/// <para>Read only view on memory owned by someone else.</para>
+		/// </summary>
+		/// <param name="{std::shared_ptr}">Owner (kept while this is open).</param>
+		/// <param name="{char*}">Data.</param>
+		/// <param name="{size_t}">Size.</param>
+		/// <param name="{std::string}">Name (path).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool open(std::shared_ptr<const void>, const char*, const size_t, const std::string&);
+
+		/// <summary>
+		/// <para>Read only file on its own memory.</para>
+		/// </summary>
+		/// <param name="{std::unique_ptr&lt;char[]&gt;}">Data (moved).</param>
+		/// <param name="{size_t}">Size.</param>
+		/// <param name="{std::string}">Name (path).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool open(std::unique_ptr<char[]>&&, const size_t, const std::string&);
+
+		/// <summary>
+		/// <para>Close and release memory.</para>
+		/// </summary>
+		void close();
+
+		using file::get_path;
+		using file::get_fp;
+		using file::operator ALLEGRO_FILE*;
+		using file::read;
+		using file::tell;
+		using file::seek;
+		using file::size;
+		using file::is_open;
+		using file::valid;
+		using file::empty;
+	};
+
+	/// <summary>
+	/// <para>archive reads a packed asset file: one mapped file, a sorted directory and entries stored as is or LZ4, each checked by SHA256.</para>
+	/// <para>Opening an entry is a binary search on the directory, no disk access (the system pages data in as it is read).</para>
+	/// <para>Use get_file for anything that loads from hybrid_memory&lt;file&gt; (texture, font, sample, config...).</para>
+	/// </summary>
+	class archive : public NonCopyable {
+		std::shared_ptr<mmapfile> m_map;
+		std::vector<archive_entry> m_entries; // sorted by name
+		std::unique_ptr<std::atomic<bool>[]> m_checked; // entries already verified
+		bool m_verify = true;
+
+		const archive_entry* _find(const std::string_view) const;
+		bool _check(const archive_entry&, const char*, const bool = false) const; // data against sha256 (once, unless forced)
+		const char* _stored(const archive_entry&) const;
+	public:
+		archive() = default;
+
+		/// <summary>
+		/// <para>Open an archive. The directory is checked (SHA256) right away.</para>
+		/// </summary>
+		/// <param name="{std::string}">Path.</param>
+		/// <returns>{bool} True if it is a valid archive.</returns>
+		bool open(const std::string&);
+
+		/// <summary>
+		/// <para>Close the archive. Files got from it are still valid.</para>
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// <para>Is there an archive open?</para>
+		/// </summary>
+		/// <returns>{bool} True if open.</returns>
+		bool is_open() const;
+
+		/// <summary>
+		/// <para>Check entries against their SHA256 the first time they are read (default: true).</para>
+		/// </summary>
+		/// <param name="{bool}">Verify?</param>
+		void set_verify(const bool);
+
+		/// <summary>
+		/// <para>Is there an entry with this name?</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <returns>{bool} True if found.</returns>
+		bool has(const std::string_view) const;
+
+		/// <summary>
+		/// <para>Info of an entry.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <returns>{archive_entry*} The entry, or null if not found.</returns>
+		const archive_entry* info(const std::string_view) const;
+
+		/// <summary>
+		/// <para>All entries (sorted by name).</para>
+		/// </summary>
+		/// <returns>{std::vector&lt;archive_entry&gt;} Entries.</returns>
+		const std::vector<archive_entry>& entries() const;
+
+		/// <summary>
+		/// <para>Read an entry into a buffer (decompressed).</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <param name="{std::vector&lt;char&gt;}">Buffer (replaced).</param>
+		/// <returns>{bool} True if found and valid.</returns>
+		bool read(const std::string_view, std::vector<char>&) const;
+
+		/// <summary>
+		/// <para>Direct view of a STORE entry on the mapping (no copy). Valid while the archive is open.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <returns>{std::string_view} The data (empty if not found, not valid or compressed).</returns>
+		std::string_view view(const std::string_view) const;
+
+		/// <summary>
+		/// <para>Entry as a file, ready for texture, font, sample, config and so on.</para>
+		/// <para>STORE entries read directly from the mapping, LZ4 entries are decompressed once into the file.</para>
+		/// <para>A zero size entry has no data to open: it returns true and leaves the file empty.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <param name="{hybrid_memory&lt;file&gt;}">The file (set only if found, valid and not empty).</param>
+		/// <returns>{bool} True if the entry exists and is valid (even if it is empty).</returns>
+		bool get_file(const std::string_view, hybrid_memory<file>&) const;
+
+		/// <summary>
+		/// <para>Entry as a file, ready for texture, font, sample, config and so on.</para>
+		/// <para>Shortcut of the one above. It can't tell a zero size entry from a missing one (use that or has() for that).</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <returns>{hybrid_memory&lt;file&gt;} The file (empty if not found, empty or not valid).</returns>
+		hybrid_memory<file> get_file(const std::string_view) const;
+
+		/// <summary>
+		/// <para>Check all entries now.</para>
+		/// </summary>
+		/// <returns>{bool} True if all of them are good.</returns>
+		bool verify_all() const;
+	};
+
+	/// <summary>
+	/// <para>archive_writer builds an archive file from memory or files.</para>
+	/// </summary>
+	class archive_writer {
+		struct item {
+			std::vector<char> data;
+			bool compress = true;
+		};
+		std::map<std::string, item, std::less<>> m_items; // sorted, like the directory
+	public:
+		/// <summary>
+		/// <para>Add (or replace) an entry from memory.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <param name="{std::string_view}">Data.</param>
+		/// <param name="{bool}">Try LZ4 (kept only if it saves 10% or more)?</param>
+		void add(const std::string_view, const std::string_view, const bool = true);
+
+		/// <summary>
+		/// <para>Add (or replace) an entry from a file.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <param name="{std::string}">Path of the file.</param>
+		/// <param name="{bool}">Try LZ4 (kept only if it saves 10% or more)?</param>
+		/// <returns>{bool} True if the file was read.</returns>
+		bool add_file(const std::string_view, const std::string&, const bool = true);
+
+		/// <summary>
+		/// <para>Remove an entry.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Name.</param>
+		/// <returns>{bool} True if it existed.</returns>
+		bool remove(const std::string_view);
+
+		/// <summary>
+		/// <para>Amount of entries.</para>
+		/// </summary>
+		/// <returns>{size_t} Entries.</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// <para>Remove all entries.</para>
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		/// <para>Write the archive (temporary file first, then replaces the destination).</para>
+		/// </summary>
+		/// <param name="{std::string}">Path.</param>
+		/// <param name="{size_t}">Alignment of entries (power of 2).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool save(const std::string&, const size_t = archive_default_alignment) const;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "async_io/async_io.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "async_io/async_io.cpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,590 @@
+#include "async_io.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL async_file::async_file(async_file&& oth) noexcept
+		: m_handle(oth.m_handle), m_path(std::move(oth.m_path))
+	{
+#ifdef _WIN32
+		oth.m_handle = INVALID_HANDLE_VALUE;
+#else
+		oth.m_handle = -1;
+#endif
+	}
+
+	LUNARIS_DECL void async_file::operator=(async_file&& oth) noexcept
+	{
+		close();
+		m_handle = oth.m_handle;
+		m_path = std::move(oth.m_path);
+#ifdef _WIN32
+		oth.m_handle = INVALID_HANDLE_VALUE;
+#else
+		oth.m_handle = -1;
+#endif
+	}
+
+	LUNARIS_DECL async_file::~async_file()
+	{
+		close();
+	}
+
+	LUNARIS_DECL bool async_file::open(const std::string& pth, const file::open_mode_e& mode)
+	{
+		close();
+
+#ifdef _WIN32
+		DWORD access = 0, creation = 0;
+		switch (mode) {
+		case file::open_mode_e::READ_TRY:
+			access = GENERIC_READ;
+			creation = OPEN_EXISTING;
+			break;
+		case file::open_mode_e::WRITE_REPLACE:
+			access = GENERIC_WRITE;
+			creation = CREATE_ALWAYS;
+			break;
+		case file::open_mode_e::READWRITE_REPLACE:
+			access = GENERIC_READ | GENERIC_WRITE;
+			creation = CREATE_ALWAYS;
+			break;
+		case file::open_mode_e::READWRITE_KEEP:
+			access = GENERIC_READ | GENERIC_WRITE;
+			creation = OPEN_ALWAYS;
+			break;
+		}
+		m_handle = CreateFileA(pth.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_handle == INVALID_HANDLE_VALUE) return false;
+#else
+		int flags = O_CLOEXEC;
+		switch (mode) {
+		case file::open_mode_e::READ_TRY:
+			flags |= O_RDONLY;
+			break;
+		case file::open_mode_e::WRITE_REPLACE:
+			flags |= O_WRONLY | O_CREAT | O_TRUNC;
+			break;
+		case file::open_mode_e::READWRITE_REPLACE:
+			flags |= O_RDWR | O_CREAT | O_TRUNC;
+			break;
+		case file::open_mode_e::READWRITE_KEEP:
+			flags |= O_RDWR | O_CREAT;
+			break;
+		}
+		m_handle = ::open(pth.c_str(), flags, 0644);
+		if (m_handle < 0) return false;
+#endif
+
+		m_path = pth;
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Opened async_file %p <- '%s'", this, pth.c_str());
+#endif
+		return true;
+	}
+
+	LUNARIS_DECL bool async_file::open(file& oth)
+	{
+		close();
+		if (!oth.is_open() || oth.get_path().empty()) return false;
+		oth.flush();
+
+		const std::string pth = oth.get_path();
+#ifdef _WIN32
+		m_handle = CreateFileA(pth.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_handle == INVALID_HANDLE_VALUE) m_handle = CreateFileA(pth.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_handle == INVALID_HANDLE_VALUE) return false;
+#else
+		m_handle = ::open(pth.c_str(), O_RDWR | O_CLOEXEC);
+		if (m_handle < 0) m_handle = ::open(pth.c_str(), O_RDONLY | O_CLOEXEC);
+		if (m_handle < 0) return false;
+#endif
+		m_path = pth;
+		return true;
+	}
+
+	LUNARIS_DECL void async_file::close()
+	{
+#ifdef _WIN32
+		if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+		m_handle = INVALID_HANDLE_VALUE;
+#else
+		if (m_handle >= 0) ::close(m_handle);
+		m_handle = -1;
+#endif
+		m_path.clear();
+	}
+
+	LUNARIS_DECL const std::string& async_file::get_path() const
+	{
+		return m_path;
+	}
+
+	LUNARIS_DECL async_file::native_handle async_file::get_handle() const
+	{
+		return m_handle;
+	}
+
+	LUNARIS_DECL uint64_t async_file::size() const
+	{
+		if (!is_open()) return 0;
+#ifdef _WIN32
+		LARGE_INTEGER len{};
+		if (!GetFileSizeEx(m_handle, &len) || len.QuadPart < 0) return 0;
+		return static_cast<uint64_t>(len.QuadPart);
+#else
+		struct stat st {};
+		if (fstat(m_handle, &st) != 0 || st.st_size < 0) return 0;
+		return static_cast<uint64_t>(st.st_size);
+#endif
+	}
+
+	LUNARIS_DECL bool async_file::is_open() const
+	{
+#ifdef _WIN32
+		return m_handle != INVALID_HANDLE_VALUE;
+#else
+		return m_handle >= 0;
+#endif
+	}
+
+	LUNARIS_DECL void async_io::_pool_work()
+	{
+		while (1) {
+			job* it = nullptr;
+			{
+				std::unique_lock<std::mutex> lock(m_queue_mtx);
+				m_queue_cond.wait(lock, [this] { return !m_queue.empty() || !m_run; });
+				if (m_queue.empty()) return; // stopped and nothing left
+				it = m_queue.front();
+				m_queue.pop_front();
+			}
+			_pool_do(it);
+		}
+	}
+
+	LUNARIS_DECL void async_io::_pool_do(job* it)
+	{
+		if (it->flush) {
+#ifdef _WIN32
+			_finish(it, FlushFileBuffers(it->handle) != 0);
+#else
+			_finish(it, fsync(it->handle) == 0);
+#endif
+			return;
+		}
+
+		while (it->done < it->size) {
+			const size_t left = it->size - it->done;
+#ifdef _WIN32
+			OVERLAPPED ov{};
+			const uint64_t off = it->offset + it->done;
+			ov.Offset = static_cast<DWORD>(off & 0xFFFFFFFF);
+			ov.OffsetHigh = static_cast<DWORD>(off >> 32);
+			const DWORD len = left > 0x40000000 ? 0x40000000 : static_cast<DWORD>(left);
+			DWORD got = 0;
+			const BOOL good = it->op == async_io_op_e::READ ?
+				ReadFile(it->handle, it->data + it->done, len, &got, &ov) :
+				WriteFile(it->handle, it->data + it->done, len, &got, &ov);
+			if (!good && GetLastError() != ERROR_HANDLE_EOF) it->err = EIO;
+			if (!good || got == 0) break;
+			it->done += got;
+#else
+			const ssize_t got = it->op == async_io_op_e::READ ?
+				pread(it->handle, it->data + it->done, left, static_cast<off_t>(it->offset + it->done)) :
+				pwrite(it->handle, it->data + it->done, left, static_cast<off_t>(it->offset + it->done));
+			if (got < 0 && errno == EINTR) continue;
+			if (got < 0) it->err = errno;
+			if (got <= 0) break; // error or end of file
+			it->done += static_cast<size_t>(got);
+#endif
+		}
+		_finish(it, it->err == 0);
+	}
+
+#ifdef LUNARIS_ASYNC_IO_URING
+	LUNARIS_DECL bool async_io::_uring_setup(const unsigned entries)
+	{
+		io_uring_params par{};
+		const long fd = syscall(__NR_io_uring_setup, entries, &par);
+		if (fd < 0) return false;
+		m_ring.fd = static_cast<int>(fd);
+
+		m_ring.sq_len = par.sq_off.array + par.sq_entries * sizeof(unsigned);
+		m_ring.cq_len = par.cq_off.cqes + par.cq_entries * sizeof(io_uring_cqe);
+		const bool single = (par.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (single) m_ring.sq_len = m_ring.cq_len = (m_ring.sq_len > m_ring.cq_len ? m_ring.sq_len : m_ring.cq_len);
+
+		m_ring.sq_ptr = mmap(nullptr, m_ring.sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring.fd, IORING_OFF_SQ_RING);
+		if (m_ring.sq_ptr == MAP_FAILED) {
+			m_ring.sq_ptr = nullptr;
+			_uring_free();
+			return false;
+		}
+		if (single) m_ring.cq_ptr = m_ring.sq_ptr;
+		else {
+			m_ring.cq_ptr = mmap(nullptr, m_ring.cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring.fd, IORING_OFF_CQ_RING);
+			if (m_ring.cq_ptr == MAP_FAILED) {
+				m_ring.cq_ptr = nullptr;
+				_uring_free();
+				return false;
+			}
+		}
+
+		m_ring.sqes_len = par.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = mmap(nullptr, m_ring.sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring.fd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED) {
+			_uring_free();
+			return false;
+		}
+		m_ring.sqes = static_cast<io_uring_sqe*>(sqes);
+
+		char* sq = static_cast<char*>(m_ring.sq_ptr);
+		char* cq = static_cast<char*>(m_ring.cq_ptr);
+		m_ring.sq_tail = reinterpret_cast<unsigned*>(sq + par.sq_off.tail);
+		m_ring.sq_mask = reinterpret_cast<unsigned*>(sq + par.sq_off.ring_mask);
+		m_ring.sq_array = reinterpret_cast<unsigned*>(sq + par.sq_off.array);
+		m_ring.cq_head = reinterpret_cast<unsigned*>(cq + par.cq_off.head);
+		m_ring.cq_tail = reinterpret_cast<unsigned*>(cq + par.cq_off.tail);
+		m_ring.cq_mask = reinterpret_cast<unsigned*>(cq + par.cq_off.ring_mask);
+		m_ring.cqes = reinterpret_cast<io_uring_cqe*>(cq + par.cq_off.cqes);
+		m_ring.entries = par.sq_entries;
+		m_ring.in_flight = 0;
+		m_ring.quit = false;
+		return true;
+	}
+
+	LUNARIS_DECL void async_io::_uring_free()
+	{
+		if (m_ring.sqes) munmap(m_ring.sqes, m_ring.sqes_len);
+		if (m_ring.cq_ptr && m_ring.cq_ptr != m_ring.sq_ptr) munmap(m_ring.cq_ptr, m_ring.cq_len);
+		if (m_ring.sq_ptr) munmap(m_ring.sq_ptr, m_ring.sq_len);
+		if (m_ring.fd >= 0) ::close(m_ring.fd);
+		m_ring.sqes = nullptr;
+		m_ring.cq_ptr = m_ring.sq_ptr = nullptr;
+		m_ring.fd = -1;
+		m_ring.entries = 0;
+	}
+
+	LUNARIS_DECL void async_io::_uring_prep(job* it)
+	{
+		const unsigned tail = *m_ring.sq_tail; // only this side writes the tail
+		const unsigned idx = tail & *m_ring.sq_mask;
+		io_uring_sqe& sqe = m_ring.sqes[idx];
+		memset(&sqe, 0, sizeof(sqe));
+
+		if (!it) sqe.opcode = IORING_OP_NOP; // wakes up the reaper
+		else if (it->flush) {
+			sqe.opcode = IORING_OP_FSYNC;
+			sqe.fd = it->handle;
+		}
+		else {
+			it->iov.iov_base = it->data + it->done;
+			it->iov.iov_len = it->size - it->done;
+			sqe.opcode = it->op == async_io_op_e::READ ? IORING_OP_READV : IORING_OP_WRITEV;
+			sqe.fd = it->handle;
+			sqe.off = it->offset + it->done;
+			sqe.addr = reinterpret_cast<uint64_t>(&it->iov);
+			sqe.len = 1;
+		}
+		sqe.user_data = reinterpret_cast<uint64_t>(it);
+
+		m_ring.sq_array[idx] = idx;
+		__atomic_store_n(m_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	LUNARIS_DECL void async_io::_uring_enter(unsigned count)
+	{
+		while (count > 0) {
+			const long res = syscall(__NR_io_uring_enter, m_ring.fd, count, 0, 0, nullptr, 0);
+			if (res < 0) {
+				if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+					std::this_thread::yield();
+					continue;
+				}
+				return; // whatever is left stays in the ring and goes with the next call
+			}
+			count -= static_cast<unsigned>(res);
+		}
+	}
+
+	LUNARIS_DECL void async_io::_uring_reap()
+	{
+		bool quit = false;
+		while (1) {
+			unsigned head = __atomic_load_n(m_ring.cq_head, __ATOMIC_RELAXED);
+			unsigned tail = __atomic_load_n(m_ring.cq_tail, __ATOMIC_ACQUIRE);
+
+			if (head == tail) {
+				if (quit) {
+					std::lock_guard<std::mutex> lock(m_ring.mtx);
+					if (m_ring.in_flight == 0) return;
+				}
+				syscall(__NR_io_uring_enter, m_ring.fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+				continue;
+			}
+
+			size_t finished = 0;
+			std::vector<job*> again; // short transfers
+
+			for (; head != tail; ++head) {
+				const io_uring_cqe& cqe = m_ring.cqes[head & *m_ring.cq_mask];
+				job* it = reinterpret_cast<job*>(cqe.user_data);
+				const int res = cqe.res;
+
+				if (!it) {
+					quit = true;
+					continue;
+				}
+				if (it->flush) {
+					_finish(it, res == 0);
+					++finished;
+					continue;
+				}
+				if (res == -EINTR || res == -EAGAIN) {
+					again.push_back(it);
+					continue;
+				}
+				if (res > 0) it->done += static_cast<size_t>(res);
+				if (res > 0 && it->done < it->size) {
+					again.push_back(it);
+					continue;
+				}
+				if (res < 0) it->err = -res;
+				_finish(it, res >= 0);
+				++finished;
+			}
+			__atomic_store_n(m_ring.cq_head, head, __ATOMIC_RELEASE);
+
+			std::lock_guard<std::mutex> lock(m_ring.mtx);
+			for (auto& it : again) _uring_prep(it); // still counted in flight
+			if (again.size()) _uring_enter(static_cast<unsigned>(again.size()));
+			if (finished) {
+				m_ring.in_flight -= finished;
+				m_ring.room.notify_all();
+			}
+		}
+	}
+#endif
+
+	LUNARIS_DECL void async_io::_finish(job* it, const bool good)
+	{
+		if (it->flush) it->on_flush.set_value(good);
+		else if (good) it->on_size.set_value(static_cast<int64_t>(it->done));
+		else it->on_size.set_value(-static_cast<int64_t>(it->err ? it->err : ECANCELED)); // no error set: never ran
+		delete it;
+	}
+
+	LUNARIS_DECL void async_io::_push(std::vector<job*>& jobs)
+	{
+		if (!m_run) start();
+
+#ifdef LUNARIS_ASYNC_IO_URING
+		if (m_ring.fd >= 0) {
+			std::unique_lock<std::mutex> lock(m_ring.mtx);
+			size_t i = 0;
+			while (i < jobs.size()) {
+				if (m_ring.quit) break;
+				m_ring.room.wait(lock, [this] { return m_ring.in_flight < m_ring.entries || m_ring.quit; });
+				if (m_ring.quit) break;
+
+				unsigned count = 0;
+				for (; i < jobs.size() && m_ring.in_flight < m_ring.entries; ++i, ++count) {
+					_uring_prep(jobs[i]);
+					++m_ring.in_flight;
+				}
+				_uring_enter(count);
+			}
+			lock.unlock();
+			for (; i < jobs.size(); ++i) _finish(jobs[i], false); // stopped meanwhile
+			return;
+		}
+#endif
+		{
+			std::lock_guard<std::mutex> lock(m_queue_mtx);
+			if (m_run) {
+				for (auto& it : jobs) m_queue.push_back(it);
+				jobs.clear();
+			}
+		}
+		if (jobs.empty()) m_queue_cond.notify_all();
+		else for (auto& it : jobs) _finish(it, false);
+	}
+
+	LUNARIS_DECL future<int64_t> async_io::_push_one(job* it)
+	{
+		future<int64_t> fut = it->on_size.get_future();
+		std::vector<job*> jobs{ it };
+		_push(jobs);
+		return fut;
+	}
+
+	LUNARIS_DECL async_io::~async_io()
+	{
+		stop();
+	}
+
+	LUNARIS_DECL bool async_io::start(const unsigned entries, const size_t threads, const bool try_uring)
+	{
+		std::lock_guard<std::mutex> state(m_state_mtx);
+		std::lock_guard<std::mutex> lock(m_queue_mtx);
+		if (m_run) return false;
+
+#ifdef LUNARIS_ASYNC_IO_URING
+		if (try_uring && _uring_setup(entries == 0 ? 1 : entries)) {
+			m_run = true;
+			m_ring.reaper = std::thread([this] { _uring_reap(); });
+#ifdef LUNARIS_VERBOSE_BUILD
+			PRINT_DEBUG("async_io %p started with io_uring (%u entries)", this, m_ring.entries);
+#endif
+			return true;
+		}
+#endif
+
+		size_t amount = threads;
+		if (amount == 0) {
+			amount = std::thread::hardware_concurrency() / 2;
+			if (amount < 2) amount = 2;
+			if (amount > 8) amount = 8;
+		}
+		m_run = true;
+		for (size_t p = 0; p < amount; ++p) m_workers.emplace_back([this] { _pool_work(); });
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("async_io %p started with %zu threads", this, amount);
+#endif
+		return true;
+	}
+
+	LUNARIS_DECL void async_io::stop()
+	{
+		std::lock_guard<std::mutex> state(m_state_mtx);
+		{
+			std::lock_guard<std::mutex> lock(m_queue_mtx);
+			if (!m_run) return;
+			m_run = false;
+		}
+
+#ifdef LUNARIS_ASYNC_IO_URING
+		if (m_ring.fd >= 0) {
+			{
+				std::lock_guard<std::mutex> lock(m_ring.mtx);
+				m_ring.quit = true;
+				_uring_prep(nullptr);
+				_uring_enter(1);
+				m_ring.room.notify_all();
+			}
+			if (m_ring.reaper.joinable()) m_ring.reaper.join();
+			_uring_free();
+			return;
+		}
+#endif
+
+		m_queue_cond.notify_all();
+		for (auto& it : m_workers) if (it.joinable()) it.join();
+		m_workers.clear();
+	}
+
+	LUNARIS_DECL bool async_io::running() const
+	{
+		return m_run;
+	}
+
+	LUNARIS_DECL bool async_io::is_io_uring() const
+	{
+#ifdef LUNARIS_ASYNC_IO_URING
+		return m_run && m_ring.fd >= 0;
+#else
+		return false;
+#endif
+	}
+
+	LUNARIS_DECL future<int64_t> async_io::read(const async_file& fp, char* data, const size_t len, const uint64_t off)
+	{
+		if (!fp.is_open()) return make_empty_future<int64_t>(-EBADF);
+		if (len == 0) return make_empty_future<int64_t>(0);
+		if (!data) return make_empty_future<int64_t>(-EINVAL);
+
+		job* it = new job();
+		it->handle = fp.get_handle();
+		it->op = async_io_op_e::READ;
+		it->data = data;
+		it->size = len;
+		it->offset = off;
+		return _push_one(it);
+	}
+
+	LUNARIS_DECL future<int64_t> async_io::write(const async_file& fp, const char* data, const size_t len, const uint64_t off)
+	{
+		if (!fp.is_open()) return make_empty_future<int64_t>(-EBADF);
+		if (len == 0) return make_empty_future<int64_t>(0);
+		if (!data) return make_empty_future<int64_t>(-EINVAL);
+
+		job* it = new job();
+		it->handle = fp.get_handle();
+		it->op = async_io_op_e::WRITE;
+		it->data = const_cast<char*>(data); // only read from
+		it->size = len;
+		it->offset = off;
+		return _push_one(it);
+	}
+
+	LUNARIS_DECL future<int64_t> async_io::write(const async_file& fp, std::vector<char>&& data, const uint64_t off)
+	{
+		if (!fp.is_open()) return make_empty_future<int64_t>(-EBADF);
+		if (data.empty()) return make_empty_future<int64_t>(0);
+
+		job* it = new job();
+		it->handle = fp.get_handle();
+		it->op = async_io_op_e::WRITE;
+		it->owned = std::move(data);
+		it->data = it->owned.data();
+		it->size = it->owned.size();
+		it->offset = off;
+		return _push_one(it);
+	}
+
+	LUNARIS_DECL future<bool> async_io::flush(const async_file& fp)
+	{
+		if (!fp.is_open()) return make_empty_future<bool>(false);
+
+		job* it = new job();
+		it->handle = fp.get_handle();
+		it->flush = true;
+		future<bool> fut = it->on_flush.get_future();
+		std::vector<job*> jobs{ it };
+		_push(jobs);
+		return fut;
+	}
+
+	LUNARIS_DECL std::vector<future<int64_t>> async_io::submit(const std::vector<async_io_request>& reqs)
+	{
+		std::vector<future<int64_t>> futs;
+		std::vector<job*> jobs;
+		futs.reserve(reqs.size());
+		jobs.reserve(reqs.size());
+
+		for (const auto& req : reqs) {
+			if (!req.file || !req.file->is_open() || (!req.data && req.size)) {
+				futs.push_back(make_empty_future<int64_t>(!req.file || !req.file->is_open() ? -EBADF : -EINVAL));
+				continue;
+			}
+			if (req.size == 0) {
+				futs.push_back(make_empty_future<int64_t>(0));
+				continue;
+			}
+			job* it = new job();
+			it->handle = req.file->get_handle();
+			it->op = req.op;
+			it->data = req.data;
+			it->size = req.size;
+			it->offset = req.offset;
+			futs.push_back(it->on_size.get_future());
+			jobs.push_back(it);
+		}
+
+		if (jobs.size()) _push(jobs);
+		return futs;
+	}
+
+}
\ No newline at end of file
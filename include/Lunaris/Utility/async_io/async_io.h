@@ -0,0 +1,287 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/future.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <stdint.h>
+#include <errno.h>
+#if (_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define LUNARIS_ASYNC_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#endif
+#endif
+
+namespace Lunaris {
+
+	/// <summary>
+	/// <para>A file opened for async_io: a plain system handle, read and written at explicit offsets (no cursor, no buffering).</para>
+	/// <para>Keep it open while there are requests on it.</para>
+	/// </summary>
+	class async_file : public NonCopyable {
+	public:
+#ifdef _WIN32
+		using native_handle = HANDLE;
+#else
+		using native_handle = int;
+#endif
+	private:
+#ifdef _WIN32
+		native_handle m_handle = INVALID_HANDLE_VALUE;
+#else
+		native_handle m_handle = -1;
+#endif
+		std::string m_path;
+	public:
+		async_file() = default;
+
+		/// <summary>
+		/// <para>Move an async_file handle to this.</para>
+		/// </summary>
+		/// <param name="{async_file}">The async_file being moved.</param>
+		async_file(async_file&&) noexcept;
+
+		/// <summary>
+		/// <para>Move an async_file handle to this.</para>
+		/// <para>If this had a file, it is closed automatically.</para>
+		/// </summary>
+		/// <param name="{async_file}">The async_file being moved.</param>
+		void operator=(async_file&&) noexcept;
+
+		/// <summary>
+		/// <para>Closes the handle.</para>
+		/// </summary>
+		~async_file();
+
+		/// <summary>
+		/// <para>Open a file. Same modes as file, but READWRITE_KEEP doesn't append (every write has its offset).</para>
+		/// </summary>
+		/// <param name="{std::string}">File path.</param>
+		/// <param name="{open_mode_e}">What mode to open the file.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool open(const std::string&, const file::open_mode_e&);
+
+		/// <summary>
+		/// <para>Open the same file a file (or tempfile) has open. Its buffer is flushed first.</para>
+		/// <para>Read and write if possible, read only if not. Don't mix writes from both at the same time.</para>
+		/// </summary>
+		/// <param name="{file}">An open file with a path.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool open(file&);
+
+		/// <summary>
+		/// <para>Close the handle.</para>
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// <para>The path used to open it.</para>
+		/// </summary>
+		/// <returns>{std::string} Path.</returns>
+		const std::string& get_path() const;
+
+		/// <summary>
+		/// <para>System handle.</para>
+		/// </summary>
+		/// <returns>{native_handle} The handle (-1 or INVALID_HANDLE_VALUE if not open).</returns>
+		native_handle get_handle() const;
+
+		/// <summary>
+		/// <para>Current size of the file on disk.</para>
+		/// </summary>
+		/// <returns>{uint64_t} Size in bytes.</returns>
+		uint64_t size() const;
+
+		/// <summary>
+		/// <para>Is there a file open?</para>
+		/// </summary>
+		/// <returns>{bool} True if open.</returns>
+		bool is_open() const;
+	};
+
+	enum class async_io_op_e {
+		READ,	// into data
+		WRITE	// from data
+	};
+
+	/// <summary>
+	/// <para>One request for async_io::submit. Data must be valid until its future is set.</para>
+	/// </summary>
+	struct async_io_request {
+		async_io_op_e op = async_io_op_e::READ;
+		const async_file* file = nullptr;
+		char* data = nullptr;
+		size_t size = 0;
+		uint64_t offset = 0;
+	};
+
+	/// <summary>
+	/// <para>async_io runs reads and writes at offsets away from the caller thread. Each request gives back a future.</para>
+	/// <para>On Linux it uses io_uring (many requests per system call). Elsewhere, or if the kernel says no, it uses a small pool of threads.</para>
+	/// <para>Short transfers are continued automatically: the result is the full size, or less only at the end of the file.</para>
+	/// <para>Errors are negative: -errno (-EIO for system errors on Windows), -EBADF/-EINVAL for a bad request, -ECANCELED if stopped before it ran.</para>
+	/// </summary>
+	class async_io : public NonCopyable {
+		struct job {
+			async_file::native_handle handle;
+			async_io_op_e op = async_io_op_e::READ;
+			bool flush = false;
+			char* data = nullptr;
+			size_t size = 0;
+			uint64_t offset = 0;
+			size_t done = 0;
+			int err = 0; // errno, if it failed
+			std::vector<char> owned; // data of write(std::vector&&)
+#ifdef LUNARIS_ASYNC_IO_URING
+			struct iovec iov {};
+#endif
+			promise<int64_t> on_size;
+			promise<bool> on_flush;
+		};
+
+		std::atomic<bool> m_run = false;
+		std::mutex m_state_mtx; // start and stop
+
+		// thread pool (fallback)
+		std::vector<std::thread> m_workers;
+		std::deque<job*> m_queue;
+		std::mutex m_queue_mtx;
+		std::condition_variable m_queue_cond;
+
+		void _pool_work();
+		static void _pool_do(job*);
+
+#ifdef LUNARIS_ASYNC_IO_URING
+		struct uring {
+			int fd = -1;
+			void* sq_ptr = nullptr;
+			size_t sq_len = 0;
+			void* cq_ptr = nullptr;
+			size_t cq_len = 0;
+			io_uring_sqe* sqes = nullptr;
+			size_t sqes_len = 0;
+			unsigned* sq_tail = nullptr;
+			unsigned* sq_mask = nullptr;
+			unsigned* sq_array = nullptr;
+			unsigned* cq_head = nullptr;
+			unsigned* cq_tail = nullptr;
+			unsigned* cq_mask = nullptr;
+			io_uring_cqe* cqes = nullptr;
+			unsigned entries = 0;
+			size_t in_flight = 0; // never above entries, so the completion queue (2x) can't overflow
+			bool quit = false;
+			std::mutex mtx;
+			std::condition_variable room;
+			std::thread reaper;
+		} m_ring;
+
+		bool _uring_setup(const unsigned);
+		void _uring_free();
+		void _uring_prep(job*); // fill next SQE, needs lock
+		void _uring_enter(unsigned); // submit SQEs, needs lock
+		void _uring_reap();
+#endif
+
+		static void _finish(job*, const bool);
+		void _push(std::vector<job*>&);
+		future<int64_t> _push_one(job*);
+	public:
+		async_io() = default;
+
+		/// <summary>
+		/// <para>Stops (waiting for what is in flight).</para>
+		/// </summary>
+		~async_io();
+
+		/// <summary>
+		/// <para>Start the engine. Called automatically on first use with defaults.</para>
+		/// </summary>
+		/// <param name="{unsigned}">Max requests in flight with io_uring.</param>
+		/// <param name="{size_t}">Threads for the fallback (0 = automatic).</param>
+		/// <param name="{bool}">Try io_uring?</param>
+		/// <returns>{bool} True if started now (false if it was running already).</returns>
+		bool start(const unsigned = 256, const size_t = 0, const bool = true);
+
+		/// <summary>
+		/// <para>Stop. Requests in flight are finished first. Using it again starts it again.</para>
+		/// </summary>
+		void stop();
+
+		/// <summary>
+		/// <para>Is it running?</para>
+		/// </summary>
+		/// <returns>{bool} True if started.</returns>
+		bool running() const;
+
+		/// <summary>
+		/// <para>Is it using io_uring (instead of threads)?</para>
+		/// </summary>
+		/// <returns>{bool} True if io_uring.</returns>
+		bool is_io_uring() const;
+
+		/// <summary>
+		/// <para>Read at an offset. Buffer must be valid until the future is set.</para>
+		/// </summary>
+		/// <param name="{async_file}">File.</param>
+		/// <param name="{char*}">Buffer.</param>
+		/// <param name="{size_t}">Bytes to read.</param>
+		/// <param name="{uint64_t}">Offset in the file.</param>
+		/// <returns>{future} Bytes read, or a negative error.</returns>
+		future<int64_t> read(const async_file&, char*, const size_t, const uint64_t);
+
+		/// <summary>
+		/// <para>Write at an offset. Buffer must be valid until the future is set.</para>
+		/// </summary>
+		/// <param name="{async_file}">File.</param>
+		/// <param name="{char*}">Data.</param>
+		/// <param name="{size_t}">Bytes to write.</param>
+		/// <param name="{uint64_t}">Offset in the file.</param>
+		/// <returns>{future} Bytes written, or a negative error.</returns>
+		future<int64_t> write(const async_file&, const char*, const size_t, const uint64_t);
+
+		/// <summary>
+		/// <para>Write at an offset, owning the data until done (fire and forget).</para>
+		/// </summary>
+		/// <param name="{async_file}">File.</param>
+		/// <param name="{std::vector&lt;char&gt;}">Data (moved).</param>
+		/// <param name="{uint64_t}">Offset in the file.</param>
+		/// <returns>{future} Bytes written, or a negative error.</returns>
+		future<int64_t> write(const async_file&, std::vector<char>&&, const uint64_t);
+
+		/// <summary>
+		/// <para>Flush a file to disk (fsync). Only covers writes that are done already.</para>
+		/// </summary>
+		/// <param name="{async_file}">File.</param>
+		/// <returns>{future} True if success.</returns>
+		future<bool> flush(const async_file&);
+
+		/// <summary>
+		/// <para>Submit many requests at once (one system call with io_uring, one wake up for threads).</para>
+		/// </summary>
+		/// <param name="{std::vector&lt;async_io_request&gt;}">Requests.</param>
+		/// <returns>{std::vector&lt;future&gt;} One future per request, in the same order (bytes, or a negative error).</returns>
+		std::vector<future<int64_t>> submit(const std::vector<async_io_request>&);
+	};
+
+}
\ No newline at end of file
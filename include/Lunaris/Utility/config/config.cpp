@@ -12,56 +12,170 @@ namespace Lunaris {
 	{
 		if (key.empty() || val.empty()) return;
 
-		for (auto& j : i.key_and_value) {
-			if (j.first == key) {
-				j.second = val;
-				return;
+		std::lock_guard<std::mutex> luck(save_safe);
+		const auto it = i.key_index.find(key);
+		if (it != i.key_index.end()) {
+			entry& e = i.key_and_value[it->second];
+			if (e.value != val) {
+				e.value = val;
+				e.parsed.reset();
+				if (i.mode == config_section_mode::SAVE) _changed();
 			}
+			return;
 		}
 		i.key_and_value.push_back({ key, val });
-		return;
+		i.key_index.emplace(i.key_and_value.back().key, i.key_and_value.size() - 1);
+		++generation;
+		if (i.mode == config_section_mode::SAVE) _changed();
 	}
 			
-	LUNARIS_DECL config::section& config::_get_to_set(const std::string& sec, const config::config_section_mode mode)
+	LUNARIS_DECL config::section& config::_get_to_set(const std::string_view sec, const config::config_section_mode mode)
 	{
-		for (auto& i : conff) {
-			if (i.section_name == sec) {
-				return i;
-			}
-		}
-		conff.push_back({ mode, sec });
+		const auto it = conff_index.find(sec);
+		if (it != conff_index.end()) return conff[it->second];
+
+		std::lock_guard<std::mutex> luck(save_safe);
+		conff.push_back({ mode, std::string(sec) });
+		conff_index.emplace(conff.back().section_name, conff.size() - 1);
+		if (mode == config_section_mode::SAVE) _changed();
 		return conff.back();
 	}
 
-	LUNARIS_DECL const config::section& config::_get(const std::string& sec) const
+	LUNARIS_DECL const config::section& config::_get(const std::string_view sec) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + "!");
+		return *s;
+	}
+
+	LUNARIS_DECL const config::section* config::_find(const std::string_view sec) const
+	{
+		const auto it = conff_index.find(sec);
+		return it != conff_index.end() ? &conff[it->second] : nullptr;
+	}
+
+	LUNARIS_DECL const config::entry* config::_find(const section& s, const std::string_view key) const
+	{
+		const auto it = s.key_index.find(key);
+		return it != s.key_index.end() ? &s.key_and_value[it->second] : nullptr;
+	}
+
+	LUNARIS_DECL const std::string& config::_value(const std::string_view sec, const std::string_view key) const
 	{
+		static const std::string empty_value;
+		const section* s = _find(sec);
+		if (!s) return empty_value;
+		const entry* e = _find(*s, key);
+		return e ? e->value : empty_value;
+	}
+
+	LUNARIS_DECL bool config::_has(const std::string_view sec) const
+	{
+		return conff_index.find(sec) != conff_index.end();
+	}
+
+	LUNARIS_DECL void config::_changed()
+	{
+		save_dirty = true;
+		save_last_change = std::chrono::steady_clock::now();
+		save_cond.notify_one();
+	}
+
+	LUNARIS_DECL ALLEGRO_CONFIG* config::_build() const
+	{
+		ALLEGRO_CONFIG* conf = al_create_config();
+		if (!conf) return nullptr;
+
 		for (const auto& i : conff) {
-			if (i.section_name == sec) {
-				return i;
+			if (i.mode != config::config_section_mode::SAVE) continue;
+			if (!i.section_comment.empty()) al_add_config_comment(conf, i.section_name.c_str(), i.section_comment.c_str());
+			for (auto& j : i.key_and_value) {
+				al_set_config_value(conf, i.section_name.c_str(), j.key.c_str(), j.value.c_str());
 			}
 		}
-		throw std::runtime_error(("There is no section called " + sec + "!").c_str());
-		return conff.front();
+		return conf;
 	}
 
-	LUNARIS_DECL bool config::_has(const std::string& sec) const
+	LUNARIS_DECL bool config::_save(ALLEGRO_CONFIG* conf, const std::string& dest)
 	{
-		for (const auto& i : conff) {
-			if (i.section_name == sec) return true;
+		const std::string tmp = dest + ".tmp";
+		const bool good = al_save_config_file(tmp.c_str(), conf);
+		al_destroy_config(conf);
+
+		std::error_code err;
+		if (good) std::filesystem::rename(tmp, dest, err); // replaces the old one at once, a crash never leaves half a file there
+		if (!good || err) {
+			std::filesystem::remove(tmp, err);
+			return false;
+		}
+		return true;
+	}
+
+	LUNARIS_DECL void config::_saver()
+	{
+		std::unique_lock<std::mutex> luck(save_safe);
+
+		while (save_keep) {
+			if (!save_dirty || path.empty()) {
+				save_cond.wait(luck);
+				continue;
+			}
+
+			const auto when = save_last_change + save_delay;
+			if (std::chrono::steady_clock::now() < when) { // still changing, wait for it to calm down
+				save_cond.wait_until(luck, when);
+				continue;
+			}
+
+			ALLEGRO_CONFIG* conf = _build();
+			const std::string dest = path;
+			save_dirty = false;
+			luck.unlock();
+
+			const bool good = conf && _save(conf, dest);
+#ifdef LUNARIS_VERBOSE_BUILD
+			PRINT_DEBUG("Background save config %p -> '%s': %s", this, dest.c_str(), good ? "ok" : "failed");
+#endif
+
+			luck.lock();
+			if (!good && !save_dirty) { // try again later
+				save_dirty = true;
+				save_last_change = std::chrono::steady_clock::now();
+			}
 		}
-		return false;
+	}
+
+	LUNARIS_DECL bool config::_stop_saver()
+	{
+		if (!save_thr.joinable()) return false;
+		{
+			std::lock_guard<std::mutex> luck(save_safe);
+			save_keep = false;
+		}
+		save_cond.notify_all();
+		save_thr.join();
+		return true;
 	}
 
 	LUNARIS_DECL config::config(config&& c) noexcept
 	{
+		const bool bg = c._stop_saver();
 		path = std::move(c.path);
 		autosave = c.autosave;
-		conff = std::move(c.conff);
+		conff = std::move(c.conff); // deque move keeps elements in place, so the indexes are still valid
+		conff_index = std::move(c.conff_index);
+		generation = (generation > c.generation ? generation : c.generation) + 1;
+		++c.generation;
+		save_delay = c.save_delay;
+		save_dirty = c.save_dirty;
+		save_last_change = c.save_last_change;
+		if (bg) background_save(true, save_delay);
 	}
 
 	LUNARIS_DECL config::~config()
 	{
-		if (autosave) flush();
+		const bool bg = _stop_saver();
+		if (autosave || (bg && is_dirty())) flush();
 	}
 
 	LUNARIS_DECL void config::auto_save(bool b)
@@ -69,6 +183,25 @@ namespace Lunaris {
 		autosave = b;
 	}
 
+	LUNARIS_DECL void config::background_save(const bool b, const std::chrono::milliseconds delay)
+	{
+		_stop_saver();
+		if (!b) return;
+
+		{
+			std::lock_guard<std::mutex> luck(save_safe);
+			save_delay = delay;
+			save_keep = true;
+		}
+		save_thr = std::thread([this] { _saver(); });
+	}
+
+	LUNARIS_DECL bool config::is_dirty() const
+	{
+		std::lock_guard<std::mutex> luck(save_safe);
+		return save_dirty;
+	}
+
 	LUNARIS_DECL bool config::load(std::string str)
 	{
 		__config_allegro_start();
@@ -86,11 +219,46 @@ namespace Lunaris {
 			return false;
 		}
 
-		path = str;
+		_load(conf, std::move(str));
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Loaded config %p <- '%s'", this, path.c_str());
+#endif
+
+		return true;
+	}
+
+	LUNARIS_DECL bool config::load(const hybrid_memory<file>& fp)
+	{
+		__config_allegro_start();
+
+		if (fp.empty() || !fp->is_open()) {
+			return false;
+		}
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Loading config %p <- file %p", this, fp.get());
+#endif
+
+		ALLEGRO_CONFIG* conf = nullptr;
+		conf = al_load_config_file_f(fp->get_fp());
+		if (!conf) {
+			return false;
+		}
+
+		_load(conf, {});
+		return true;
+	}
+
+	LUNARIS_DECL void config::_load(ALLEGRO_CONFIG* conf, std::string str)
+	{
+		std::lock_guard<std::mutex> luck(save_safe);
+		path = std::move(str);
 
 		ALLEGRO_CONFIG_SECTION* sect = nullptr;
 		ALLEGRO_CONFIG_ENTRY* entr = nullptr;
 		conff.clear();
+		conff_index.clear();
+		++generation;
 
 		{
 			const char* section = nullptr;
@@ -101,6 +269,7 @@ namespace Lunaris {
 				if (!section) break;
 
 				conff.push_back({ config::config_section_mode::SAVE, section });
+				conff_index.emplace(conff.back().section_name, conff.size() - 1);
 				auto& backk = conff.back();
 
 				const char* key = nullptr;
@@ -112,6 +281,7 @@ namespace Lunaris {
 					const char* result = al_get_config_value(conf, section, key);
 
 					backk.key_and_value.push_back({ key, result });
+					backk.key_index.emplace(backk.key_and_value.back().key, backk.key_and_value.size() - 1);
 
 				} while (key);
 
@@ -119,12 +289,7 @@ namespace Lunaris {
 
 		}
 		al_destroy_config(conf);
-
-#ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Loaded config %p <- '%s'", this, path.c_str());
-#endif
-
-		return true;
+		save_dirty = false; // same as file
 	}
 
 	LUNARIS_DECL void config::save_path(std::string str)
@@ -132,38 +297,37 @@ namespace Lunaris {
 		if (str.empty()) {
 			throw std::invalid_argument("Null path is not a valid path at save_path!");
 		}
+		std::lock_guard<std::mutex> luck(save_safe);
 		path = str;
+		_changed();
 	}
 
 	LUNARIS_DECL bool config::flush()
 	{
 		__config_allegro_start();
 
-		if (path.empty()) return false;
+		ALLEGRO_CONFIG* conf = nullptr;
+		std::string dest;
+		{
+			std::lock_guard<std::mutex> luck(save_safe);
+			if (path.empty()) return false;
+			if (!(conf = _build())) return false;
+			dest = path;
+			save_dirty = false;
+		}
 
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Saving config %p -> '%s'", this, path.c_str());
+		PRINT_DEBUG("Saving config %p -> '%s'", this, dest.c_str());
 #endif
 
-		ALLEGRO_CONFIG* conf = al_create_config();
-		if (!conf) return false;
-
-		for (const auto& i : conff) {
-			if (i.mode != config::config_section_mode::SAVE) continue;
-			if (!i.section_comment.empty()) al_add_config_comment(conf, i.section_name.c_str(), i.section_comment.c_str());
-			for (auto& j : i.key_and_value) {
-				al_set_config_value(conf, i.section_name.c_str(), j.first.c_str(), j.second.c_str());
-			}
-		}
-
-		if (!al_save_config_file(path.c_str(), conf)) {
-			al_destroy_config(conf);
+		if (!_save(conf, dest)) {
+			std::lock_guard<std::mutex> luck(save_safe);
+			_changed();
 			return false;
 		}
-		al_destroy_config(conf);
 
 #ifdef LUNARIS_VERBOSE_BUILD
-		PRINT_DEBUG("Saved config %p -> '%s'", this, path.c_str());
+		PRINT_DEBUG("Saved config %p -> '%s'", this, dest.c_str());
 #endif
 		return true;
 	}
@@ -180,55 +344,34 @@ namespace Lunaris {
 
 	LUNARIS_DECL void config::set(const std::string& sec, const config::config_section_mode mode)
 	{
-		this->_get_to_set(sec, mode).mode = mode;
+		section& s = this->_get_to_set(sec, mode);
+		std::lock_guard<std::mutex> luck(save_safe);
+		if (s.mode == mode) return;
+		s.mode = mode;
+		_changed();
 	}
 
-	LUNARIS_DECL bool config::has(const std::string& sec, const config::config_section_mode mode) const
+	LUNARIS_DECL bool config::has(const std::string_view sec, const config::config_section_mode mode) const
 	{
-		for (const auto& i : conff) {
-			if (i.section_name == sec) {
-				return i.mode == mode;
-			}
-		}
-		return false;
+		const section* s = _find(sec);
+		return s && s->mode == mode;
 	}
 
-	LUNARIS_DECL bool config::has(const std::string& sec, const std::string& key, const config::config_section_mode mode) const
+	LUNARIS_DECL bool config::has(const std::string_view sec, const std::string_view key, const config::config_section_mode mode) const
 	{
-		for (const auto& i : conff) {
-			if (i.section_name == sec &&  i.mode == mode){
-				for (auto& j : i.key_and_value) {
-					if (j.first == key) {
-						return true;
-					}
-				}
-			}
-		}
-		return false;
+		const section* s = _find(sec);
+		return s && s->mode == mode && _find(*s, key);
 	}
 
-	LUNARIS_DECL bool config::has(const std::string& sec) const
+	LUNARIS_DECL bool config::has(const std::string_view sec) const
 	{
-		for (const auto& i : conff) {
-			if (i.section_name == sec) {
-				return true;
-			}
-		}
-		return false;
+		return _has(sec);
 	}
 
-	LUNARIS_DECL bool config::has(const std::string& sec, const std::string& key) const
+	LUNARIS_DECL bool config::has(const std::string_view sec, const std::string_view key) const
 	{
-		for (const auto& i : conff) {
-			if (i.section_name == sec) {
-				for (auto& j : i.key_and_value) {
-					if (j.first == key) {
-						return true;
-					}
-				}
-			}
-		}
-		return false;
+		const section* s = _find(sec);
+		return s && _find(*s, key);
 	}
 
 	LUNARIS_DECL void config::set(const std::string& sec, const std::string& key, const std::string& val)
@@ -501,34 +644,31 @@ namespace Lunaris {
 			else if (i == '#') i = '%';
 		}
 
-		for (auto& i : conff) {
-			if (i.section_name == sec) {
-				i.section_comment = comment;
-				return;
-			}
-		}
-		conff.push_back({ config::config_section_mode::SAVE, sec });
-		auto& backk = conff.back();
-		backk.section_comment = comment;
+		section& s = _get_to_set(sec);
+		std::lock_guard<std::mutex> luck(save_safe);
+		s.section_comment = comment;
+		_changed();
 	}
 
-	LUNARIS_DECL std::string config::get(const std::string& sec, const std::string& key) const
+	LUNARIS_DECL std::string config::get(const std::string_view sec, const std::string_view key) const
 	{
-		for (const auto& i : conff) {
-			if (sec == i.section_name) {
-				for (auto& j : i.key_and_value) {
-					if (j.first == key) return j.second;
-				}
-			}
-		}
-		return "";
+		return _value(sec, key);
 	}
 
 	LUNARIS_DECL void config::operator=(config&& c) noexcept
 	{
+		_stop_saver();
+		const bool bg = c._stop_saver();
 		path = std::move(c.path);
 		autosave = c.autosave;
 		conff = std::move(c.conff);
+		conff_index = std::move(c.conff_index);
+		generation = (generation > c.generation ? generation : c.generation) + 1;
+		++c.generation;
+		save_delay = c.save_delay;
+		save_dirty = c.save_dirty;
+		save_last_change = c.save_last_change;
+		if (bg) background_save(true, save_delay);
 	}
 
 	// instantiation (better compile times)
@@ -557,24 +697,24 @@ namespace Lunaris {
 	template void config::ensure(const std::string&, const std::string&, const std::initializer_list<int64_t>&, const config::config_section_mode);
 	template void config::ensure(const std::string&, const std::string&, const std::initializer_list<uint64_t>&, const config::config_section_mode);
 
-	template bool config::get_as(const std::string&, const std::string&) const;
-	template char config::get_as(const std::string&, const std::string&) const;
-	template int32_t config::get_as(const std::string&, const std::string&) const;
-	template float config::get_as(const std::string&, const std::string&) const;
-	template double config::get_as(const std::string&, const std::string&) const;
-	template unsigned config::get_as(const std::string&, const std::string&) const;
-	template long config::get_as(const std::string&, const std::string&) const;
-	template long long config::get_as(const std::string&, const std::string&) const;
-	template unsigned long long config::get_as(const std::string&, const std::string&) const;
-
-	template std::vector<bool> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<char> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<int32_t> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<float> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<double> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<unsigned> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<long> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<long long> config::get_array(const std::string&, const std::string&) const;
-	template std::vector<unsigned long long> config::get_array(const std::string&, const std::string&) const;
+	template bool config::get_as(const std::string_view, const std::string_view) const;
+	template char config::get_as(const std::string_view, const std::string_view) const;
+	template int32_t config::get_as(const std::string_view, const std::string_view) const;
+	template float config::get_as(const std::string_view, const std::string_view) const;
+	template double config::get_as(const std::string_view, const std::string_view) const;
+	template unsigned config::get_as(const std::string_view, const std::string_view) const;
+	template long config::get_as(const std::string_view, const std::string_view) const;
+	template long long config::get_as(const std::string_view, const std::string_view) const;
+	template unsigned long long config::get_as(const std::string_view, const std::string_view) const;
+
+	template std::vector<bool> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<char> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<int32_t> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<float> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<double> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<unsigned> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<long> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<long long> config::get_array(const std::string_view, const std::string_view) const;
+	template std::vector<unsigned long long> config::get_array(const std::string_view, const std::string_view) const;
 
 }
\ No newline at end of file
@@ -2,10 +2,22 @@
 
 #include <Lunaris/__macro/macros.h>
 
+#include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/memory.h>
+
 #include <allegro5/allegro5.h>
 #include <memory>
 #include <string>
 #include <vector>
+#include <deque>
+#include <unordered_map>
+#include <string_view>
+#include <any>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <sstream>
 #include <stdexcept>
 
@@ -24,26 +36,112 @@ namespace Lunaris {
 	public:
 		enum class config_section_mode { SAVE, MEMORY_ONLY };
 	private:
+		// Storage is std::deque so elements never move when new ones are added: the indexes keep std::string_view of the names in there.
+		// Order is kept as inserted (flush saves like that).
+		struct entry {
+			std::string key;
+			std::string value;
+			mutable std::any parsed; // value as the last type read (get_as, get_array, handle). Reset on set.
+		};
 		struct section {
 			config_section_mode mode;
 			std::string section_name;
 			std::string section_comment;
-			std::vector<std::pair<std::string, std::string>> key_and_value;
+			std::deque<entry> key_and_value;
+			std::unordered_map<std::string_view, size_t> key_index; // key -> key_and_value[i]
 		};
 
 		std::string path; // save path
 		bool autosave = true;
-		std::vector<section> conff;
+		std::deque<section> conff;
+		std::unordered_map<std::string_view, size_t> conff_index; // section name -> conff[i]
+		uint64_t generation = 0; // changes when entries are added or dropped (handles look again)
+
+		// saving (see background_save). These are not moved.
+		mutable std::mutex save_safe; // changes vs. saving (also guards save_* below)
+		std::condition_variable save_cond;
+		std::thread save_thr;
+		std::chrono::milliseconds save_delay{ 500 };
+		std::chrono::steady_clock::time_point save_last_change;
+		bool save_dirty = false;
+		bool save_keep = false;
 
 		// section itself, key and value. Won't change if empty (one of them). Adds if not existant
 		void _set(section&, const std::string&, const std::string&);
 		// by section id. if not found, create section. Mode is used if it has to create a new one.
-		section& _get_to_set(const std::string&, const config_section_mode = config_section_mode::SAVE);
+		section& _get_to_set(const std::string_view, const config_section_mode = config_section_mode::SAVE);
 		// by section id. if not found, throw
-		const section& _get(const std::string&) const;
+		const section& _get(const std::string_view) const;
+		// by section id. if not found, nullptr
+		const section* _find(const std::string_view) const;
+		// by key in section. if not found, nullptr
+		const entry* _find(const section&, const std::string_view) const;
+		// value by section and key. if not found, reference to empty string
+		const std::string& _value(const std::string_view, const std::string_view) const;
 		// checks existance of a section
-		bool _has(const std::string&) const;
+		bool _has(const std::string_view) const;
+
+		// mark dirty and wake the saver (save_safe locked)
+		void _changed();
+		// conff to ALLEGRO_CONFIG (save_safe locked)
+		ALLEGRO_CONFIG* _build() const;
+		// save to temporary file and replace destination with it. Destroys the ALLEGRO_CONFIG.
+		static bool _save(ALLEGRO_CONFIG*, const std::string&);
+		// background save thread
+		void _saver();
+		// stop background save. True if it was running
+		bool _stop_saver();
+		// read everything from ALLEGRO_CONFIG (destroys it) and set path
+		void _load(ALLEGRO_CONFIG*, std::string);
+
+		// string to T (same rules as get_as and get_array)
+		template<typename T> static T _parse(const std::string&) = delete;
+		// copy of the parsed value, parsing and keeping it if not cached as T yet (locks save_safe)
+		template<typename T> T _cached(const entry&) const;
 	public:
+		/// <summary>
+		/// <para>A value bound to a section and key. Reading it doesn't search the config and only parses again if the value was set since the last read.</para>
+		/// <para>T can be anything get_as or get_array works with (use std::vector&lt;T&gt; for arrays).</para>
+		/// <para>NOTE: The config MUST EXIST while this is used. If the same key is read as different types, it parses every switch.</para>
+		/// </summary>
+		template<typename T>
+		class handle {
+			const config* m_ref = nullptr;
+			std::string m_sec, m_key;
+			mutable const entry* m_entry = nullptr;
+			mutable uint64_t m_generation = 0;
+
+			void _check() const; // look again if config changed
+		public:
+			handle() = default;
+
+			/// <summary>
+			/// <para>Bind to a section and key (it doesn't have to exist yet).</para>
+			/// </summary>
+			/// <param name="{config}">The config.</param>
+			/// <param name="{std::string_view}">Section.</param>
+			/// <param name="{std::string_view}">Key.</param>
+			handle(const config&, const std::string_view, const std::string_view);
+
+			/// <summary>
+			/// <para>Get the value (a copy, so a set() meanwhile doesn't change it).</para>
+			/// </summary>
+			/// <returns>{T} Value, or T{} if there's no such key.</returns>
+			T get() const;
+
+			/// <summary>
+			/// <para>Does the key exist right now?</para>
+			/// </summary>
+			/// <returns>{bool} True if it does.</returns>
+			bool exists() const;
+
+			/// <summary>
+			/// <para>Is this bound to a config?</para>
+			/// </summary>
+			/// <returns>{bool} True if bound.</returns>
+			bool valid() const;
+		};
+
 		config() = default;
 
 		/// <summary>
@@ -59,6 +157,21 @@ namespace Lunaris {
 		/// <param name="{bool}">Autosave?</param>
 		void auto_save(bool);
 
+		/// <summary>
+		/// <para>Save on a background thread: every change marks this as dirty and it's saved once when changes stop for a while.</para>
+		/// <para>Saving goes to a temporary file that then replaces the old one, so a crash never leaves a half written file.</para>
+		/// <para>If enabled, pending changes are saved when destroyed even without auto_save.</para>
+		/// </summary>
+		/// <param name="{bool}">Enable?</param>
+		/// <param name="{std::chrono::milliseconds}">Time without changes before saving.</param>
+		void background_save(const bool, const std::chrono::milliseconds = std::chrono::milliseconds(500));
+
+		/// <summary>
+		/// <para>Are there changes not saved yet?</para>
+		/// </summary>
+		/// <returns>{bool} True if dirty.</returns>
+		bool is_dirty() const;
+
 		/// <summary>
 		/// <para>Loads a config file (automatically will save to this path later).</para>
 		/// </summary>
@@ -66,6 +179,13 @@ namespace Lunaris {
 		/// <returns>{bool} True if success.</returns>
 		bool load(std::string);
 
+		/// <summary>
+		/// <para>Loads a config from an open file (like one from an archive). There's no path to save to (see save_path).</para>
+		/// </summary>
+		/// <param name="{hybrid_memory&lt;file&gt;}">The file.</param>
+		/// <returns>{bool} True if success.</returns>
+		bool load(const hybrid_memory<file>&);
+
 		/// <summary>
 		/// <para>Sets a path to save at.</para>
 		/// </summary>
@@ -74,6 +194,7 @@ namespace Lunaris {
 
 		/// <summary>
 		/// <para>Flushes the config to file.</para>
+		/// <para>It writes a temporary file first and then replaces the old one with it.</para>
 		/// </summary>
 		/// <returns>{bool} True if success.</returns>
 		bool flush();
@@ -100,34 +221,34 @@ namespace Lunaris {
 		/// <summary>
 		/// <para>Is there a section with this setting set?</para>
 		/// </summary>
-		/// <param name="{std::string}">Section name.</param>
+		/// <param name="{std::string_view}">Section name.</param>
 		/// <param name="{config_section_mode}">Mode it has to be.</param>
 		/// <returns>{bool} True if it does.</returns>
-		bool has(const std::string&, const config_section_mode) const;
+		bool has(const std::string_view, const config_section_mode) const;
 
 		/// <summary>
 		/// <para>Is there a section with this key and setting set?</para>
 		/// </summary>
-		/// <param name="{std::string}">Section name.</param>
-		/// <param name="{std::string}">Key name.</param>
+		/// <param name="{std::string_view}">Section name.</param>
+		/// <param name="{std::string_view}">Key name.</param>
 		/// <param name="{config_section_mode}">Mode it has to be.</param>
 		/// <returns>{bool} True if it does.</returns>
-		bool has(const std::string&, const std::string&, const config_section_mode) const;
+		bool has(const std::string_view, const std::string_view, const config_section_mode) const;
 
 		/// <summary>
 		/// <para>Is there a section with this setting set?</para>
 		/// </summary>
-		/// <param name="{std::string}">Section name.</param>
+		/// <param name="{std::string_view}">Section name.</param>
 		/// <returns>{bool} True if it does.</returns>
-		bool has(const std::string&) const;
+		bool has(const std::string_view) const;
 
 		/// <summary>
 		/// <para>Is there a section with this key and setting set?</para>
 		/// </summary>
-		/// <param name="{std::string}">Section name.</param>
-		/// <param name="{std::string}">Key name.</param>
+		/// <param name="{std::string_view}">Section name.</param>
+		/// <param name="{std::string_view}">Key name.</param>
 		/// <returns>{bool} True if it does.</returns>
-		bool has(const std::string&, const std::string&) const;
+		bool has(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Ensures if value is not present, your default value is set.</para>
@@ -411,167 +532,175 @@ namespace Lunaris {
 		/// <summary>
 		/// <para>Get a value from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::string} Value.</returns>
-		std::string get(const std::string&, const std::string&) const;
+		std::string get(const std::string_view, const std::string_view) const;
 
-		template<typename T> T get_as(const std::string&, const std::string&) const = delete;
+		template<typename T> T get_as(const std::string_view, const std::string_view) const = delete;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{bool} Value.</returns>
-		template<> bool get_as(const std::string&, const std::string&) const;
+		template<> bool get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{char} Value.</returns>
-		template<> char get_as(const std::string&, const std::string&) const;
+		template<> char get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{int32_t} Value.</returns>
-		template<> int32_t get_as(const std::string&, const std::string&) const;
+		template<> int32_t get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{float} Value.</returns>
-		template<> float get_as(const std::string&, const std::string&) const;
+		template<> float get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{double} Value.</returns>
-		template<> double get_as(const std::string&, const std::string&) const;
+		template<> double get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{unsigned} Value.</returns>
-		template<> unsigned get_as(const std::string&, const std::string&) const;
+		template<> unsigned get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{long} Value.</returns>
-		template<> long get_as(const std::string&, const std::string&) const;
+		template<> long get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{long long} Value.</returns>
-		template<> long long get_as(const std::string&, const std::string&) const;
+		template<> long long get_as(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a value from config as a type T.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{unsigned long long} Value.</returns>
-		template<> unsigned long long get_as(const std::string&, const std::string&) const;
+		template<> unsigned long long get_as(const std::string_view, const std::string_view) const;
 
 		// if you know (you probably know) that the config has been set with initializer list, this will break down the list to a std::vector<std::string>
-		template<typename T> std::vector<T> get_array(const std::string&, const std::string&) const = delete;
+		template<typename T> std::vector<T> get_array(const std::string_view, const std::string_view) const = delete;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<std::string> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<std::string> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<bool> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<bool> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<char> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<char> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<int32_t> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<int32_t> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<float> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<float> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<double> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<double> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<unsigned> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<unsigned> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<long> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<long> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<long long> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<long long> get_array(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Get a vector of values from config.</para>
 		/// </summary>
-		/// <param name="{std::string}">Section.</param>
-		/// <param name="{std::string}">Key.</param>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
 		/// <returns>{std::vector} Vector of values.</returns>
-		template<> std::vector<unsigned long long> get_array(const std::string&, const std::string&) const;
+		template<> std::vector<unsigned long long> get_array(const std::string_view, const std::string_view) const;
+
+		/// <summary>
+		/// <para>Bind a section and key to a handle to read it often without lookups (values are cached parsed).</para>
+		/// </summary>
+		/// <param name="{std::string_view}">Section.</param>
+		/// <param name="{std::string_view}">Key.</param>
+		/// <returns>{handle} The handle.</returns>
+		template<typename T> handle<T> bind(const std::string_view, const std::string_view) const;
 
 		/// <summary>
 		/// <para>Move operator.</para>
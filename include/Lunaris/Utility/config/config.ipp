@@ -29,332 +29,436 @@ namespace Lunaris {
 		}
 	}
 
+	template<typename T>
+	inline T config::_cached(const entry& e) const
+	{
+		std::lock_guard<std::mutex> luck(save_safe); // readers write parsed too, and set resets it
+		if (const T* val = std::any_cast<T>(&e.parsed)) return *val;
+		T val = _parse<T>(e.value); // if it throws, nothing is kept
+		e.parsed = val;
+		return val;
+	}
+
 	template<>
-	inline bool config::get_as(const std::string& sec, const std::string& key) const
+	inline bool config::_parse(const std::string& str)
 	{
-		auto res = get(sec, key);
-		return res == "true";
+		return str == "true";
 	}
 
 	template<>
-	inline char config::get_as(const std::string& sec, const std::string& key) const
+	inline char config::_parse(const std::string& str)
 	{
-		auto res = get(sec, key);
-		if (res.length() > 1) throw std::runtime_error("Fatal error trying to recover get_as config.");
-		return res[0];
+		if (str.length() > 1) throw std::runtime_error("Fatal error trying to recover get_as config.");
+		return str[0];
 	}
-			
+
 	template<>
-	inline int32_t config::get_as(const std::string& sec, const std::string& key) const
+	inline int32_t config::_parse(const std::string& str)
 	{
-		return std::stoi(get(sec, key));
+		return std::stoi(str);
 	}
-			
+
 	template<>
-	inline float config::get_as(const std::string& sec, const std::string& key) const
+	inline float config::_parse(const std::string& str)
 	{
-		return std::stof(get(sec, key));
+		return std::stof(str);
 	}
-			
+
 	template<>
-	inline double config::get_as(const std::string& sec, const std::string& key) const
+	inline double config::_parse(const std::string& str)
 	{
-		return std::stod(get(sec, key));
+		return std::stod(str);
 	}
-			
+
 	template<>
-	inline unsigned config::get_as(const std::string& sec, const std::string& key) const
+	inline unsigned config::_parse(const std::string& str)
 	{
-		return static_cast<unsigned>(std::stoul(get(sec, key)));
+		return static_cast<unsigned>(std::stoul(str));
 	}
-			
+
 	template<>
-	inline long config::get_as(const std::string& sec, const std::string& key) const
+	inline long config::_parse(const std::string& str)
 	{
-		return std::stol(get(sec, key));
+		return std::stol(str);
 	}
-			
+
 	template<>
-	inline long long config::get_as(const std::string& sec, const std::string& key) const
+	inline long long config::_parse(const std::string& str)
 	{
-		return std::stoll(get(sec, key));
+		return std::stoll(str);
 	}
 
-	template<> 
-	inline unsigned long long config::get_as(const std::string& sec, const std::string& key) const
+	template<>
+	inline unsigned long long config::_parse(const std::string& str)
 	{
-		return std::stoull(get(sec, key));
+		return std::stoull(str);
 	}
 
 	template<>
-	inline std::vector<std::string> config::get_array(const std::string& sec, const std::string& key)  const
+	inline std::vector<std::string> config::_parse(const std::string& raw)
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+
 		std::vector<std::string> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
+
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(_buf);
+		}
 
-				str.erase(str.begin());
-				str.pop_back();
+		return vec;
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<bool> config::_parse(const std::string& raw)
+	{
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(_buf);
-				}
+		std::vector<bool> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
 
-				return vec;
-			}
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(_buf == "true");
 		}
+
 		return vec;
 	}
 
 	template<>
-	inline std::vector<bool> config::get_array(const std::string& sec, const std::string& key)  const
+	inline std::vector<char> config::_parse(const std::string& raw)
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<bool> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+
+		std::vector<char> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
+
+		while (std::getline(ss, _buf, ';')) {
+			if (_buf.length() > 1) throw std::runtime_error("Invalid key while trying to recover array-type config.");
+			vec.push_back(_buf[0]);
+		}
 
-				str.erase(str.begin());
-				str.pop_back();
+		return vec;
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<int32_t> config::_parse(const std::string& raw)
+	{
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(_buf == "true");
-				}
+		std::vector<int32_t> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
 
-				return vec;
-			}
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stoi(_buf));
 		}
+
 		return vec;
 	}
-			
+
 	template<>
-	inline std::vector<char> config::get_array(const std::string& sec, const std::string& key)  const
+	inline std::vector<float> config::_parse(const std::string& raw)
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<char> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				str.erase(str.begin());
-				str.pop_back();
+		std::vector<float> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
+
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stof(_buf));
+		}
+
+		return vec;
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<double> config::_parse(const std::string& raw)
+	{
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				while (std::getline(ss, _buf, ';')) {
-					if (_buf.length() > 1) throw std::runtime_error("Invalid key while trying to recover array-type config.");
-					vec.push_back(_buf[0]);
-				}
+		std::vector<double> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
 
-				return vec;
-			}
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stod(_buf));
 		}
+
 		return vec;
 	}
 
 	template<>
-	inline std::vector<int32_t> config::get_array(const std::string& sec, const std::string& key) const
+	inline std::vector<unsigned> config::_parse(const std::string& raw)
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<int32_t> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+
+		std::vector<unsigned> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
+
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(static_cast<unsigned>(std::stoul(_buf)));
+		}
 
-				str.erase(str.begin());
-				str.pop_back();
+		return vec;
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<long> config::_parse(const std::string& raw)
+	{
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stoi(_buf));
-				}
+		std::vector<long> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
 
-				return vec;
-			}
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stol(_buf));
 		}
+
 		return vec;
 	}
-			
+
 	template<>
-	inline std::vector<float> config::get_array(const std::string& sec, const std::string& key)  const
+	inline std::vector<long long> config::_parse(const std::string& raw)
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<float> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+
+		std::vector<long long> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
+
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stoll(_buf));
+		}
 
-				str.erase(str.begin());
-				str.pop_back();
+		return vec;
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<unsigned long long> config::_parse(const std::string& raw)
+	{
+		if (raw.empty() || raw.front() != '{' || raw.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stof(_buf));
-				}
+		std::vector<unsigned long long> vec;
+		std::stringstream ss(raw.substr(1, raw.size() - 2));
+		std::string _buf;
 
-				return vec;
-			}
+		while (std::getline(ss, _buf, ';')) {
+			vec.push_back(std::stoull(_buf));
 		}
+
 		return vec;
 	}
-			
+
 	template<>
-	inline std::vector<double> config::get_array(const std::string& sec, const std::string& key)  const
+	inline bool config::get_as(const std::string_view sec, const std::string_view key) const
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<double> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<bool>(*e) : _parse<bool>({});
+	}
 
-				str.erase(str.begin());
-				str.pop_back();
+	template<>
+	inline char config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<char>(*e) : _parse<char>({});
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline int32_t config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<int32_t>(*e) : _parse<int32_t>({});
+	}
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stod(_buf));
-				}
+	template<>
+	inline float config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<float>(*e) : _parse<float>({});
+	}
 
-				return vec;
-			}
-		}
-		return vec;
+	template<>
+	inline double config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<double>(*e) : _parse<double>({});
 	}
 
-	template<> 
-	inline std::vector<unsigned> config::get_array(const std::string& sec, const std::string& key)  const
+	template<>
+	inline unsigned config::get_as(const std::string_view sec, const std::string_view key) const
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<unsigned> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<unsigned>(*e) : _parse<unsigned>({});
+	}
 
-				str.erase(str.begin());
-				str.pop_back();
+	template<>
+	inline long config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<long>(*e) : _parse<long>({});
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline long long config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<long long>(*e) : _parse<long long>({});
+	}
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(static_cast<unsigned>(std::stoul(_buf)));
-				}
+	template<>
+	inline unsigned long long config::get_as(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		const entry* e = s ? _find(*s, key) : nullptr;
+		return e ? _cached<unsigned long long>(*e) : _parse<unsigned long long>({});
+	}
 
-				return vec;
-			}
-		}
-		return vec;
+	template<>
+	inline std::vector<std::string> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<std::string>>(*e) : std::vector<std::string>{};
 	}
-			
+
 	template<>
-	inline std::vector<long> config::get_array(const std::string& sec, const std::string& key) const
+	inline std::vector<bool> config::get_array(const std::string_view sec, const std::string_view key) const
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<long> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<bool>>(*e) : std::vector<bool>{};
+	}
 
-				str.erase(str.begin());
-				str.pop_back();
+	template<>
+	inline std::vector<char> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<char>>(*e) : std::vector<char>{};
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<int32_t> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<int32_t>>(*e) : std::vector<int32_t>{};
+	}
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stol(_buf));
-				}
+	template<>
+	inline std::vector<float> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<float>>(*e) : std::vector<float>{};
+	}
 
-				return vec;
-			}
-		}
-		return vec;
+	template<>
+	inline std::vector<double> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<double>>(*e) : std::vector<double>{};
 	}
-			
+
 	template<>
-	inline std::vector<long long> config::get_array(const std::string& sec, const std::string& key)  const
+	inline std::vector<unsigned> config::get_array(const std::string_view sec, const std::string_view key) const
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<long long> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<unsigned>>(*e) : std::vector<unsigned>{};
+	}
 
-				str.erase(str.begin());
-				str.pop_back();
+	template<>
+	inline std::vector<long> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<long>>(*e) : std::vector<long>{};
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<>
+	inline std::vector<long long> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<long long>>(*e) : std::vector<long long>{};
+	}
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stoll(_buf));
-				}
+	template<>
+	inline std::vector<unsigned long long> config::get_array(const std::string_view sec, const std::string_view key) const
+	{
+		const section* s = _find(sec);
+		if (!s) throw std::runtime_error("There is no section called " + std::string(sec) + " in this config file (" + path + ")");
+		const entry* e = _find(*s, key);
+		return e ? _cached<std::vector<unsigned long long>>(*e) : std::vector<unsigned long long>{};
+	}
 
-				return vec;
-			}
-		}
-		return vec;
+	template<typename T>
+	inline config::handle<T> config::bind(const std::string_view sec, const std::string_view key) const
+	{
+		return handle<T>(*this, sec, key);
 	}
-			
-	template<>
-	inline std::vector<unsigned long long> config::get_array(const std::string& sec, const std::string& key)  const
+
+	template<typename T>
+	inline void config::handle<T>::_check() const
 	{
-		if (!_has(sec)) throw std::runtime_error("There is no section called " + sec + " in this config file (" + path + ")");
-		std::vector<unsigned long long> vec;
-		auto& s = _get(sec);
-		for (const auto& i : s.key_and_value) {
-			if (i.first == key) {
-				auto str = i.second;
-				if (str.empty() || str.front() != '{' || str.back() != '}') throw std::runtime_error("Fatal error trying to recover array-type config.");
+		if (m_generation == m_ref->generation) return;
+		m_generation = m_ref->generation;
+		const section* s = m_ref->_find(m_sec);
+		m_entry = s ? m_ref->_find(*s, m_key) : nullptr;
+	}
 
-				str.erase(str.begin());
-				str.pop_back();
+	template<typename T>
+	inline config::handle<T>::handle(const config& ref, const std::string_view sec, const std::string_view key)
+		: m_ref(&ref), m_sec(sec), m_key(key)
+	{
+		m_generation = ref.generation - 1; // look on first use
+	}
 
-				std::stringstream ss(str);
-				std::string _buf;
+	template<typename T>
+	inline T config::handle<T>::get() const
+	{
+		if (!m_ref) return T{};
+		_check();
+		return m_entry ? m_ref->_cached<T>(*m_entry) : T{};
+	}
 
-				while (std::getline(ss, _buf, ';')) {
-					vec.push_back(std::stoull(_buf));
-				}
+	template<typename T>
+	inline bool config::handle<T>::exists() const
+	{
+		if (!m_ref) return false;
+		_check();
+		return m_entry != nullptr;
+	}
 
-				return vec;
-			}
-		}
-		return vec;
+	template<typename T>
+	inline bool config::handle<T>::valid() const
+	{
+		return m_ref != nullptr;
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "crypt/crypt.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "crypt/crypt.cpp"
+#endif
\ No newline at end of file
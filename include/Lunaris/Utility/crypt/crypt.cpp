@@ -0,0 +1,457 @@
+#include "crypt.h"
+
+namespace Lunaris {
+
+	namespace __crypt {
+
+		inline uint32_t rotl(const uint32_t x, const int n)
+		{
+			return (x << n) | (x >> (32 - n));
+		}
+
+		inline uint32_t load32(const unsigned char* p)
+		{
+			return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+		}
+
+		inline void store32(unsigned char* p, const uint32_t v)
+		{
+			p[0] = static_cast<unsigned char>(v);
+			p[1] = static_cast<unsigned char>(v >> 8);
+			p[2] = static_cast<unsigned char>(v >> 16);
+			p[3] = static_cast<unsigned char>(v >> 24);
+		}
+
+		inline void store64(unsigned char* p, const uint64_t v)
+		{
+			store32(p, static_cast<uint32_t>(v));
+			store32(p + 4, static_cast<uint32_t>(v >> 32));
+		}
+
+		template<typename T>
+		void seal(const crypt_key& key, T& data)
+		{
+			const crypt_nonce nonce = crypt_random_nonce();
+			const size_t len = data.size();
+
+			data.resize(crypt_nonce_size + len + crypt_tag_size);
+			memmove(&data[crypt_nonce_size], &data[0], len); // one move in the same buffer, no copies
+			memcpy(&data[0], nonce.data(), crypt_nonce_size);
+
+			const crypt_tag tag = chacha20_poly1305_encrypt(key, nonce, &data[crypt_nonce_size], len);
+			memcpy(&data[crypt_nonce_size + len], tag.data(), crypt_tag_size);
+		}
+
+		template<typename T>
+		bool open(const crypt_key& key, T& data)
+		{
+			if (data.size() < crypt_nonce_size + crypt_tag_size) {
+				data.clear();
+				return false;
+			}
+
+			const size_t len = data.size() - crypt_nonce_size - crypt_tag_size;
+			crypt_nonce nonce;
+			crypt_tag tag;
+			memcpy(nonce.data(), &data[0], crypt_nonce_size);
+			memcpy(tag.data(), &data[crypt_nonce_size + len], crypt_tag_size);
+
+			if (!chacha20_poly1305_decrypt(key, nonce, &data[crypt_nonce_size], len, tag)) {
+				data.clear();
+				return false;
+			}
+
+			if (len) memmove(&data[0], &data[crypt_nonce_size], len);
+			data.resize(len);
+			return true;
+		}
+	}
+
+	LUNARIS_DECL void chacha20::_next()
+	{
+		uint32_t x[16];
+		memcpy(x, m_state, sizeof(x));
+
+		const auto quarter = [&x](const int a, const int b, const int c, const int d) {
+			x[a] += x[b]; x[d] ^= x[a]; x[d] = __crypt::rotl(x[d], 16);
+			x[c] += x[d]; x[b] ^= x[c]; x[b] = __crypt::rotl(x[b], 12);
+			x[a] += x[b]; x[d] ^= x[a]; x[d] = __crypt::rotl(x[d], 8);
+			x[c] += x[d]; x[b] ^= x[c]; x[b] = __crypt::rotl(x[b], 7);
+		};
+
+		for (int r = 0; r < 10; ++r) {
+			quarter(0, 4, 8, 12);
+			quarter(1, 5, 9, 13);
+			quarter(2, 6, 10, 14);
+			quarter(3, 7, 11, 15);
+			quarter(0, 5, 10, 15);
+			quarter(1, 6, 11, 12);
+			quarter(2, 7, 8, 13);
+			quarter(3, 4, 9, 14);
+		}
+
+		for (int i = 0; i < 16; ++i) __crypt::store32(m_block + 4 * i, x[i] + m_state[i]);
+		++m_state[12];
+		m_used = 0;
+	}
+
+	LUNARIS_DECL void chacha20::init(const crypt_key& key, const crypt_nonce& nonce, const uint32_t counter)
+	{
+		m_state[0] = 0x61707865; // "expand 32-byte k"
+		m_state[1] = 0x3320646e;
+		m_state[2] = 0x79622d32;
+		m_state[3] = 0x6b206574;
+		for (int i = 0; i < 8; ++i) m_state[4 + i] = __crypt::load32(key.data() + 4 * i);
+		m_state[12] = counter;
+		for (int i = 0; i < 3; ++i) m_state[13 + i] = __crypt::load32(nonce.data() + 4 * i);
+		m_used = 64;
+	}
+
+	LUNARIS_DECL void chacha20::apply(void* data, const size_t len)
+	{
+		unsigned char* p = static_cast<unsigned char*>(data);
+		size_t left = len;
+
+		while (left && m_used < 64) { // leftover from last call
+			*p++ ^= m_block[m_used++];
+			--left;
+		}
+
+		while (left >= 64) { // whole blocks, 8 bytes at a time
+			_next();
+			for (size_t k = 0; k < 64; k += 8) {
+				uint64_t a, b;
+				memcpy(&a, p + k, 8);
+				memcpy(&b, m_block + k, 8);
+				a ^= b;
+				memcpy(p + k, &a, 8);
+			}
+			m_used = 64;
+			p += 64;
+			left -= 64;
+		}
+
+		if (left) {
+			_next();
+			while (left--) *p++ ^= m_block[m_used++];
+		}
+	}
+
+	LUNARIS_DECL void poly1305::_blocks(const unsigned char* m, size_t len, const bool last)
+	{
+		const uint32_t hibit = last ? 0 : (1u << 24);
+		const uint64_t r0 = m_r[0], r1 = m_r[1], r2 = m_r[2], r3 = m_r[3], r4 = m_r[4];
+		const uint64_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+		uint32_t h0 = m_h[0], h1 = m_h[1], h2 = m_h[2], h3 = m_h[3], h4 = m_h[4];
+
+		while (len >= 16) {
+			h0 += (__crypt::load32(m + 0)) & 0x3ffffff;
+			h1 += (__crypt::load32(m + 3) >> 2) & 0x3ffffff;
+			h2 += (__crypt::load32(m + 6) >> 4) & 0x3ffffff;
+			h3 += (__crypt::load32(m + 9) >> 6) & 0x3ffffff;
+			h4 += (__crypt::load32(m + 12) >> 8) | hibit;
+
+			const uint64_t d0 = h0 * r0 + h1 * s4 + h2 * s3 + h3 * s2 + h4 * s1;
+			uint64_t d1 = h0 * r1 + h1 * r0 + h2 * s4 + h3 * s3 + h4 * s2;
+			uint64_t d2 = h0 * r2 + h1 * r1 + h2 * r0 + h3 * s4 + h4 * s3;
+			uint64_t d3 = h0 * r3 + h1 * r2 + h2 * r1 + h3 * r0 + h4 * s4;
+			uint64_t d4 = h0 * r4 + h1 * r3 + h2 * r2 + h3 * r1 + h4 * r0;
+
+			uint32_t c = static_cast<uint32_t>(d0 >> 26); h0 = static_cast<uint32_t>(d0) & 0x3ffffff;
+			d1 += c; c = static_cast<uint32_t>(d1 >> 26); h1 = static_cast<uint32_t>(d1) & 0x3ffffff;
+			d2 += c; c = static_cast<uint32_t>(d2 >> 26); h2 = static_cast<uint32_t>(d2) & 0x3ffffff;
+			d3 += c; c = static_cast<uint32_t>(d3 >> 26); h3 = static_cast<uint32_t>(d3) & 0x3ffffff;
+			d4 += c; c = static_cast<uint32_t>(d4 >> 26); h4 = static_cast<uint32_t>(d4) & 0x3ffffff;
+			h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+			h1 += c;
+
+			m += 16;
+			len -= 16;
+		}
+
+		m_h[0] = h0; m_h[1] = h1; m_h[2] = h2; m_h[3] = h3; m_h[4] = h4;
+	}
+
+	LUNARIS_DECL void poly1305::init(const unsigned char* key)
+	{
+		m_r[0] = (__crypt::load32(key + 0)) & 0x3ffffff; // r is clamped
+		m_r[1] = (__crypt::load32(key + 3) >> 2) & 0x3ffff03;
+		m_r[2] = (__crypt::load32(key + 6) >> 4) & 0x3ffc0ff;
+		m_r[3] = (__crypt::load32(key + 9) >> 6) & 0x3f03fff;
+		m_r[4] = (__crypt::load32(key + 12) >> 8) & 0x00fffff;
+		for (auto& it : m_h) it = 0;
+		for (int i = 0; i < 4; ++i) m_pad[i] = __crypt::load32(key + 16 + 4 * i);
+		m_left = 0;
+	}
+
+	LUNARIS_DECL void poly1305::update(const void* data, size_t len)
+	{
+		const unsigned char* m = static_cast<const unsigned char*>(data);
+
+		if (m_left) {
+			const size_t want = (16 - m_left) < len ? (16 - m_left) : len;
+			memcpy(m_buf + m_left, m, want);
+			m_left += want;
+			m += want;
+			len -= want;
+			if (m_left < 16) return;
+			_blocks(m_buf, 16, false);
+			m_left = 0;
+		}
+
+		if (len >= 16) {
+			const size_t want = len & ~static_cast<size_t>(15);
+			_blocks(m, want, false);
+			m += want;
+			len -= want;
+		}
+
+		if (len) {
+			memcpy(m_buf, m, len);
+			m_left = len;
+		}
+	}
+
+	LUNARIS_DECL crypt_tag poly1305::final()
+	{
+		if (m_left) {
+			m_buf[m_left] = 1;
+			for (size_t i = m_left + 1; i < 16; ++i) m_buf[i] = 0;
+			_blocks(m_buf, 16, true);
+			m_left = 0;
+		}
+
+		uint32_t h0 = m_h[0], h1 = m_h[1], h2 = m_h[2], h3 = m_h[3], h4 = m_h[4];
+		uint32_t c;
+
+		c = h1 >> 26; h1 &= 0x3ffffff;
+		h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+		h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+		h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+		h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+		h1 += c;
+
+		// h - p, take it if it didn't go below zero
+		uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+		uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+		uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+		uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+		uint32_t g4 = h4 + c - (1u << 26);
+
+		uint32_t mask = (g4 >> 31) - 1;
+		g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+		mask = ~mask;
+		h0 = (h0 & mask) | g0;
+		h1 = (h1 & mask) | g1;
+		h2 = (h2 & mask) | g2;
+		h3 = (h3 & mask) | g3;
+		h4 = (h4 & mask) | g4;
+
+		// to 4 x 32 bit, + pad
+		h0 = (h0) | (h1 << 26);
+		h1 = (h1 >> 6) | (h2 << 20);
+		h2 = (h2 >> 12) | (h3 << 14);
+		h3 = (h3 >> 18) | (h4 << 8);
+
+		uint64_t f;
+		f = static_cast<uint64_t>(h0) + m_pad[0]; h0 = static_cast<uint32_t>(f);
+		f = static_cast<uint64_t>(h1) + m_pad[1] + (f >> 32); h1 = static_cast<uint32_t>(f);
+		f = static_cast<uint64_t>(h2) + m_pad[2] + (f >> 32); h2 = static_cast<uint32_t>(f);
+		f = static_cast<uint64_t>(h3) + m_pad[3] + (f >> 32); h3 = static_cast<uint32_t>(f);
+
+		crypt_tag tag;
+		__crypt::store32(tag.data() + 0, h0);
+		__crypt::store32(tag.data() + 4, h1);
+		__crypt::store32(tag.data() + 8, h2);
+		__crypt::store32(tag.data() + 12, h3);
+
+		for (auto& it : m_h) it = 0; // key is one time only
+		for (auto& it : m_r) it = 0;
+		for (auto& it : m_pad) it = 0;
+		return tag;
+	}
+
+	LUNARIS_DECL void chacha20_poly1305::_begin(const crypt_key& key, const crypt_nonce& nonce, const bool encrypt)
+	{
+		unsigned char otk[64]{};
+		m_cipher.init(key, nonce, 0);
+		m_cipher.apply(otk, sizeof(otk)); // block 0 is the poly1305 key, data starts at block 1
+		m_mac.init(otk);
+		memset(otk, 0, sizeof(otk));
+
+		m_aad_len = 0;
+		m_data_len = 0;
+		m_data_started = false;
+		m_encrypt = encrypt;
+	}
+
+	LUNARIS_DECL void chacha20_poly1305::_pad(const uint64_t len)
+	{
+		static const unsigned char zeros[16]{};
+		if (len % 16) m_mac.update(zeros, 16 - static_cast<size_t>(len % 16));
+	}
+
+	LUNARIS_DECL crypt_tag chacha20_poly1305::_final()
+	{
+		if (!m_data_started) {
+			_pad(m_aad_len);
+			m_data_started = true;
+		}
+		_pad(m_data_len);
+
+		unsigned char lens[16];
+		__crypt::store64(lens, m_aad_len);
+		__crypt::store64(lens + 8, m_data_len);
+		m_mac.update(lens, sizeof(lens));
+
+		return m_mac.final();
+	}
+
+	LUNARIS_DECL void chacha20_poly1305::begin_encrypt(const crypt_key& key, const crypt_nonce& nonce)
+	{
+		_begin(key, nonce, true);
+	}
+
+	LUNARIS_DECL void chacha20_poly1305::begin_decrypt(const crypt_key& key, const crypt_nonce& nonce)
+	{
+		_begin(key, nonce, false);
+	}
+
+	LUNARIS_DECL bool chacha20_poly1305::aad(const void* data, const size_t len)
+	{
+		if (m_data_started) return false;
+		m_mac.update(data, len);
+		m_aad_len += len;
+		return true;
+	}
+
+	LUNARIS_DECL void chacha20_poly1305::update(void* data, const size_t len)
+	{
+		if (!m_data_started) {
+			_pad(m_aad_len);
+			m_data_started = true;
+		}
+
+		if (m_encrypt) { // mac is always on the encrypted data
+			m_cipher.apply(data, len);
+			m_mac.update(data, len);
+		}
+		else {
+			m_mac.update(data, len);
+			m_cipher.apply(data, len);
+		}
+		m_data_len += len;
+	}
+
+	LUNARIS_DECL crypt_tag chacha20_poly1305::finish()
+	{
+		return _final();
+	}
+
+	LUNARIS_DECL bool chacha20_poly1305::finish(const crypt_tag& expected)
+	{
+		const crypt_tag got = _final();
+		unsigned char diff = 0;
+		for (size_t i = 0; i < crypt_tag_size; ++i) diff |= got[i] ^ expected[i];
+		return diff == 0;
+	}
+
+	LUNARIS_DECL crypt_tag chacha20_poly1305_encrypt(const crypt_key& key, const crypt_nonce& nonce, void* data, const size_t len, const void* aad, const size_t aad_len)
+	{
+		chacha20_poly1305 ctx;
+		ctx.begin_encrypt(key, nonce);
+		if (aad && aad_len) ctx.aad(aad, aad_len);
+		ctx.update(data, len);
+		return ctx.finish();
+	}
+
+	LUNARIS_DECL bool chacha20_poly1305_decrypt(const crypt_key& key, const crypt_nonce& nonce, void* data, const size_t len, const crypt_tag& tag, const void* aad, const size_t aad_len)
+	{
+		chacha20_poly1305 ctx;
+		ctx.begin_decrypt(key, nonce);
+		if (aad && aad_len) ctx.aad(aad, aad_len);
+		ctx.update(data, len);
+		if (ctx.finish(tag)) return true;
+
+		if (len) memset(data, 0, len); // don't leave unauthenticated plain data around
+		return false;
+	}
+
+	LUNARIS_DECL crypt_key crypt_key_from(const std::string_view secret, const std::string_view salt, const uint32_t iterations)
+	{
+		// HMAC-SHA256 keyed by the secret. Inner and outer states are built once and copied for each round.
+		unsigned char pad[64]{};
+		if (secret.size() > sizeof(pad)) {
+			sha256_hasher hs;
+			hs.update(secret);
+			const auto dg = hs.final_bytes();
+			memcpy(pad, dg.data(), dg.size());
+		}
+		else if (secret.size()) memcpy(pad, secret.data(), secret.size());
+
+		sha256_hasher inner, outer;
+		for (auto& it : pad) it ^= 0x36;
+		inner.update(pad, sizeof(pad));
+		for (auto& it : pad) it ^= 0x36 ^ 0x5c;
+		outer.update(pad, sizeof(pad));
+		memset(pad, 0, sizeof(pad));
+
+		const auto hmac = [&](const void* a, const size_t a_len, const void* b, const size_t b_len) {
+			sha256_hasher in = inner, out = outer;
+			in.update(a, a_len);
+			if (b_len) in.update(b, b_len);
+			const auto dg = in.final_bytes();
+			out.update(dg.data(), dg.size());
+			return out.final_bytes();
+		};
+
+		// one block is enough, crypt_key is exactly one SHA256 long
+		const unsigned char block_index[4] = { 0, 0, 0, 1 };
+		auto u = hmac(salt.data(), salt.size(), block_index, sizeof(block_index));
+		crypt_key key;
+		memcpy(key.data(), u.data(), key.size());
+
+		for (uint32_t r = 1; r < iterations; ++r) {
+			u = hmac(u.data(), u.size(), nullptr, 0);
+			for (size_t i = 0; i < key.size(); ++i) key[i] ^= u[i];
+		}
+		return key;
+	}
+
+	LUNARIS_DECL crypt_key crypt_random_key()
+	{
+		std::random_device rd;
+		crypt_key key;
+		for (size_t i = 0; i < crypt_key_size; i += 4) __crypt::store32(key.data() + i, rd());
+		return key;
+	}
+
+	LUNARIS_DECL crypt_nonce crypt_random_nonce()
+	{
+		std::random_device rd;
+		crypt_nonce nonce;
+		for (size_t i = 0; i < crypt_nonce_size; i += 4) __crypt::store32(nonce.data() + i, rd());
+		return nonce;
+	}
+
+	LUNARIS_DECL void crypt_seal(const crypt_key& key, std::vector<char>& data)
+	{
+		__crypt::seal(key, data);
+	}
+
+	LUNARIS_DECL void crypt_seal(const crypt_key& key, std::string& data)
+	{
+		__crypt::seal(key, data);
+	}
+
+	LUNARIS_DECL bool crypt_open(const crypt_key& key, std::vector<char>& data)
+	{
+		return __crypt::open(key, data);
+	}
+
+	LUNARIS_DECL bool crypt_open(const crypt_key& key, std::string& data)
+	{
+		return __crypt::open(key, data);
+	}
+
+}
\ No newline at end of file
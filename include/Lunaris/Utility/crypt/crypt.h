@@ -0,0 +1,221 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Utility/hash.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <random>
+#include <cstring>
+#include <stdint.h>
+
+namespace Lunaris {
+
+	constexpr size_t crypt_key_size = 32;
+	constexpr size_t crypt_nonce_size = 12;
+	constexpr size_t crypt_tag_size = 16;
+	constexpr uint32_t crypt_kdf_iterations = 100000; // default PBKDF2 rounds for crypt_key_from
+
+	typedef std::array<unsigned char, crypt_key_size> crypt_key;
+	typedef std::array<unsigned char, crypt_nonce_size> crypt_nonce;
+	typedef std::array<unsigned char, crypt_tag_size> crypt_tag;
+
+	/// <summary>
+	/// <para>ChaCha20 (RFC 8439) key stream. XORs data in place, can be fed in any piece size.</para>
+	/// <para>One key + nonce can do up to 256 GiB (32 bit block counter).</para>
+	/// </summary>
+	class chacha20 {
+		uint32_t m_state[16]{};
+		unsigned char m_block[64]{};
+		size_t m_used = 64; // bytes used from m_block
+
+		void _next(); // m_block = block(m_state), counter++
+	public:
+		/// <summary>
+		/// <para>Set key, nonce and starting block counter.</para>
+		/// </summary>
+		/// <param name="{crypt_key}">Key.</param>
+		/// <param name="{crypt_nonce}">Nonce (never reuse one with the same key).</param>
+		/// <param name="{uint32_t}">Block counter.</param>
+		void init(const crypt_key&, const crypt_nonce&, const uint32_t = 0);
+
+		/// <summary>
+		/// <para>XOR the key stream into data (encrypt and decrypt are the same).</para>
+		/// </summary>
+		/// <param name="{void*}">Data (changed in place).</param>
+		/// <param name="{size_t}">Size.</param>
+		void apply(void*, const size_t);
+	};
+
+	/// <summary>
+	/// <para>Poly1305 (RFC 8439) one time authenticator. Can be fed in any piece size.</para>
+	/// </summary>
+	class poly1305 {
+		uint32_t m_r[5]{};
+		uint32_t m_h[5]{};
+		uint32_t m_pad[4]{};
+		unsigned char m_buf[16]{};
+		size_t m_left = 0;
+
+		void _blocks(const unsigned char*, size_t, const bool);
+	public:
+		/// <summary>
+		/// <para>Start with a one time key (32 bytes).</para>
+		/// </summary>
+		/// <param name="{unsigned char*}">Key (32 bytes).</param>
+		void init(const unsigned char*);
+
+		/// <summary>
+		/// <para>Add data.</para>
+		/// </summary>
+		/// <param name="{void*}">Data.</param>
+		/// <param name="{size_t}">Size.</param>
+		void update(const void*, size_t);
+
+		/// <summary>
+		/// <para>Get the tag. Call init again before reusing it.</para>
+		/// </summary>
+		/// <returns>{crypt_tag} The tag.</returns>
+		crypt_tag final();
+	};
+
+	/// <summary>
+	/// <para>ChaCha20-Poly1305 AEAD (RFC 8439), streaming and in place.</para>
+	/// <para>begin_encrypt or begin_decrypt, aad (optional, before data), update as many times as you want, then finish.</para>
+	/// <para>NOTE: when decrypting in pieces, data is given back BEFORE the tag is checked. Don't trust (or use) any of it unless finish returns true.</para>
+	/// </summary>
+	class chacha20_poly1305 {
+		chacha20 m_cipher;
+		poly1305 m_mac;
+		uint64_t m_aad_len = 0;
+		uint64_t m_data_len = 0;
+		bool m_data_started = false;
+		bool m_encrypt = true;
+
+		void _begin(const crypt_key&, const crypt_nonce&, const bool);
+		void _pad(const uint64_t); // zeros to 16 bytes boundary into mac
+		crypt_tag _final();
+	public:
+		/// <summary>
+		/// <para>Start encrypting.</para>
+		/// </summary>
+		/// <param name="{crypt_key}">Key.</param>
+		/// <param name="{crypt_nonce}">Nonce (never reuse one with the same key).</param>
+		void begin_encrypt(const crypt_key&, const crypt_nonce&);
+
+		/// <summary>
+		/// <para>Start decrypting.</para>
+		/// </summary>
+		/// <param name="{crypt_key}">Key.</param>
+		/// <param name="{crypt_nonce}">Nonce used to encrypt.</param>
+		void begin_decrypt(const crypt_key&, const crypt_nonce&);
+
+		/// <summary>
+		/// <para>Additional data that is authenticated but not encrypted (like a header). Only before update.</para>
+		/// </summary>
+		/// <param name="{void*}">Data.</param>
+		/// <param name="{size_t}">Size.</param>
+		/// <returns>{bool} False if data was already processed.</returns>
+		bool aad(const void*, const size_t);
+
+		/// <summary>
+		/// <para>Encrypt or decrypt a piece of data in place.</para>
+		/// </summary>
+		/// <param name="{void*}">Data (changed in place).</param>
+		/// <param name="{size_t}">Size.</param>
+		void update(void*, const size_t);
+
+		/// <summary>
+		/// <para>Finish encrypting.</para>
+		/// </summary>
+		/// <returns>{crypt_tag} Tag to send or store with the data.</returns>
+		crypt_tag finish();
+
+		/// <summary>
+		/// <para>Finish decrypting and check the tag (constant time).</para>
+		/// </summary>
+		/// <param name="{crypt_tag}">Tag stored with the data.</param>
+		/// <returns>{bool} True if data is authentic.</returns>
+		bool finish(const crypt_tag&);
+	};
+
+	/// <summary>
+	/// <para>Encrypt a buffer in place.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{crypt_nonce}">Nonce (never reuse one with the same key).</param>
+	/// <param name="{void*}">Data (changed in place).</param>
+	/// <param name="{size_t}">Size.</param>
+	/// <param name="{void*}">Additional authenticated data (optional).</param>
+	/// <param name="{size_t}">Additional authenticated data size.</param>
+	/// <returns>{crypt_tag} Tag to keep with the data.</returns>
+	crypt_tag chacha20_poly1305_encrypt(const crypt_key&, const crypt_nonce&, void*, const size_t, const void* = nullptr, const size_t = 0);
+
+	/// <summary>
+	/// <para>Decrypt a buffer in place. If the tag doesn't match, data is wiped.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{crypt_nonce}">Nonce used to encrypt.</param>
+	/// <param name="{void*}">Data (changed in place).</param>
+	/// <param name="{size_t}">Size.</param>
+	/// <param name="{crypt_tag}">Tag stored with the data.</param>
+	/// <param name="{void*}">Additional authenticated data (optional).</param>
+	/// <param name="{size_t}">Additional authenticated data size.</param>
+	/// <returns>{bool} True if data is authentic (and decrypted).</returns>
+	bool chacha20_poly1305_decrypt(const crypt_key&, const crypt_nonce&, void*, const size_t, const crypt_tag&, const void* = nullptr, const size_t = 0);
+
+	/// <summary>
+	/// <para>Get a key from a secret (password, game id...) and a salt with PBKDF2-HMAC-SHA256 (RFC 8018).</para>
+	/// <para>Slow on purpose: more iterations make guessing passwords more expensive. Use a random salt per user/file and store it with the data.</para>
+	/// </summary>
+	/// <param name="{std::string_view}">Secret.</param>
+	/// <param name="{std::string_view}">Salt (optional, but a password without salt is much weaker).</param>
+	/// <param name="{uint32_t}">Iterations (at least 1).</param>
+	/// <returns>{crypt_key} Key.</returns>
+	crypt_key crypt_key_from(const std::string_view, const std::string_view = {}, const uint32_t = crypt_kdf_iterations);
+
+	/// <summary>
+	/// <para>Random key from the system random device.</para>
+	/// </summary>
+	/// <returns>{crypt_key} Key.</returns>
+	crypt_key crypt_random_key();
+
+	/// <summary>
+	/// <para>Random nonce from the system random device. Good for sealing with the same key many times.</para>
+	/// </summary>
+	/// <returns>{crypt_nonce} Nonce.</returns>
+	crypt_nonce crypt_random_nonce();
+
+	/// <summary>
+	/// <para>Encrypt a whole buffer in place (like a save file). Result is nonce + data + tag, using a random nonce.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{std::vector&lt;char&gt;}">Data (becomes the sealed data).</param>
+	void crypt_seal(const crypt_key&, std::vector<char>&);
+
+	/// <summary>
+	/// <para>Encrypt a whole buffer in place (like a save file). Result is nonce + data + tag, using a random nonce.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{std::string}">Data (becomes the sealed data).</param>
+	void crypt_seal(const crypt_key&, std::string&);
+
+	/// <summary>
+	/// <para>Open data sealed with crypt_seal, in place.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{std::vector&lt;char&gt;}">Sealed data (becomes the original data, or empty if it failed).</param>
+	/// <returns>{bool} True if data is authentic.</returns>
+	bool crypt_open(const crypt_key&, std::vector<char>&);
+
+	/// <summary>
+	/// <para>Open data sealed with crypt_seal, in place.</para>
+	/// </summary>
+	/// <param name="{crypt_key}">Key.</param>
+	/// <param name="{std::string}">Sealed data (becomes the original data, or empty if it failed).</param>
+	/// <returns>{bool} True if data is authentic.</returns>
+	bool crypt_open(const crypt_key&, std::string&);
+
+}
\ No newline at end of file
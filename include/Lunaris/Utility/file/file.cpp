@@ -272,6 +272,175 @@ namespace Lunaris {
 		}
 	}
 
+	LUNARIS_DECL void mmapfile::_unmap()
+	{
+#ifdef _WIN32
+		if (m_data) UnmapViewOfFile(m_data);
+		if (m_hmap) CloseHandle(m_hmap);
+		if (m_hfile != INVALID_HANDLE_VALUE) CloseHandle(m_hfile);
+		m_hmap = nullptr;
+		m_hfile = INVALID_HANDLE_VALUE;
+#else
+		if (m_data) munmap(m_data, m_len);
+#endif
+		m_data = nullptr;
+		m_len = 0;
+		m_cow = false;
+	}
+
+	LUNARIS_DECL mmapfile::mmapfile(mmapfile&& oth) noexcept
+		: file(std::move(oth)), m_data(oth.m_data), m_len(oth.m_len), m_cow(oth.m_cow)
+#ifdef _WIN32
+		, m_hfile(oth.m_hfile), m_hmap(oth.m_hmap)
+#endif
+	{
+		oth.m_data = nullptr;
+		oth.m_len = 0;
+#ifdef _WIN32
+		oth.m_hfile = INVALID_HANDLE_VALUE;
+		oth.m_hmap = nullptr;
+#endif
+	}
+
+	LUNARIS_DECL void mmapfile::operator=(mmapfile&& oth) noexcept
+	{
+		close();
+
+		this->file::operator=(std::move(oth));
+		m_data = oth.m_data;
+		m_len = oth.m_len;
+		m_cow = oth.m_cow;
+#ifdef _WIN32
+		m_hfile = oth.m_hfile;
+		m_hmap = oth.m_hmap;
+		oth.m_hfile = INVALID_HANDLE_VALUE;
+		oth.m_hmap = nullptr;
+#endif
+
+		oth.fp = nullptr;
+		oth.m_data = nullptr;
+		oth.m_len = 0;
+	}
+
+	LUNARIS_DECL mmapfile::~mmapfile()
+	{
+		close();
+	}
+
+	LUNARIS_DECL bool mmapfile::open(const std::string& pth, const bool cow)
+	{
+		__file_allegro_start();
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		if (fp) PRINT_DEBUG("Opening mmapfile %p (was %p) <- '%s' (cow: %d)", this, fp.get(), pth.c_str(), (int)cow);
+		else PRINT_DEBUG("Opening mmapfile %p <- '%s' (cow: %d)", this, pth.c_str(), (int)cow);
+#endif
+
+		close();
+
+#ifdef _WIN32
+		m_hfile = CreateFileA(pth.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_hfile == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER len{};
+		if (!GetFileSizeEx(m_hfile, &len) || len.QuadPart < 0 || static_cast<uint64_t>(len.QuadPart) > static_cast<uint64_t>(SIZE_MAX)) {
+			_unmap();
+			return false;
+		}
+		m_len = static_cast<size_t>(len.QuadPart);
+
+		if (m_len == 0) { // nothing to map (the system doesn't map empty files)
+			CloseHandle(m_hfile);
+			m_hfile = INVALID_HANDLE_VALUE;
+		}
+		else {
+			m_hmap = CreateFileMappingA(m_hfile, nullptr, cow ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+			if (!m_hmap) {
+				_unmap();
+				return false;
+			}
+
+			m_data = static_cast<char*>(MapViewOfFile(m_hmap, cow ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+			if (!m_data) {
+				_unmap();
+				return false;
+			}
+		}
+#else
+		const int fd = ::open(pth.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return false;
+
+		struct stat st {};
+		if (fstat(fd, &st) != 0 || st.st_size < 0) {
+			::close(fd);
+			return false;
+		}
+		m_len = static_cast<size_t>(st.st_size);
+
+		if (m_len != 0) { // mmap fails on empty files, there is nothing to map anyway
+			void* ptr = mmap(nullptr, m_len, cow ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+			if (ptr == MAP_FAILED) {
+				::close(fd);
+				m_len = 0;
+				return false;
+			}
+			m_data = static_cast<char*>(ptr);
+		}
+		::close(fd); // the mapping keeps the file
+#endif
+		m_cow = cow;
+
+		// memfiles can't be empty: an empty file is opened as is (reads are EOF, size is 0)
+		if (m_len == 0) this->fp = std::unique_ptr<ALLEGRO_FILE, bool(*)(ALLEGRO_FILE*)>(al_fopen(pth.c_str(), "rb"), al_fclose);
+		else this->fp = std::unique_ptr<ALLEGRO_FILE, bool(*)(ALLEGRO_FILE*)>(al_open_memfile(m_data, static_cast<int64_t>(m_len), cow ? "rw" : "r"), al_fclose);
+		if (!this->fp) {
+			_unmap();
+			return false;
+		}
+		this->path = pth;
+
+#ifdef LUNARIS_VERBOSE_BUILD
+		PRINT_DEBUG("Good mapped file %p (mmapfile %p) [size %zu]", fp.get(), this, m_len);
+#endif
+
+		return true;
+	}
+
+	LUNARIS_DECL void mmapfile::close()
+	{
+		this->file::close(); // ALLEGRO_FILE first, it points to the mapping
+#ifdef LUNARIS_VERBOSE_BUILD
+		if (m_data) PRINT_DEBUG("Unmapping mmapfile %p", this);
+#endif
+		_unmap();
+	}
+
+	LUNARIS_DECL const char* mmapfile::data() const
+	{
+		return m_data;
+	}
+
+	LUNARIS_DECL char* mmapfile::data_cow()
+	{
+		return m_cow ? m_data : nullptr;
+	}
+
+	LUNARIS_DECL std::string_view mmapfile::view() const
+	{
+		if (!m_data) return {};
+		return std::string_view(m_data, m_len);
+	}
+
+	LUNARIS_DECL std::string_view mmapfile::view(const size_t off, const size_t len) const
+	{
+		if (!m_data || off >= m_len) return {};
+		return std::string_view(m_data + off, (m_len - off) < len ? (m_len - off) : len);
+	}
+
+	LUNARIS_DECL bool mmapfile::is_copy_on_write() const
+	{
+		return m_cow;
+	}
 
 #if (_MSC_VER && _WIN32)
 	LUNARIS_DECL tempfile get_executable_resource_as_file(const int id, const WinString& type, const std::string& extn)
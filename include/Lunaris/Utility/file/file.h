@@ -8,8 +8,14 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <string_view>
 #if (_WIN32)
 #include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 namespace Lunaris {
@@ -71,6 +77,7 @@ namespace Lunaris {
 		std::string transl(const open_mode_e&);
 
 		friend class font; // font has to be able to "own" the file.
+		friend class track_stream; // same for audio streams.
 
 		/// <summary>
 		/// <para>in very very specific cases sometimes you don't want the ALLEGRO_FILE to be destroyed. This unset/set current rule. Default is to destroy.</para>
@@ -299,6 +306,102 @@ namespace Lunaris {
 		using file::empty;
 	};
 
+	/// <summary>
+	/// <para>A file mapped in memory (read only or copy-on-write). No copy to a private buffer: reads come straight from the system page cache.</para>
+	/// <para>It is still a file (ALLEGRO_FILE over the mapping), so it can be loaded by texture, font and so on directly (as hybrid_memory&lt;file&gt;).</para>
+	/// <para>NOTE: The size is fixed while mapped. An empty file opens fine as an empty mapping (data() is null, view() is empty).</para>
+	/// </summary>
+	class mmapfile : public file {
+		char* m_data = nullptr;
+		size_t m_len = 0;
+		bool m_cow = false;
+#ifdef _WIN32
+		HANDLE m_hfile = INVALID_HANDLE_VALUE;
+		HANDLE m_hmap = nullptr;
+#endif
+
+		void _unmap();
+	public:
+		mmapfile() = default;
+
+		/// <summary>
+		/// <para>Move a mmapfile handler to this.</para>
+		/// </summary>
+		/// <param name="{mmapfile}">The mmapfile being moved.</param>
+		mmapfile(mmapfile&&) noexcept;
+
+		/// <summary>
+		/// <para>Move a mmapfile handler to this.</para>
+		/// <para>If this had file, it is closed and unmapped automatically.</para>
+		/// </summary>
+		/// <param name="{mmapfile}">The mmapfile being moved.</param>
+		void operator=(mmapfile&&) noexcept;
+
+		/// <summary>
+		/// <para>Closes the mmapfile handle and unmaps it.</para>
+		/// </summary>
+		~mmapfile();
+
+		/// <summary>
+		/// <para>Map a file in memory.</para>
+		/// <para>Copy-on-write allows changing the data (and writing to the file handle), but changes are private and never reach the disk.</para>
+		/// </summary>
+		/// <param name="{std::string}">File path.</param>
+		/// <param name="{bool}">Copy-on-write?</param>
+		/// <returns>{bool} True if success.</returns>
+		bool open(const std::string&, const bool = false);
+
+		/// <summary>
+		/// <para>Close and unmap.</para>
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// <para>The mapped data.</para>
+		/// </summary>
+		/// <returns>{const char*} Start of the data (null if not open or empty).</returns>
+		const char* data() const;
+
+		/// <summary>
+		/// <para>The mapped data, if copy-on-write.</para>
+		/// </summary>
+		/// <returns>{char*} Start of the data (null if not open, empty or read only).</returns>
+		char* data_cow();
+
+		/// <summary>
+		/// <para>The whole mapped data as a view.</para>
+		/// </summary>
+		/// <returns>{std::string_view} The data (empty if not open).</returns>
+		std::string_view view() const;
+
+		/// <summary>
+		/// <para>Part of the mapped data as a view (limited to the end).</para>
+		/// </summary>
+		/// <param name="{size_t}">Offset.</param>
+		/// <param name="{size_t}">Length.</param>
+		/// <returns>{std::string_view} The data.</returns>
+		std::string_view view(const size_t, const size_t) const;
+
+		/// <summary>
+		/// <para>Is this copy-on-write?</para>
+		/// </summary>
+		/// <returns>{bool} True if data can be changed.</returns>
+		bool is_copy_on_write() const;
+
+		using file::get_path;
+		using file::get_fp;
+		using file::operator ALLEGRO_FILE*;
+		using file::read;
+		using file::write;
+		using file::tell;
+		using file::seek;
+		using file::flush;
+		using file::size;
+		using file::is_open;
+		using file::valid;
+		using file::empty;
+	};
+
 #ifdef _WIN32 // && _MSC_VER
 
 	/// <summary>
@@ -2,24 +2,55 @@
 
 namespace Lunaris {
 
-    LUNARIS_DECL void _SHA256::transform(const unsigned char* message, unsigned int block_nb)
+    LUNARIS_DECL std::atomic<sha256_kernel_e>* __sha256_kernels()
+    {
+        static std::atomic<sha256_kernel_e> kernels[2] = {
+            { sha256_supports(sha256_kernel_e::SHA_NI) ? sha256_kernel_e::SHA_NI : sha256_kernel_e::SCALAR },
+            { sha256_supports(sha256_kernel_e::SHA_NI) ? sha256_kernel_e::SHA_NI : (sha256_supports(sha256_kernel_e::AVX2) ? sha256_kernel_e::AVX2 : sha256_kernel_e::SCALAR) } // SHA_NI one by one still beats 8 AVX2 lanes
+        };
+        return kernels;
+    }
+
+    LUNARIS_DECL std::string __sha256_hex(const unsigned char* digest)
+    {
+        static const char hex[] = "0123456789abcdef";
+        std::string buf(2 * _SHA256::DIGEST_SIZE, '0');
+        for (size_t i = 0; i < _SHA256::DIGEST_SIZE; i++) {
+            buf[i * 2] = hex[digest[i] >> 4];
+            buf[i * 2 + 1] = hex[digest[i] & 0xF];
+        }
+        return buf;
+    }
+
+    LUNARIS_DECL void _SHA256::transform(const unsigned char* message, size_t block_nb)
+    {
+#ifdef LUNARIS_HASH_X86
+        if (m_kernel == sha256_kernel_e::SHA_NI) {
+            transform_shani(m_h, message, block_nb);
+            return;
+        }
+#endif
+        transform_scalar(m_h, message, block_nb);
+    }
+
+    LUNARIS_DECL void _SHA256::transform_scalar(uint32* state, const unsigned char* message, size_t block_nb)
     {
         uint32 w[64]{};
         uint32 wv[8]{};
         uint32 t1, t2;
         const unsigned char* sub_block;
-        for (__int64 i = 0; i < (__int64)block_nb; i++) {
+        for (size_t i = 0; i < block_nb; i++) {
             sub_block = message + (i << 6);
-            for (__int64 j = 0; j < 16; j++) {
+            for (size_t j = 0; j < 16; j++) {
                 SHA2_PACK32(&sub_block[j << 2], &w[j]);
             }
-            for (__int64 j = 16; j < 64; j++) {
+            for (size_t j = 16; j < 64; j++) {
                 w[j] = SHA256_F4(w[j - 2]) + w[j - 7] + SHA256_F3(w[j - 15]) + w[j - 16];
             }
-            for (__int64 j = 0; j < 8; j++) {
-                wv[j] = m_h[j];
+            for (size_t j = 0; j < 8; j++) {
+                wv[j] = state[j];
             }
-            for (__int64 j = 0; j < 64; j++) {
+            for (size_t j = 0; j < 64; j++) {
                 t1 = wv[7] + SHA256_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
                     + sha256_k[j] + w[j];
                 t2 = SHA256_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
@@ -32,12 +63,183 @@ namespace Lunaris {
                 wv[1] = wv[0];
                 wv[0] = t1 + t2;
             }
-            for (__int64 j = 0; j < 8; j++) {
-                m_h[j] += wv[j];
+            for (size_t j = 0; j < 8; j++) {
+                state[j] += wv[j];
             }
         }
     }
 
+#ifdef LUNARIS_HASH_X86
+    // Based on the SHA extensions reference flow (Intel's "Intel SHA Extensions" paper): 4 rounds per step, state kept as ABEF/CDGH.
+    LUNARIS_DECL LUNARIS_HASH_TARGET("sha,sse4.1,ssse3") void _SHA256::transform_shani(uint32* state, const unsigned char* message, size_t block_nb)
+    {
+        const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL); // big endian words
+
+        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1); // CDAB
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B); // EFGH
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+        for (size_t b = 0; b < block_nb; ++b, message += SHA224_256_BLOCK_SIZE) {
+            const __m128i abef = state0;
+            const __m128i cdgh = state1;
+            __m128i w[4];
+
+            for (int g = 0; g < 16; ++g) { // 4 rounds each
+                if (g < 4) w[g] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(message + 16 * g)), mask);
+                else {
+                    __m128i& cur = w[g & 3]; // holds w[g - 4] until replaced
+                    cur = _mm_sha256msg1_epu32(cur, w[(g - 3) & 3]);
+                    cur = _mm_add_epi32(cur, _mm_alignr_epi8(w[(g - 1) & 3], w[(g - 2) & 3], 4));
+                    cur = _mm_sha256msg2_epu32(cur, w[(g - 1) & 3]);
+                }
+                __m128i msg = _mm_add_epi32(w[g & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&sha256_k[4 * g])));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+                msg = _mm_shuffle_epi32(msg, 0x0E);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            }
+
+            state0 = _mm_add_epi32(state0, abef);
+            state1 = _mm_add_epi32(state1, cdgh);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+        state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+        state1 = _mm_alignr_epi8(state1, tmp, 8); // HGFE
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+    }
+
+    // 8x8 transpose of 32 bit words: in[lane] (words 0..7) -> out[word] (lanes 0..7)
+    LUNARIS_DECL LUNARIS_HASH_TARGET("avx2") void __sha256_transpose_avx2(const __m256i* in, __m256i* out)
+    {
+        const __m256i t0 = _mm256_unpacklo_epi32(in[0], in[1]), t1 = _mm256_unpackhi_epi32(in[0], in[1]);
+        const __m256i t2 = _mm256_unpacklo_epi32(in[2], in[3]), t3 = _mm256_unpackhi_epi32(in[2], in[3]);
+        const __m256i t4 = _mm256_unpacklo_epi32(in[4], in[5]), t5 = _mm256_unpackhi_epi32(in[4], in[5]);
+        const __m256i t6 = _mm256_unpacklo_epi32(in[6], in[7]), t7 = _mm256_unpackhi_epi32(in[6], in[7]);
+        const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+        const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+        const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+        const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+        out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+        out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+        out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+        out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+        out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+        out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+        out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+        out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+    }
+
+    // Eight independent messages, one per 32 bit lane. A lane takes the next message as soon as its current one ends.
+    LUNARIS_DECL LUNARIS_HASH_TARGET("avx2") void _SHA256::multi_avx2(const std::string_view* messages, const size_t count, std::array<unsigned char, DIGEST_SIZE>* digests)
+    {
+        struct lane {
+            const unsigned char* data = nullptr;
+            size_t full = 0; // blocks read directly from data
+            size_t total = 0; // full + padded tail blocks
+            size_t done = 0;
+            size_t index = 0; // message index
+            bool active = false;
+            unsigned char tail[2 * SHA224_256_BLOCK_SIZE];
+        };
+        static const unsigned char zero_block[SHA224_256_BLOCK_SIZE]{};
+        static const uint32 iv[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+        lane lanes[8];
+        alignas(32) uint32 st[8][8]; // [word][lane]
+        size_t next = 0;
+
+        const auto take = [&](const size_t l) {
+            lane& ln = lanes[l];
+            ln.active = next < count;
+            if (!ln.active) return;
+
+            const std::string_view& msg = messages[next];
+            const size_t rem = msg.size() % SHA224_256_BLOCK_SIZE;
+            const size_t tail_blocks = (rem + 9 <= SHA224_256_BLOCK_SIZE) ? 1 : 2;
+            const uint64 bits = static_cast<uint64>(msg.size()) << 3;
+
+            ln.data = reinterpret_cast<const unsigned char*>(msg.data());
+            ln.full = msg.size() / SHA224_256_BLOCK_SIZE;
+            ln.total = ln.full + tail_blocks;
+            ln.done = 0;
+            ln.index = next++;
+
+            memset(ln.tail, 0, sizeof(ln.tail));
+            if (rem) memcpy(ln.tail, ln.data + ln.full * SHA224_256_BLOCK_SIZE, rem);
+            ln.tail[rem] = 0x80;
+            for (size_t k = 0; k < 8; ++k) ln.tail[tail_blocks * SHA224_256_BLOCK_SIZE - 1 - k] = static_cast<unsigned char>(bits >> (8 * k));
+
+            for (size_t k = 0; k < 8; ++k) st[k][l] = iv[k];
+        };
+
+        for (size_t l = 0; l < 8; ++l) take(l);
+
+        const __m256i bswap = _mm256_set_epi8(
+            12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+            12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+        for (size_t active = count < 8 ? count : 8; active > 0;) {
+            __m256i rows[2][8];
+            for (size_t l = 0; l < 8; ++l) {
+                const lane& ln = lanes[l];
+                const unsigned char* blk = !ln.active ? zero_block :
+                    (ln.done < ln.full ? ln.data + ln.done * SHA224_256_BLOCK_SIZE : ln.tail + (ln.done - ln.full) * SHA224_256_BLOCK_SIZE);
+                rows[0][l] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(blk)), bswap);
+                rows[1][l] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(blk + 32)), bswap);
+            }
+
+            __m256i w[16];
+            __sha256_transpose_avx2(rows[0], w);
+            __sha256_transpose_avx2(rows[1], w + 8);
+
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[0])), b = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[1]));
+            __m256i c = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[2])), d = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[3]));
+            __m256i e = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[4])), f = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[5]));
+            __m256i g = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[6])), h = _mm256_load_si256(reinterpret_cast<const __m256i*>(st[7]));
+
+            for (int t = 0; t < 64; ++t) {
+                if (t >= 16) {
+                    const __m256i w2 = w[(t - 2) & 15], w15 = w[(t - 15) & 15];
+                    const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(SHA2_ROTR8(w2, 17), SHA2_ROTR8(w2, 19)), _mm256_srli_epi32(w2, 10));
+                    const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(SHA2_ROTR8(w15, 7), SHA2_ROTR8(w15, 18)), _mm256_srli_epi32(w15, 3));
+                    w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+                }
+                const __m256i bs1 = _mm256_xor_si256(_mm256_xor_si256(SHA2_ROTR8(e, 6), SHA2_ROTR8(e, 11)), SHA2_ROTR8(e, 25));
+                const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, bs1), _mm256_add_epi32(ch, w[t & 15])), _mm256_set1_epi32(static_cast<int>(sha256_k[t])));
+                const __m256i bs0 = _mm256_xor_si256(_mm256_xor_si256(SHA2_ROTR8(a, 2), SHA2_ROTR8(a, 13)), SHA2_ROTR8(a, 22));
+                const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+                const __m256i t2 = _mm256_add_epi32(bs0, maj);
+                h = g; g = f; f = e;
+                e = _mm256_add_epi32(d, t1);
+                d = c; c = b; b = a;
+                a = _mm256_add_epi32(t1, t2);
+            }
+
+            const __m256i res[8] = { a, b, c, d, e, f, g, h };
+            for (size_t k = 0; k < 8; ++k) {
+                __m256i* dst = reinterpret_cast<__m256i*>(st[k]);
+                _mm256_store_si256(dst, _mm256_add_epi32(_mm256_load_si256(dst), res[k]));
+            }
+
+            for (size_t l = 0; l < 8; ++l) {
+                lane& ln = lanes[l];
+                if (!ln.active || ++ln.done < ln.total) continue;
+
+                unsigned char* out = digests[ln.index].data();
+                for (size_t k = 0; k < 8; ++k) SHA2_UNPACK32(st[k][l], &out[k << 2]);
+
+                take(l);
+                if (!ln.active) --active;
+            }
+        }
+    }
+#endif
+
     LUNARIS_DECL void _SHA256::init()
     {
         m_h[0] = 0x6a09e667;
@@ -50,18 +252,25 @@ namespace Lunaris {
         m_h[7] = 0x5be0cd19;
         m_len = 0;
         m_tot_len = 0;
+        m_kernel = __sha256_kernels()[0];
     }
 
-    LUNARIS_DECL void _SHA256::update(const unsigned char* message, unsigned int len)
+    LUNARIS_DECL void _SHA256::init(const sha256_kernel_e kernel)
     {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
+        init();
+        m_kernel = kernel;
+    }
+
+    LUNARIS_DECL void _SHA256::update(const unsigned char* message, size_t len)
+    {
+        size_t block_nb, new_len;
+        unsigned int rem_len, tmp_len;
         const unsigned char* shifted_message;
         tmp_len = SHA224_256_BLOCK_SIZE - m_len;
-        rem_len = len < tmp_len ? len : tmp_len;
+        rem_len = len < tmp_len ? static_cast<unsigned int>(len) : tmp_len;
         memcpy(&m_block[m_len], message, rem_len);
         if (m_len + len < SHA224_256_BLOCK_SIZE) {
-            m_len += len;
+            m_len += static_cast<unsigned int>(len);
             return;
         }
         new_len = len - rem_len;
@@ -69,17 +278,17 @@ namespace Lunaris {
         shifted_message = message + rem_len;
         transform(m_block, 1);
         transform(shifted_message, block_nb);
-        rem_len = new_len % SHA224_256_BLOCK_SIZE;
+        rem_len = static_cast<unsigned int>(new_len % SHA224_256_BLOCK_SIZE);
         memcpy(m_block, &shifted_message[block_nb << 6], rem_len);
         m_len = rem_len;
-        m_tot_len += (block_nb + 1) << 6;
+        m_tot_len += static_cast<uint64>(block_nb + 1) << 6;
     }
 
     LUNARIS_DECL void _SHA256::final(unsigned char* digest)
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64 len_b;
         int i;
         block_nb = (1 + ((SHA224_256_BLOCK_SIZE - 9)
             < (m_len % SHA224_256_BLOCK_SIZE)));
@@ -87,61 +296,184 @@ namespace Lunaris {
         pm_len = block_nb << 6;
         memset(m_block + m_len, 0, static_cast<size_t>(pm_len) - static_cast<size_t>(m_len));
         m_block[m_len] = 0x80;
-        SHA2_UNPACK32(len_b, m_block + pm_len - 4);
+        SHA2_UNPACK32(static_cast<uint32>(len_b >> 32), m_block + pm_len - 8);
+        SHA2_UNPACK32(static_cast<uint32>(len_b), m_block + pm_len - 4);
         transform(m_block, block_nb);
         for (i = 0; i < 8; i++) {
             SHA2_UNPACK32(m_h[i], &digest[i << 2]);
         }
     }
 
-    LUNARIS_DECL std::string sha256(const std::string& input)
+    LUNARIS_DECL bool sha256_supports(const sha256_kernel_e kernel)
+    {
+#ifdef LUNARIS_HASH_X86
+        static const std::array<bool, 2> cpu = [] { // SHA, AVX2
+            unsigned int l1[4]{}, l7[4]{}; // eax, ebx, ecx, edx
+            unsigned long long xcr0 = 0;
+#if defined(_MSC_VER)
+            int r[4];
+            __cpuid(r, 0);
+            const unsigned int top = static_cast<unsigned int>(r[0]);
+            __cpuidex(r, 1, 0);
+            for (int k = 0; k < 4; ++k) l1[k] = static_cast<unsigned int>(r[k]);
+            if (top >= 7) {
+                __cpuidex(r, 7, 0);
+                for (int k = 0; k < 4; ++k) l7[k] = static_cast<unsigned int>(r[k]);
+            }
+            if (l1[2] & (1u << 27)) xcr0 = _xgetbv(0);
+#else
+            const unsigned int top = __get_cpuid_max(0, nullptr);
+            __cpuid_count(1, 0, l1[0], l1[1], l1[2], l1[3]);
+            if (top >= 7) __cpuid_count(7, 0, l7[0], l7[1], l7[2], l7[3]);
+            if (l1[2] & (1u << 27)) {
+                unsigned int lo, hi;
+                __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+                xcr0 = (static_cast<unsigned long long>(hi) << 32) | lo;
+            }
+#endif
+            const bool ssse3 = (l1[2] & (1u << 9)) != 0;
+            const bool sse41 = (l1[2] & (1u << 19)) != 0;
+            const bool avx_os = (l1[2] & (1u << 28)) != 0 && (xcr0 & 0x6) == 0x6; // AVX and the OS saves YMM registers
+            return std::array<bool, 2>{ ssse3 && sse41 && (l7[1] & (1u << 29)) != 0, avx_os && (l7[1] & (1u << 5)) != 0 };
+        }();
+#endif
+
+        switch (kernel) {
+        case sha256_kernel_e::SCALAR:
+            return true;
+#ifdef LUNARIS_HASH_X86
+        case sha256_kernel_e::SHA_NI:
+            return cpu[0];
+        case sha256_kernel_e::AVX2:
+            return cpu[1];
+#endif
+        default:
+            return false;
+        }
+    }
+
+    LUNARIS_DECL sha256_kernel_e sha256_kernel()
     {
-        unsigned char digest[_SHA256::DIGEST_SIZE];
-        memset(digest, 0, _SHA256::DIGEST_SIZE);
+        return __sha256_kernels()[0];
+    }
 
-        std::basic_string<unsigned char> conv;
-        for (auto& i : input) conv += static_cast<unsigned char>(i);
+    LUNARIS_DECL bool sha256_use_kernel(const sha256_kernel_e kernel)
+    {
+        if (kernel == sha256_kernel_e::AVX2 || !sha256_supports(kernel)) return false;
+        __sha256_kernels()[0] = kernel;
+        return true;
+    }
 
-        _SHA256 ctx = _SHA256();
-        ctx.init();
-        ctx.update(conv.c_str(), static_cast<unsigned int>(conv.length()));
-        ctx.final(digest);
+    LUNARIS_DECL sha256_kernel_e sha256_multi_kernel()
+    {
+        return __sha256_kernels()[1];
+    }
 
-        char buf[2 * _SHA256::DIGEST_SIZE + 1]{};
-        buf[2 * _SHA256::DIGEST_SIZE] = 0;
-        for (int i = 0; i < _SHA256::DIGEST_SIZE; i++)
-            sprintf_s(buf + (long long)i * 2, 2 * _SHA256::DIGEST_SIZE + 1 - ((long long)i * 2), "%02x", digest[i]);
-        return std::string(buf);
+    LUNARIS_DECL bool sha256_use_multi_kernel(const sha256_kernel_e kernel)
+    {
+        if (!sha256_supports(kernel)) return false;
+        __sha256_kernels()[1] = kernel;
+        return true;
     }
 
-    LUNARIS_DECL std::string sha256(const std::vector<char>& input)
+    LUNARIS_DECL void sha256_multi(const std::string_view* messages, const size_t count, std::array<unsigned char, _SHA256::DIGEST_SIZE>* digests)
     {
-        unsigned char digest[_SHA256::DIGEST_SIZE];
-        memset(digest, 0, _SHA256::DIGEST_SIZE);
+        const sha256_kernel_e kernel = __sha256_kernels()[1];
+#ifdef LUNARIS_HASH_X86
+        if (kernel == sha256_kernel_e::AVX2) {
+            _SHA256::multi_avx2(messages, count, digests);
+            return;
+        }
+#endif
+        _SHA256 ctx;
+        for (size_t i = 0; i < count; ++i) {
+            ctx.init(kernel);
+            ctx.update(reinterpret_cast<const unsigned char*>(messages[i].data()), messages[i].size());
+            ctx.final(digests[i].data());
+        }
+    }
 
-        std::basic_string<unsigned char> conv;
-        for (auto& i : input) conv += static_cast<unsigned char>(i);
+    LUNARIS_DECL std::vector<std::string> sha256_multi(const std::vector<std::string_view>& messages)
+    {
+        std::vector<std::array<unsigned char, _SHA256::DIGEST_SIZE>> digests(messages.size());
+        sha256_multi(messages.data(), messages.size(), digests.data());
 
-        _SHA256 ctx = _SHA256();
-        ctx.init();
-        ctx.update(conv.c_str(), static_cast<unsigned int>(conv.length()));
-        ctx.final(digest);
+        std::vector<std::string> res;
+        res.reserve(messages.size());
+        for (const auto& it : digests) res.push_back(__sha256_hex(it.data()));
+        return res;
+    }
 
-        char buf[2 * _SHA256::DIGEST_SIZE + 1]{};
-        buf[2 * _SHA256::DIGEST_SIZE] = 0;
-        for (int i = 0; i < _SHA256::DIGEST_SIZE; i++)
-            sprintf_s(buf + (long long)i * 2, 2 * _SHA256::DIGEST_SIZE + 1 - ((long long)i * 2), "%02x", digest[i]);
-        return std::string(buf);
+    LUNARIS_DECL sha256_hasher::sha256_hasher()
+    {
+        m_ctx.init();
+    }
+
+    LUNARIS_DECL void sha256_hasher::init()
+    {
+        m_ctx.init();
+    }
+
+    LUNARIS_DECL void sha256_hasher::update(const void* data, const size_t len)
+    {
+        if (len) m_ctx.update(static_cast<const unsigned char*>(data), len);
+    }
+
+    LUNARIS_DECL void sha256_hasher::update(const std::string_view data)
+    {
+        update(data.data(), data.size());
+    }
+
+    LUNARIS_DECL void sha256_hasher::update(const std::vector<char>& data)
+    {
+        update(data.data(), data.size());
+    }
+
+    LUNARIS_DECL std::array<unsigned char, _SHA256::DIGEST_SIZE> sha256_hasher::final_bytes()
+    {
+        std::array<unsigned char, _SHA256::DIGEST_SIZE> digest{};
+        m_ctx.final(digest.data());
+        m_ctx.init();
+        return digest;
+    }
+
+    LUNARIS_DECL std::string sha256_hasher::final()
+    {
+        return __sha256_hex(final_bytes().data());
+    }
+
+    LUNARIS_DECL std::string sha256(const std::string& input)
+    {
+        sha256_hasher ctx;
+        ctx.update(input);
+        return ctx.final();
+    }
+
+    LUNARIS_DECL std::string sha256(const std::vector<char>& input)
+    {
+        sha256_hasher ctx;
+        ctx.update(input);
+        return ctx.final();
     }
 
     LUNARIS_DECL std::string sha256_f(const std::string& fpath)
     {
         FILE* fp = nullptr;
+#ifdef _MSC_VER
         if (fopen_s(&fp, fpath.c_str(), "rb") != 0) return ""; // failed
-        std::string myself;
-        for (char ubuf; fread_s(&ubuf, 1, sizeof(char), 1, fp);) myself += ubuf;
+#else
+        if (!(fp = fopen(fpath.c_str(), "rb"))) return ""; // failed
+#endif
+        setvbuf(fp, nullptr, _IONBF, 0); // reads are already big, no need to copy twice
+
+        std::unique_ptr<unsigned char[]> buf = std::make_unique<unsigned char[]>(sha256_file_buffer);
+        sha256_hasher ctx;
+
+        for (size_t got; (got = fread(buf.get(), 1, sha256_file_buffer, fp)) > 0;) ctx.update(buf.get(), got);
+
+        const bool failed = ferror(fp) != 0;
         fclose(fp);
-        return sha256(myself);
+        return failed ? "" : ctx.final();
     }
 
     LUNARIS_DECL std::string encrypt_one_sum_each(std::string orig, const unsigned char plus)
@@ -5,13 +5,31 @@
 
 #include <stdio.h>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define LUNARIS_HASH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LUNARIS_HASH_TARGET(x)
+#else
+#include <cpuid.h>
+#define LUNARIS_HASH_TARGET(x) __attribute__((target(x)))
+#endif
+#endif
 
 // This was not made by me (the SHA256 part)
 // Source: http://www.zedwood.com/article/cpp-sha256-function (modified)
 
 #define SHA2_SHFR(x, n)    (x >> n)
 #define SHA2_ROTR(x, n)   ((x >> n) | (x << ((sizeof(x) << 3) - n)))
+#define SHA2_ROTR8(x, n)  _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n))) // 8 lanes (AVX2)
 #define SHA2_ROTL(x, n)   ((x << n) | (x >> ((sizeof(x) << 3) - n)))
 #define SHA2_CH(x, y, z)  ((x & y) ^ (~x & z))
 #define SHA2_MAJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
@@ -55,6 +73,21 @@ namespace Lunaris {
      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
     constexpr unsigned int SHA224_256_BLOCK_SIZE = (512 / 8);
 
+    enum class sha256_kernel_e {
+        SCALAR,     // portable, always available
+        SHA_NI,     // x86 SHA extensions, one message at a time
+        AVX2        // 8 messages side by side (sha256_multi only)
+    };
+
+    // [0] kernel for single messages, [1] kernel for sha256_multi. Set to the best available on first use.
+    std::atomic<sha256_kernel_e>* __sha256_kernels();
+    // 32 bytes digest to hex string
+    std::string __sha256_hex(const unsigned char*);
+#ifdef LUNARIS_HASH_X86
+    // sha256_multi helper (AVX2 only)
+    void __sha256_transpose_avx2(const __m256i*, __m256i*);
+#endif
+
     class _SHA256
     {
     protected:
@@ -63,18 +96,121 @@ namespace Lunaris {
         typedef unsigned long long uint64;
     public:
         void init();
-        void update(const unsigned char* message, unsigned int len);
+        void init(const sha256_kernel_e);
+        void update(const unsigned char* message, size_t len);
         void final(unsigned char* digest);
         static const unsigned int DIGEST_SIZE = (256 / 8);
 
+        static void transform_scalar(uint32* state, const unsigned char* message, size_t block_nb);
+#ifdef LUNARIS_HASH_X86
+        static void transform_shani(uint32* state, const unsigned char* message, size_t block_nb);
+        static void multi_avx2(const std::string_view* messages, const size_t count, std::array<unsigned char, DIGEST_SIZE>* digests);
+#endif
     protected:
-        void transform(const unsigned char* message, unsigned int block_nb);
-        unsigned int m_tot_len;
+        void transform(const unsigned char* message, size_t block_nb);
+        sha256_kernel_e m_kernel;
+        uint64 m_tot_len;
         unsigned int m_len;
         unsigned char m_block[2 * SHA224_256_BLOCK_SIZE];
         uint32 m_h[8];
     };
 
+    constexpr size_t sha256_file_buffer = 1 << 20; // sha256_f reads this much at once
+
+    /// <summary>
+    /// <para>SHA256 of data that comes in parts (streaming). Feed it with update as data comes, then get the hash with final.</para>
+    /// <para>Same result as hashing everything at once, without having it all in memory.</para>
+    /// </summary>
+    class sha256_hasher {
+        _SHA256 m_ctx;
+    public:
+        sha256_hasher();
+
+        /// <summary>
+        /// <para>Start over (done automatically on creation and after final).</para>
+        /// </summary>
+        void init();
+
+        /// <summary>
+        /// <para>Add data.</para>
+        /// </summary>
+        /// <param name="{void*}">Data.</param>
+        /// <param name="{size_t}">Size in bytes.</param>
+        void update(const void*, const size_t);
+
+        /// <summary>
+        /// <para>Add data.</para>
+        /// </summary>
+        /// <param name="{std::string_view}">Data.</param>
+        void update(const std::string_view);
+
+        /// <summary>
+        /// <para>Add data.</para>
+        /// </summary>
+        /// <param name="{std::vector}">Data.</param>
+        void update(const std::vector<char>&);
+
+        /// <summary>
+        /// <para>Finish and get the raw digest. This starts over after that.</para>
+        /// </summary>
+        /// <returns>{std::array} The 32 bytes digest.</returns>
+        std::array<unsigned char, _SHA256::DIGEST_SIZE> final_bytes();
+
+        /// <summary>
+        /// <para>Finish and get the hash as hex string (like sha256()). This starts over after that.</para>
+        /// </summary>
+        /// <returns>{std::string} The hash.</returns>
+        std::string final();
+    };
+
+    /// <summary>
+    /// <para>Can this CPU run this kernel?</para>
+    /// </summary>
+    /// <param name="{sha256_kernel_e}">The kernel.</param>
+    /// <returns>{bool} True if supported.</returns>
+    bool sha256_supports(const sha256_kernel_e);
+
+    /// <summary>
+    /// <para>Kernel used to hash single messages (sha256, sha256_f, sha256_hasher). Defaults to the best one supported.</para>
+    /// </summary>
+    /// <returns>{sha256_kernel_e} SCALAR or SHA_NI.</returns>
+    sha256_kernel_e sha256_kernel();
+
+    /// <summary>
+    /// <para>Choose the kernel to hash single messages (AVX2 is only for sha256_multi).</para>
+    /// </summary>
+    /// <param name="{sha256_kernel_e}">SCALAR or SHA_NI.</param>
+    /// <returns>{bool} True if supported and set.</returns>
+    bool sha256_use_kernel(const sha256_kernel_e);
+
+    /// <summary>
+    /// <para>Kernel used by sha256_multi. Defaults to the fastest one supported for many small messages.</para>
+    /// </summary>
+    /// <returns>{sha256_kernel_e} The kernel.</returns>
+    sha256_kernel_e sha256_multi_kernel();
+
+    /// <summary>
+    /// <para>Choose the kernel for sha256_multi (SCALAR and SHA_NI hash one message after the other).</para>
+    /// </summary>
+    /// <param name="{sha256_kernel_e}">The kernel.</param>
+    /// <returns>{bool} True if supported and set.</returns>
+    bool sha256_use_multi_kernel(const sha256_kernel_e);
+
+    /// <summary>
+    /// <para>Hash many messages at once. Without SHA extensions, AVX2 hashes eight messages side by side (about 5x the scalar speed for small ones).</para>
+    /// </summary>
+    /// <param name="{std::string_view*}">Messages.</param>
+    /// <param name="{size_t}">How many.</param>
+    /// <param name="{std::array*}">Where to put each raw digest (same amount).</param>
+    void sha256_multi(const std::string_view*, const size_t, std::array<unsigned char, _SHA256::DIGEST_SIZE>*);
+
+    /// <summary>
+    /// <para>Hash many messages at once (see the other sha256_multi).</para>
+    /// </summary>
+    /// <param name="{std::vector}">Messages.</param>
+    /// <returns>{std::vector} Hashes as hex strings, same order.</returns>
+    std::vector<std::string> sha256_multi(const std::vector<std::string_view>&);
+
     /// <summary>
     /// <para>Gets the string and generates a SHA256 code based on it.</para>
     /// </summary>
@@ -91,6 +227,7 @@ namespace Lunaris {
 
     /// <summary>
     /// <para>Generates a SHA256 based on content in a file.</para>
+    /// <para>The file is read in big blocks (sha256_file_buffer), never fully loaded in memory.</para>
     /// </summary>
     /// <param name="{std::string}">The path to the file.</param>
     /// <returns>{std::string} The hash.</returns>
@@ -147,6 +284,7 @@ namespace Lunaris {
     /// <summary>
     /// <para>This does the combo one_sum_each, move_bytes and mess_string_order in a random way, but keeping the key somewhere into it (randomly positioned).</para>
     /// <para>Maybe this is good enough for *some* security. Probably not worth it, but different enough.</para>
+    /// <para>NOTE: this is NOT real protection and copies the data a few times. For save files and such, use crypt_seal/crypt_open (ChaCha20-Poly1305, crypt.h).</para>
     /// </summary>
     /// <param name="{std::string}">The original string.</param>
     /// <returns>{std::string} Messy string.</returns>
@@ -210,6 +348,7 @@ namespace Lunaris {
     /// <summary>
     /// <para>This does the combo one_sum_each, move_bytes and mess_string_order in a random way, but keeping the key somewhere into it (randomly positioned).</para>
     /// <para>Maybe this is good enough for *some* security. Probably not worth it, but different enough.</para>
+    /// <para>NOTE: this is NOT real protection and copies the data a few times. For save files and such, use crypt_seal/crypt_open (ChaCha20-Poly1305, crypt.h).</para>
     /// </summary>
     /// <param name="{std::vector<char>}">The original string.</param>
     /// <returns>{std::vector<char>} Messy string.</returns>
@@ -0,0 +1,8 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "merkle/merkle.h"
+#ifdef LUNARIS_HEADER_ONLY
+#include "merkle/merkle.cpp"
+#endif
\ No newline at end of file
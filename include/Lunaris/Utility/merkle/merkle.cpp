@@ -0,0 +1,297 @@
+#include "merkle.h"
+
+namespace Lunaris {
+
+	LUNARIS_DECL bool merkle_tree::_parallel(const size_t first, const size_t last, size_t threads, const std::function<std::function<bool(size_t)>()>& factory)
+	{
+		if (last < first) return true;
+		const size_t count = last - first + 1;
+
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		if (threads == 0) threads = 1;
+		if (threads > count) threads = count;
+
+		std::atomic<size_t> next{ first };
+		std::atomic<bool> good{ true };
+
+		const auto run = [&] {
+			const auto work = factory();
+			for (size_t i; good && (i = next++) <= last;) {
+				if (!work(i)) good = false;
+			}
+		};
+
+		std::vector<std::thread> thrs;
+		for (size_t t = 1; t < threads; ++t) thrs.emplace_back(run);
+		run(); // this one works too
+		for (auto& it : thrs) it.join();
+
+		return good;
+	}
+
+	LUNARIS_DECL merkle_tree::digest merkle_tree::_leaf(const unsigned char* data, const size_t len)
+	{
+		const unsigned char prefix = 0x00;
+		sha256_hasher ctx;
+		ctx.update(&prefix, 1);
+		ctx.update(data, len);
+		return ctx.final_bytes();
+	}
+
+	LUNARIS_DECL merkle_tree::digest merkle_tree::_node(const digest& left, const digest& right)
+	{
+		unsigned char buf[1 + 2 * _SHA256::DIGEST_SIZE];
+		buf[0] = 0x01;
+		memcpy(buf + 1, left.data(), left.size());
+		memcpy(buf + 1 + left.size(), right.data(), right.size());
+		sha256_hasher ctx;
+		ctx.update(buf, sizeof(buf));
+		return ctx.final_bytes();
+	}
+
+	LUNARIS_DECL void merkle_tree::_shape(const uint64_t size, const size_t chunk)
+	{
+		m_size = size;
+		m_chunk = chunk;
+		m_levels.clear();
+
+		size_t amount = static_cast<size_t>((size + chunk - 1) / chunk);
+		if (amount == 0) amount = 1; // empty data still has one (empty) chunk
+
+		m_levels.emplace_back(amount);
+		while (amount > 1) {
+			amount = (amount + 1) / 2;
+			m_levels.emplace_back(amount);
+		}
+	}
+
+	LUNARIS_DECL void merkle_tree::_build_up()
+	{
+		constexpr size_t node_len = 1 + 2 * _SHA256::DIGEST_SIZE;
+
+		std::vector<unsigned char> buf;
+		std::vector<std::string_view> nodes;
+
+		for (size_t l = 1; l < m_levels.size(); ++l) {
+			const auto& below = m_levels[l - 1];
+			auto& level = m_levels[l];
+			const size_t pairs = below.size() / 2;
+
+			buf.resize(pairs * node_len);
+			nodes.resize(pairs);
+			for (size_t p = 0; p < pairs; ++p) {
+				unsigned char* it = buf.data() + p * node_len;
+				it[0] = 0x01;
+				memcpy(it + 1, below[2 * p].data(), _SHA256::DIGEST_SIZE);
+				memcpy(it + 1 + _SHA256::DIGEST_SIZE, below[2 * p + 1].data(), _SHA256::DIGEST_SIZE);
+				nodes[p] = std::string_view(reinterpret_cast<const char*>(it), node_len);
+			}
+			sha256_multi(nodes.data(), pairs, level.data()); // many small messages, best case for it
+
+			if (below.size() % 2) level.back() = below.back();
+		}
+	}
+
+	LUNARIS_DECL void merkle_tree::_update_up(size_t first, size_t last)
+	{
+		for (size_t l = 1; l < m_levels.size(); ++l) {
+			const auto& below = m_levels[l - 1];
+			first /= 2;
+			last /= 2;
+			for (size_t i = first; i <= last; ++i) {
+				m_levels[l][i] = (2 * i + 1 < below.size()) ? _node(below[2 * i], below[2 * i + 1]) : below[2 * i];
+			}
+		}
+	}
+
+	LUNARIS_DECL size_t merkle_tree::_chunk_len(const size_t index) const
+	{
+		const uint64_t off = static_cast<uint64_t>(index) * m_chunk;
+		if (off >= m_size) return 0;
+		return static_cast<size_t>((m_size - off) < m_chunk ? (m_size - off) : m_chunk);
+	}
+
+	LUNARIS_DECL bool merkle_tree::_hash_file(const std::string& path, const size_t first, const size_t last, const size_t threads)
+	{
+		return _parallel(first, last, threads, [&]() -> std::function<bool(size_t)> {
+			auto fp = std::make_shared<std::ifstream>(path, std::ios::binary);
+			auto buf = std::make_shared<std::vector<char>>(m_chunk);
+
+			return [this, fp, buf](const size_t i) {
+				if (!fp->is_open()) return false;
+				const size_t len = _chunk_len(i);
+
+				fp->clear();
+				fp->seekg(static_cast<std::streamoff>(static_cast<uint64_t>(i) * m_chunk));
+				fp->read(buf->data(), static_cast<std::streamsize>(len));
+				if (static_cast<size_t>(fp->gcount()) != len) return false;
+
+				m_levels[0][i] = _leaf(reinterpret_cast<const unsigned char*>(buf->data()), len);
+				return true;
+			};
+		});
+	}
+
+	LUNARIS_DECL bool merkle_tree::build(const std::string_view data, const size_t chunk, const size_t threads)
+	{
+		if (chunk == 0) return false;
+		_shape(data.size(), chunk);
+
+		const unsigned char* ptr = reinterpret_cast<const unsigned char*>(data.data());
+		_parallel(0, m_levels[0].size() - 1, threads, [&]() -> std::function<bool(size_t)> {
+			return [this, ptr](const size_t i) {
+				m_levels[0][i] = _leaf(ptr + static_cast<uint64_t>(i) * m_chunk, _chunk_len(i));
+				return true;
+			};
+		});
+
+		_build_up();
+		return true;
+	}
+
+	LUNARIS_DECL bool merkle_tree::build_file(const std::string& path, const size_t chunk, const size_t threads)
+	{
+		if (chunk == 0) return false;
+
+		std::ifstream fp(path, std::ios::binary | std::ios::ate);
+		if (!fp.is_open()) return false;
+		const uint64_t size = static_cast<uint64_t>(fp.tellg());
+		fp.close();
+
+		_shape(size, chunk);
+		if (!_hash_file(path, 0, m_levels[0].size() - 1, threads)) {
+			clear();
+			return false;
+		}
+
+		_build_up();
+		return true;
+	}
+
+	LUNARIS_DECL bool merkle_tree::update(const std::string_view data, const uint64_t offset, const uint64_t length, const size_t threads)
+	{
+		if (empty() || data.size() != m_size) return build(data, m_chunk, threads);
+		if (length == 0) return true;
+		if (offset >= m_size) return false;
+
+		const size_t first = static_cast<size_t>(offset / m_chunk);
+		const uint64_t end = (length > m_size - offset) ? m_size : offset + length;
+		const size_t last = static_cast<size_t>((end - 1) / m_chunk);
+
+		const unsigned char* ptr = reinterpret_cast<const unsigned char*>(data.data());
+		_parallel(first, last, threads, [&]() -> std::function<bool(size_t)> {
+			return [this, ptr](const size_t i) {
+				m_levels[0][i] = _leaf(ptr + static_cast<uint64_t>(i) * m_chunk, _chunk_len(i));
+				return true;
+			};
+		});
+
+		_update_up(first, last);
+		return true;
+	}
+
+	LUNARIS_DECL bool merkle_tree::update_file(const std::string& path, const uint64_t offset, const uint64_t length, const size_t threads)
+	{
+		std::ifstream fp(path, std::ios::binary | std::ios::ate);
+		if (!fp.is_open()) return false;
+		const uint64_t size = static_cast<uint64_t>(fp.tellg());
+		fp.close();
+
+		if (empty() || size != m_size) return build_file(path, m_chunk, threads);
+		if (length == 0) return true;
+		if (offset >= m_size) return false;
+
+		const size_t first = static_cast<size_t>(offset / m_chunk);
+		const uint64_t end = (length > m_size - offset) ? m_size : offset + length;
+		const size_t last = static_cast<size_t>((end - 1) / m_chunk);
+
+		const std::vector<digest> old_leaves(m_levels[0].begin() + first, m_levels[0].begin() + last + 1);
+		if (!_hash_file(path, first, last, threads)) { // some leaves may be new already: put the old ones back, the tree is as before
+			std::copy(old_leaves.begin(), old_leaves.end(), m_levels[0].begin() + first);
+			return false;
+		}
+
+		_update_up(first, last);
+		return true;
+	}
+
+	LUNARIS_DECL std::vector<size_t> merkle_tree::diff(const merkle_tree& oth) const
+	{
+		std::vector<size_t> res;
+
+		if (empty() || oth.empty() || m_chunk != oth.m_chunk || m_levels[0].size() != oth.m_levels[0].size()) {
+			const size_t amount = chunk_count() > oth.chunk_count() ? chunk_count() : oth.chunk_count();
+			for (size_t i = 0; i < amount; ++i) res.push_back(i);
+			return res;
+		}
+
+		std::vector<std::pair<size_t, size_t>> todo; // level, index
+		todo.push_back({ m_levels.size() - 1, 0 });
+
+		while (!todo.empty()) {
+			const auto [l, i] = todo.back();
+			todo.pop_back();
+
+			if (m_levels[l][i] == oth.m_levels[l][i]) continue;
+			if (l == 0) {
+				res.push_back(i);
+				continue;
+			}
+			if (2 * i + 1 < m_levels[l - 1].size()) todo.push_back({ l - 1, 2 * i + 1 });
+			todo.push_back({ l - 1, 2 * i });
+		}
+
+		return res; // left first, already sorted
+	}
+
+	LUNARIS_DECL bool merkle_tree::verify_chunk(const size_t index, const std::string_view data) const
+	{
+		if (empty() || index >= m_levels[0].size() || data.size() != _chunk_len(index)) return false;
+		return _leaf(reinterpret_cast<const unsigned char*>(data.data()), data.size()) == m_levels[0][index];
+	}
+
+	LUNARIS_DECL merkle_tree::digest merkle_tree::root() const
+	{
+		if (empty()) return {};
+		return m_levels.back().front();
+	}
+
+	LUNARIS_DECL std::string merkle_tree::root_hex() const
+	{
+		if (empty()) return {};
+		return __sha256_hex(m_levels.back().front().data());
+	}
+
+	LUNARIS_DECL merkle_tree::digest merkle_tree::leaf(const size_t index) const
+	{
+		if (empty() || index >= m_levels[0].size()) return {};
+		return m_levels[0][index];
+	}
+
+	LUNARIS_DECL size_t merkle_tree::chunk_count() const
+	{
+		return empty() ? 0 : m_levels[0].size();
+	}
+
+	LUNARIS_DECL size_t merkle_tree::chunk_size() const
+	{
+		return m_chunk;
+	}
+
+	LUNARIS_DECL uint64_t merkle_tree::size() const
+	{
+		return m_size;
+	}
+
+	LUNARIS_DECL bool merkle_tree::empty() const
+	{
+		return m_levels.empty();
+	}
+
+	LUNARIS_DECL void merkle_tree::clear()
+	{
+		m_levels.clear();
+		m_size = 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Utility/hash.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+namespace Lunaris {
+
+	constexpr size_t merkle_default_chunk = 1 << 20; // 1 MiB
+
+	/// <summary>
+	/// <para>merkle_tree is a SHA256 tree hash: data is split in fixed size chunks, each chunk is hashed on its own (in parallel) and pairs are hashed up to a single root.</para>
+	/// <para>Leaves are SHA256(0x00 + chunk), nodes are SHA256(0x01 + left + right). A lonely last node goes up as is.</para>
+	/// <para>Changes can be applied by region (only those chunks and their path to the root are hashed again) and two trees can be compared chunk by chunk without looking at the data.</para>
+	/// </summary>
+	class merkle_tree {
+	public:
+		typedef std::array<unsigned char, _SHA256::DIGEST_SIZE> digest;
+	private:
+		std::vector<std::vector<digest>> m_levels; // [0] = leaves, back() = root
+		size_t m_chunk = merkle_default_chunk;
+		uint64_t m_size = 0;
+
+		// calls work(index) for [first, last] spread on threads. Each thread gets its own worker from the factory. False if any failed.
+		static bool _parallel(const size_t, const size_t, size_t, const std::function<std::function<bool(size_t)>()>&);
+		static digest _leaf(const unsigned char*, const size_t);
+		static digest _node(const digest&, const digest&);
+
+		void _shape(const uint64_t, const size_t); // sets size, chunk and levels size
+		void _build_up(); // all levels above leaves
+		void _update_up(const size_t, const size_t); // path of leaves [first, last] up to the root
+		size_t _chunk_len(const size_t) const;
+		bool _hash_file(const std::string&, const size_t, const size_t, const size_t);
+	public:
+		merkle_tree() = default;
+
+		/// <summary>
+		/// <para>Hash data in memory.</para>
+		/// </summary>
+		/// <param name="{std::string_view}">The data.</param>
+		/// <param name="{size_t}">Chunk size.</param>
+		/// <param name="{size_t}">Threads (0 = hardware threads).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool build(const std::string_view, const size_t = merkle_default_chunk, const size_t = 0);
+
+		/// <summary>
+		/// <para>Hash a file. Each thread reads its own chunks, so memory is threads * chunk size.</para>
+		/// </summary>
+		/// <param name="{std::string}">Path to the file.</param>
+		/// <param name="{size_t}">Chunk size.</param>
+		/// <param name="{size_t}">Threads (0 = hardware threads).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool build_file(const std::string&, const size_t = merkle_default_chunk, const size_t = 0);
+
+		/// <summary>
+		/// <para>Data changed in a region: hash only the chunks in it and their way up (rebuilds all if the size changed).</para>
+		/// </summary>
+		/// <param name="{std::string_view}">The whole data, already changed.</param>
+		/// <param name="{uint64_t}">Offset of the change.</param>
+		/// <param name="{uint64_t}">Length of the change.</param>
+		/// <param name="{size_t}">Threads (0 = hardware threads).</param>
+		/// <returns>{bool} True if success.</returns>
+		bool update(const std::string_view, const uint64_t, const uint64_t, const size_t = 0);
+
+		/// <summary>
+		/// <para>File changed in a region: hash only the chunks in it and their way up (rebuilds all if the size changed).</para>
+		/// </summary>
+		/// <param name="{std::string}">Path to the file, already changed.</param>
+		/// <param name="{uint64_t}">Offset of the change.</param>
+		/// <param name="{uint64_t}">Length of the change.</param>
+		/// <param name="{size_t}">Threads (0 = hardware threads).</param>
+		/// <returns>{bool} True if success. If reading fails, the tree is left as it was before the call (or empty, if it had to rebuild).</returns>
+		bool update_file(const std::string&, const uint64_t, const uint64_t, const size_t = 0);
+
+		/// <summary>
+		/// <para>Which chunks are different from another tree? Only branches that don't match are walked.</para>
+		/// <para>If chunk size or amount don't match, every chunk is different.</para>
+		/// </summary>
+		/// <param name="{merkle_tree}">Another tree (like the expected one).</param>
+		/// <returns>{std::vector&lt;size_t&gt;} Chunk indexes, sorted.</returns>
+		std::vector<size_t> diff(const merkle_tree&) const;
+
+		/// <summary>
+		/// <para>Check one chunk against its leaf (like a downloaded part).</para>
+		/// </summary>
+		/// <param name="{size_t}">Chunk index.</param>
+		/// <param name="{std::string_view}">Chunk data.</param>
+		/// <returns>{bool} True if it matches.</returns>
+		bool verify_chunk(const size_t, const std::string_view) const;
+
+		/// <summary>
+		/// <para>The root hash.</para>
+		/// </summary>
+		/// <returns>{digest} Root (zeros if empty).</returns>
+		digest root() const;
+
+		/// <summary>
+		/// <para>The root hash as hex string.</para>
+		/// </summary>
+		/// <returns>{std::string} Root (empty if empty).</returns>
+		std::string root_hex() const;
+
+		/// <summary>
+		/// <para>Hash of a chunk.</para>
+		/// </summary>
+		/// <param name="{size_t}">Chunk index.</param>
+		/// <returns>{digest} Leaf hash (zeros if out of range).</returns>
+		digest leaf(const size_t) const;
+
+		/// <summary>
+		/// <para>Amount of chunks.</para>
+		/// </summary>
+		/// <returns>{size_t} Chunks.</returns>
+		size_t chunk_count() const;
+
+		/// <summary>
+		/// <para>Chunk size used.</para>
+		/// </summary>
+		/// <returns>{size_t} Bytes.</returns>
+		size_t chunk_size() const;
+
+		/// <summary>
+		/// <para>Size of the data hashed.</para>
+		/// </summary>
+		/// <returns>{uint64_t} Bytes.</returns>
+		uint64_t size() const;
+
+		/// <summary>
+		/// <para>Is there a tree?</para>
+		/// </summary>
+		/// <returns>{bool} True if nothing was built.</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// <para>Drop everything.</para>
+		/// </summary>
+		void clear();
+	};
+
+}
\ No newline at end of file
@@ -5,13 +5,25 @@
 #include <thread>
 #include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
 namespace Lunaris {
 
+	// Types with LUNARIS_SERIALIZE (see serialize.h) are written field by field, never as raw bytes.
+	template<typename T, typename = void> struct is_serializable : std::false_type {};
+	template<typename T> struct is_serializable<T, std::void_t<decltype(std::declval<const T&>().__lunaris_fields())>> : std::true_type {};
+	template<typename T> constexpr bool is_serializable_v = is_serializable<T>::value;
+
 	/// <summary>
 	/// <para>package is a useful tool to combine stuff in a pretty array of char and then get back easily in order.</para>
 	/// <para>The operators &lt;&lt; and &gt;&gt; works as you'd expect: write and read easy!</para>
 	/// <para>You can also read the entire thing as array or export to a buffer, or write as an array or buffer as well.</para>
+	/// <para>For lots of fields, reserve first and read strings as std::string_view (no copies, valid until the package changes).</para>
 	/// </summary>
 	class package {
 		using measure_siz = size_t;
@@ -88,12 +100,12 @@ namespace Lunaris {
 		/// </summary>
 		/// <param name="{T&amp;}">Variable getting the data.</param>
 		/// <returns>{package&amp;} Itself.</returns>
-		template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T>, int> = 0>
+		template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T> && !is_serializable_v<T>, int> = 0>
 		package& operator>>(T&);
 
 		/// <summary>
 		/// <para>Write next buffer to a variable.</para>
-		/// <para>The offset in this case is pre-determined by the write function. It is automatic. The string size should have the size you've set before.</para>
+		/// <para>The offset in this case is pre-determined by the write function. It is automatic. The string size should have the size you've set before (empty is fine).</para>
 		/// </summary>
 		/// <param name="{string}">Variable getting the data.</param>
 		/// <returns>{package&amp;} Itself.</returns>
@@ -101,24 +113,32 @@ namespace Lunaris {
 
 		/// <summary>
 		/// <para>Write next buffer to a variable.</para>
-		/// <para>The offset in this case is pre-determined by the write function. It is automatic. The string size should have the size you've set before.</para>
+		/// <para>The offset in this case is pre-determined by the write function. It is automatic. The string size should have the size you've set before (empty is fine).</para>
 		/// </summary>
 		/// <param name="{vector&lt;char&gt;}">Variable getting the data.</param>
 		/// <returns>{package&amp;} Itself.</returns>
 		package& operator>>(std::vector<char>&);
 
+		/// <summary>
+		/// <para>Read next string as a view into the package (no copy).</para>
+		/// <para>NOTE: The view is valid only while the package is not changed.</para>
+		/// </summary>
+		/// <param name="{string_view}">Variable getting the view.</param>
+		/// <returns>{package&amp;} Itself.</returns>
+		package& operator>>(std::string_view&);
+
 		/// <summary>
 		/// <para>Write a variable into the buffer.</para>
 		/// <para>The offset (size) is increased automatically.</para>
 		/// </summary>
 		/// <param name="{T}">A variable to copy.</param>
 		/// <returns>{package&amp;} Itself.</returns>
-		template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T>, int> = 0>
+		template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T> && !is_serializable_v<T>, int> = 0>
 		package& operator<<(const T&);
 
 		/// <summary>
 		/// <para>Write a variable into the buffer.</para>
-		/// <para>The length is stored alongside the array data itself.</para>
+		/// <para>The length is stored alongside the array data itself (empty is fine).</para>
 		/// </summary>
 		/// <param name="{string}">The string to copy.</param>
 		/// <returns>{package&amp;} Itself.</returns>
@@ -126,12 +146,69 @@ namespace Lunaris {
 
 		/// <summary>
 		/// <para>Write a variable into the buffer.</para>
-		/// <para>The length is stored alongside the array data itself.</para>
+		/// <para>The length is stored alongside the array data itself (empty is fine).</para>
 		/// </summary>
 		/// <param name="{vector&lt;char&gt;}">Variable with the data to copy.</param>
 		/// <returns>{package&amp;} Itself.</returns>
 		package& operator<<(const std::vector<char>&);
 
+		/// <summary>
+		/// <para>Write a variable into the buffer.</para>
+		/// <para>The length is stored alongside the array data itself (empty is fine).</para>
+		/// </summary>
+		/// <param name="{string_view}">The data to copy.</param>
+		/// <returns>{package&amp;} Itself.</returns>
+		package& operator<<(const std::string_view);
+
+		/// <summary>
+		/// <para>Write a null terminated string into the buffer (same as string).</para>
+		/// <para>A nullptr is written as an empty string, so reads stay in sync.</para>
+		/// </summary>
+		/// <param name="{char*}">The string to copy.</param>
+		/// <returns>{package&amp;} Itself.</returns>
+		package& operator<<(const char*);
+
+		/// <summary>
+		/// <para>Append raw bytes (no length stored). Read them back with read_data_view.</para>
+		/// </summary>
+		/// <param name="{char*}">Buffer.</param>
+		/// <param name="{size_t}">Buffer size.</param>
+		/// <returns>{package&amp;} Itself.</returns>
+		package& write_data(const char*, const size_t);
+
+		/// <summary>
+		/// <para>Read next string (written with a length) as a view into the package (no copy).</para>
+		/// <para>NOTE: The view is valid only while the package is not changed.</para>
+		/// </summary>
+		/// <returns>{std::string_view} The data.</returns>
+		std::string_view read_string_view();
+
+		/// <summary>
+		/// <para>Read next raw bytes as a view into the package (no copy).</para>
+		/// <para>NOTE: The view is valid only while the package is not changed.</para>
+		/// </summary>
+		/// <param name="{size_t}">Amount of bytes.</param>
+		/// <returns>{std::string_view} The data.</returns>
+		std::string_view read_data_view(const size_t);
+
+		/// <summary>
+		/// <para>Bytes left to read from the internal offset.</para>
+		/// </summary>
+		/// <returns>{size_t} Bytes.</returns>
+		size_t remaining() const;
+
+		/// <summary>
+		/// <para>Reserve space for writing, so the buffer doesn't grow many times.</para>
+		/// </summary>
+		/// <param name="{size_t}">Total size expected, in bytes.</param>
+		void reserve(const size_t);
+
+		/// <summary>
+		/// <para>Space allocated in the buffer.</para>
+		/// </summary>
+		/// <returns>{size_t} Size, in bytes.</returns>
+		size_t capacity() const;
+
 		/// <summary>
 		/// <para>As you use &gt;&gt; or &lt;&lt; operators, an internal offset is set so you can combo things.</para>
 		/// <para>This function resets the offset back to zero.</para>
@@ -59,71 +59,111 @@ namespace Lunaris {
 		return oth.buf != buf;
 	}
 
-	template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T>, int>>
+	template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T> && !is_serializable_v<T>, int>>
 	inline package& package::operator>>(T& val)
 	{
 		if (read_index_pos + sizeof(val) > buf.size()) throw std::runtime_error("Out of range");
-		auto pos = buf.begin() + read_index_pos;
-		std::copy(pos, pos + sizeof(val), (char*)&val);
+		memcpy((char*)&val, buf.data() + read_index_pos, sizeof(val));
 		read_index_pos += sizeof(val);
 		return *this;
 	}
 
 	inline package& package::operator>>(std::string& val)
 	{
-		measure_siz sizer = 0;
-		*this >> sizer;
-		if (sizer == 0 || read_index_pos + sizer > buf.size()) throw std::runtime_error("Unexpected invalid value while reading");
-		auto pos = buf.begin() + read_index_pos;
-		val.resize(sizer);
-		std::copy(pos, pos + sizer, val.begin());
-		read_index_pos += sizer;
+		const std::string_view view = read_string_view();
+		val.assign(view.begin(), view.end());
 		return *this;
 	}
 
 	inline package& package::operator>>(std::vector<char>& val)
 	{
-		measure_siz sizer = 0;
-		*this >> sizer;
-		if (sizer == 0 || read_index_pos + sizer > buf.size()) throw std::runtime_error("Unexpected invalid value while reading");
-		auto pos = buf.begin() + read_index_pos;
-		val.resize(sizer);
-		std::copy(pos, pos + sizer, val.begin());
-		read_index_pos += sizer;
+		const std::string_view view = read_string_view();
+		val.assign(view.begin(), view.end());
 		return *this;
 	}
 
+	inline package& package::operator>>(std::string_view& val)
+	{
+		val = read_string_view();
+		return *this;
+	}
 
-	template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T>, int>>
+	template<typename T, std::enable_if_t<std::is_pod_v<T> && !std::is_array_v<T> && !std::is_pointer_v<T> && !is_serializable_v<T>, int>>
 	inline package& package::operator<<(const T& val)
 	{
-		buf.resize(buf.size() + sizeof(val));
-		auto pos = buf.end() - sizeof(val);
-		std::copy((char*)&val, (char*)&val + sizeof(val), pos);
+		const size_t off = buf.size();
+		buf.resize(off + sizeof(val));
+		memcpy(buf.data() + off, (const char*)&val, sizeof(val));
 		reset_internal_iterator();
 		return *this;
 	}
 
 	inline package& package::operator<<(const std::string& val)
 	{
-		if (val.empty()) throw std::runtime_error("Invalid data to write: it was null!");
-		measure_siz sizer = val.size();
-		*this << sizer;
-		for (const auto& i : val) buf.push_back(i);
+		return *this << std::string_view(val);
+	}
+
+	inline package& package::operator<<(const std::vector<char>& val)
+	{
+		return *this << std::string_view(val.data(), val.size());
+	}
+
+	inline package& package::operator<<(const std::string_view val)
+	{
+		const measure_siz sizer = val.size();
+		const size_t off = buf.size();
+		buf.resize(off + sizeof(sizer) + val.size()); // one grow for both
+		memcpy(buf.data() + off, (const char*)&sizer, sizeof(sizer));
+		if (val.size()) memcpy(buf.data() + off + sizeof(sizer), val.data(), val.size());
 		reset_internal_iterator();
 		return *this;
 	}
 
-	inline package& package::operator<<(const std::vector<char>& val)
+	inline package& package::operator<<(const char* val)
+	{
+		return *this << (val ? std::string_view(val) : std::string_view{}); // nullptr is written as an empty string
+	}
+
+	inline package& package::write_data(const char* ptr, const size_t len)
 	{
-		if (val.empty()) throw std::runtime_error("Invalid data to write: it was null!");
-		measure_siz sizer = val.size();
-		*this << sizer;
-		for (const auto& i : val) buf.push_back(i);
+		if (len) buf.insert(buf.end(), ptr, ptr + len);
 		reset_internal_iterator();
 		return *this;
 	}
 
+	inline std::string_view package::read_string_view()
+	{
+		measure_siz sizer = 0;
+		*this >> sizer;
+		if (sizer > buf.size() - read_index_pos) throw std::runtime_error("Unexpected invalid value while reading");
+		const std::string_view view(buf.data() + read_index_pos, sizer);
+		read_index_pos += sizer;
+		return view;
+	}
+
+	inline std::string_view package::read_data_view(const size_t len)
+	{
+		if (len > buf.size() - read_index_pos) throw std::runtime_error("Out of range");
+		const std::string_view view(buf.data() + read_index_pos, len);
+		read_index_pos += len;
+		return view;
+	}
+
+	inline size_t package::remaining() const
+	{
+		return buf.size() - read_index_pos;
+	}
+
+	inline void package::reserve(const size_t len)
+	{
+		buf.reserve(len);
+	}
+
+	inline size_t package::capacity() const
+	{
+		return buf.capacity();
+	}
+
 	inline void package::reset_internal_iterator()
 	{
 		read_index_pos = 0;
@@ -136,10 +176,9 @@ namespace Lunaris {
 
 	inline size_t package::read_as_data(char* ptr, const size_t max, const size_t bgg) const
 	{
-		size_t p = bgg;
-		for (; p < max && p < buf.size(); ++p) {
-			ptr[p] = buf[p];
-		}
+		const size_t p = max < buf.size() ? max : buf.size();
+		if (bgg >= p) return bgg;
+		memcpy(ptr + bgg, buf.data() + bgg, p - bgg);
 		return p;
 	}
 
@@ -150,7 +189,7 @@ namespace Lunaris {
 
 	inline void package::import_as_data(const char* ptr, const size_t len)
 	{
-		for (const char* be = ptr; be < (ptr + len); ++be) buf.push_back(*be);
+		buf.insert(buf.end(), ptr, ptr + len);
 	}
 
 	inline package::operator const std::vector<char>&() const
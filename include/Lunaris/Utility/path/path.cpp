@@ -49,36 +49,335 @@ namespace Lunaris {
 		char sep = sep_path_to_char(mod);
 		if (autofix) path_str = fix_path_to(path_str, mod);
 
-		bool has_to_check = false;
+		size_t rf = path_str.rfind(sep);
+		if (rf == std::string::npos) return true; // just a file name
+		std::string tmp = path_str.substr(0, rf);
+		if (tmp.empty()) return true; // root
+
+		std::error_code err;
+		if (std::filesystem::create_directories(tmp, err) || err.value() == 0) return true; // one call creates all of them
+		return std::filesystem::exists(tmp, err);
+	}
+
+	LUNARIS_DECL size_t __path_walk_threads(const size_t threads)
+	{
+		if (threads != 0) return threads;
+		const size_t amount = std::thread::hardware_concurrency();
+		return amount < 2 ? 2 : (amount > 16 ? 16 : amount);
+	}
+
+	LUNARIS_DECL size_t __path_walk(const std::filesystem::path& root, const std::function<bool(const path_entry&, const size_t)>& fcn, const bool with_stat, const size_t threads)
+	{
+		struct work {
+			std::filesystem::path dir;
+			std::string relative;
+			size_t depth;
+		};
+		struct queue {
+			std::mutex mtx;
+			std::deque<work> list;
+		};
 
-		for (size_t p = 0; p < path_str.size(); p++) {
-			size_t newp = path_str.find(sep, p);
-			if (newp < p || newp == std::string::npos) break; // find out of range?
-			else p = newp;
+		const size_t amount = __path_walk_threads(threads);
+		std::unique_ptr<queue[]> queues = std::make_unique<queue[]>(amount);
+		std::atomic<size_t> pending = 1; // directories queued or being read
+		std::atomic<size_t> found = 0;
+		std::atomic<bool> failed = false;
+		std::atomic<bool> stop = false; // a callback threw
+		std::mutex error_mtx;
+		std::exception_ptr error;
+		std::mutex idle_mtx;
+		std::condition_variable idle_cond; // idle workers wait here for new work or the end
+		size_t pushed = 0; // changes when there's something new to look at (idle_mtx)
 
-			std::string tmp = path_str.substr(0, p);
+		const auto wake = [&](const bool all) {
+			{
+				std::lock_guard<std::mutex> lock(idle_mtx);
+				++pushed;
+			}
+			if (all) idle_cond.notify_all();
+			else idle_cond.notify_one();
+		};
+
+		queues[0].list.push_back({ root, {}, 0 });
+
+		const auto walk = [&](const size_t self) {
+			queue& mine = queues[self];
+
+			while (pending.load() != 0 && !stop) {
+				work curr;
+				bool got = false;
+				size_t seen = 0;
+				{
+					std::lock_guard<std::mutex> lock(idle_mtx);
+					seen = pushed;
+				}
+
+				{ // own work, newest first (stays deep, like a serial walk)
+					std::lock_guard<std::mutex> lock(mine.mtx);
+					if (mine.list.size()) {
+						curr = std::move(mine.list.back());
+						mine.list.pop_back();
+						got = true;
+					}
+				}
+				for (size_t p = 1; !got && p < amount; ++p) { // steal oldest (usually the biggest subtrees)
+					queue& oth = queues[(self + p) % amount];
+					std::lock_guard<std::mutex> lock(oth.mtx);
+					if (oth.list.size()) {
+						curr = std::move(oth.list.front());
+						oth.list.pop_front();
+						got = true;
+					}
+				}
+				if (!got) { // someone is reading a directory that may have more work soon
+					std::unique_lock<std::mutex> lock(idle_mtx);
+					idle_cond.wait(lock, [&] { return pushed != seen || pending.load() == 0 || stop; });
+					continue;
+				}
 
-			std::error_code err;
-			if (!std::filesystem::create_directories(tmp, err) && err.value() != 0) {
-				//cout << console::color::GOLD << "Create directories error:" << err.message();
-				has_to_check = true;
+				std::error_code err;
+				std::filesystem::directory_iterator it(curr.dir, err);
+				if (err) failed = true;
+
+				for (; !err && !stop && it != std::filesystem::directory_iterator(); it.increment(err)) {
+					const std::filesystem::directory_entry& ent = *it;
+					path_entry info;
+					std::error_code serr;
+					const auto stt = ent.symlink_status(serr);
+
+					info.path = ent.path().string();
+					info.relative = curr.relative.empty() ? ent.path().filename().string() : (curr.relative + '/' + ent.path().filename().string());
+					info.depth = curr.depth;
+					info.is_symlink = std::filesystem::is_symlink(stt);
+					info.is_directory = std::filesystem::is_directory(stt);
+					if (with_stat) {
+						if (std::filesystem::is_regular_file(stt)) info.size = ent.file_size(serr);
+						if (serr) info.size = 0;
+						info.last_write = ent.last_write_time(serr);
+					}
+					++found;
+
+					if (fcn(info, self) && info.is_directory) {
+						++pending; // before this one is done, so it can't hit 0 early
+						{
+							std::lock_guard<std::mutex> lock(mine.mtx);
+							mine.list.push_back({ ent.path(), std::move(info.relative), curr.depth + 1 });
+						}
+						wake(false);
+					}
+				}
+				if (err) failed = true;
+
+				if (--pending == 0) wake(true);
 			}
+		};
+
+		const auto task = [&](const size_t self) { // an exception can't leave a thread, it is thrown again after all of them are joined
+			try {
+				walk(self);
+			}
+			catch (...) {
+				{
+					std::lock_guard<std::mutex> lock(error_mtx);
+					if (!error) error = std::current_exception();
+					stop = true;
+				}
+				wake(true);
+			}
+		};
+
+		if (amount == 1) task(0);
+		else {
+			std::vector<std::thread> thrs;
+			for (size_t p = 1; p < amount; ++p) thrs.emplace_back(task, p);
+			task(0);
+			for (auto& it : thrs) it.join();
 		}
+		if (error) std::rethrow_exception(error);
 
-		if (!has_to_check) return true;
-		
-		size_t rf = path_str.rfind(sep);
-		if (rf == std::string::npos) return false;
-		std::string tmp = path_str.substr(0, rf);
-		return std::filesystem::exists(tmp);
+		return failed ? static_cast<size_t>(-1) : found.load();
 	}
 
 	LUNARIS_DECL size_t remove_all(std::string path, const bool autofix)
 	{
 		if (autofix) path = fix_path_to(path, path_sep_e::NATIVE);
 		std::error_code err;
-		size_t amount = std::filesystem::remove_all(path, err);
-		if (err.value() != 0) return static_cast<size_t>(-1);
+
+		const auto stt = std::filesystem::symlink_status(path, err);
+		if (!std::filesystem::exists(stt)) return 0;
+		if (!std::filesystem::is_directory(stt)) return std::filesystem::remove(path, err) ? 1 : static_cast<size_t>(-1);
+
+		std::mutex dirs_mtx;
+		std::vector<std::pair<size_t, std::filesystem::path>> dirs; // removed after their content, deepest first
+		std::atomic<size_t> amount = 0;
+		std::atomic<bool> failed = false;
+
+		const size_t res = __path_walk(path, [&](const path_entry& ent, const size_t) {
+			if (ent.is_directory) {
+				std::lock_guard<std::mutex> lock(dirs_mtx);
+				dirs.push_back({ ent.depth, std::filesystem::path(ent.path) });
+				return true;
+			}
+			std::error_code rerr;
+			if (std::filesystem::remove(ent.path, rerr)) ++amount;
+			else if (rerr) failed = true;
+			return false;
+		}, false, 0);
+
+		std::sort(dirs.begin(), dirs.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+		for (const auto& it : dirs) {
+			if (std::filesystem::remove(it.second, err)) ++amount;
+			else if (err) failed = true;
+		}
+		if (std::filesystem::remove(path, err)) ++amount;
+		else if (err) failed = true;
+
+		if (failed || res == static_cast<size_t>(-1)) return static_cast<size_t>(-1);
+		return amount;
+	}
+
+	LUNARIS_DECL bool path_glob_match(const std::string_view pattern, const std::string_view text)
+	{
+		size_t p = 0, t = 0;
+
+		while (p < pattern.size()) {
+			const char c = pattern[p];
+
+			if (c == '*') {
+				const bool deep = (p + 1 < pattern.size() && pattern[p + 1] == '*');
+				const std::string_view rest = pattern.substr(p + (deep ? 2 : 1));
+				if (deep && rest.size() && rest[0] == '/' && (p == 0 || pattern[p - 1] == '/') && path_glob_match(rest.substr(1), text.substr(t))) return true; // "a/**/b" is also "a/b"
+				for (size_t k = t; k <= text.size(); ++k) {
+					if (path_glob_match(rest, text.substr(k))) return true;
+					if (k < text.size() && !deep && text[k] == '/') return false;
+				}
+				return false;
+			}
+
+			if (t >= text.size()) return false;
+
+			if (c == '?') {
+				if (text[t] == '/') return false;
+			}
+			else if (c == '[' && pattern.find(']', p + 2) != std::string_view::npos) {
+				const size_t end = pattern.find(']', p + 2);
+				const bool negate = pattern[p + 1] == '!' || pattern[p + 1] == '^';
+				bool match = false;
+				for (size_t k = p + (negate ? 2 : 1); k < end; ++k) {
+					if (k + 2 < end && pattern[k + 1] == '-') {
+						if (text[t] >= pattern[k] && text[t] <= pattern[k + 2]) match = true;
+						k += 2;
+					}
+					else if (text[t] == pattern[k]) match = true;
+				}
+				if (match == negate || text[t] == '/') return false;
+				p = end;
+			}
+			else if (c != text[t]) return false;
+
+			++p;
+			++t;
+		}
+
+		return t == text.size();
+	}
+
+	LUNARIS_DECL size_t walk_path(const std::string& path, const std::function<void(std::vector<path_entry>&)>& fcn, const std::string& glob, const bool with_dirs, const size_t threads)
+	{
+		constexpr size_t batch_size = 256;
+
+		if (!fcn) return static_cast<size_t>(-1);
+		std::error_code err;
+		if (!std::filesystem::is_directory(path, err)) return static_cast<size_t>(-1);
+
+		const bool on_relative = glob.find('/') != std::string::npos;
+		std::mutex fcn_mtx;
+		std::vector<std::vector<path_entry>> batches(__path_walk_threads(threads)); // one per worker
+		std::atomic<size_t> given = 0;
+
+		const auto flush = [&](std::vector<path_entry>& batch) {
+			if (batch.empty()) return;
+			given += batch.size();
+			std::lock_guard<std::mutex> lock(fcn_mtx);
+			fcn(batch);
+			batch.clear();
+		};
+
+		const size_t res = __path_walk(path, [&](const path_entry& ent, const size_t self) {
+			if (ent.is_directory && !with_dirs) return true;
+			if (glob.size()) {
+				const std::string_view name = on_relative ? std::string_view(ent.relative) : std::string_view(ent.relative).substr(ent.relative.rfind('/') + 1);
+				if (!path_glob_match(glob, name)) return true;
+			}
+
+			std::vector<path_entry>& batch = batches[self];
+			batch.push_back(ent);
+			if (batch.size() >= batch_size) flush(batch);
+			return true;
+		}, true, threads);
+
+		for (auto& it : batches) flush(it);
+
+		return res == static_cast<size_t>(-1) ? res : given.load();
+	}
+
+	LUNARIS_DECL std::vector<path_entry> scan_path(const std::string& path, const std::string& glob, const bool with_dirs, const size_t threads)
+	{
+		std::vector<path_entry> res;
+		walk_path(path, [&res](std::vector<path_entry>& batch) {
+			res.insert(res.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+		}, glob, with_dirs, threads);
+
+		std::sort(res.begin(), res.end(), [](const path_entry& a, const path_entry& b) { return a.relative < b.relative; });
+		return res;
+	}
+
+	LUNARIS_DECL size_t copy_all(std::string from, std::string to, const bool overwrite, const bool autofix)
+	{
+		if (autofix) {
+			from = fix_path_to(from, path_sep_e::NATIVE);
+			to = fix_path_to(to, path_sep_e::NATIVE);
+		}
+		const auto opt = overwrite ? std::filesystem::copy_options::overwrite_existing : std::filesystem::copy_options::skip_existing;
+		std::error_code err;
+
+		if (!std::filesystem::is_directory(from, err)) {
+			if (!std::filesystem::exists(from, err)) return static_cast<size_t>(-1);
+			return std::filesystem::copy_file(from, to, opt, err) ? 1 : (err ? static_cast<size_t>(-1) : 0);
+		}
+
+		std::filesystem::create_directories(to, err);
+		if (!std::filesystem::is_directory(to, err)) return static_cast<size_t>(-1);
+
+		const std::filesystem::path dest = to;
+		std::atomic<size_t> amount = 0;
+		std::atomic<bool> failed = false;
+
+		const size_t res = __path_walk(from, [&](const path_entry& ent, const size_t) {
+			std::error_code cerr;
+			const std::filesystem::path target = dest / std::filesystem::path(ent.relative).make_preferred();
+
+			if (ent.is_directory) { // before going into it, so its files have where to go
+				std::filesystem::create_directory(target, cerr);
+				if (cerr) failed = true;
+				return !cerr;
+			}
+			if (ent.is_symlink) {
+				if (std::filesystem::exists(std::filesystem::symlink_status(target, cerr))) {
+					if (!overwrite) return false;
+					std::filesystem::remove(target, cerr);
+				}
+				std::filesystem::copy_symlink(ent.path, target, cerr);
+				if (!cerr) ++amount;
+			}
+			else if (std::filesystem::copy_file(ent.path, target, opt, cerr)) ++amount;
+
+			if (cerr) failed = true;
+			return false;
+		}, false, 0);
+
+		if (failed || res == static_cast<size_t>(-1)) return static_cast<size_t>(-1);
 		return amount;
 	}
 }
\ No newline at end of file
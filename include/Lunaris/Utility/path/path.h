@@ -4,8 +4,20 @@
 
 #include <allegro5/allegro5.h>
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <stdint.h>
 
 namespace Lunaris {
 
@@ -13,6 +25,39 @@ namespace Lunaris {
 
 	void __path_allegro_start();
 
+	/// <summary>
+	/// <para>One item found by walk_path or scan_path.</para>
+	/// </summary>
+	struct path_entry {
+		std::string path;			// full path (root + relative)
+		std::string relative;		// from the root, always with '/'
+		uint64_t size = 0;			// regular files only
+		std::filesystem::file_time_type last_write{};
+		size_t depth = 0;			// 0 = directly in the root
+		bool is_directory = false;	// symbolic links are never followed
+		bool is_symlink = false;
+	};
+
+	/// <summary>
+	/// <para>Walks a directory tree with a pool of threads, each working on its own directories and stealing from the others when out of work.</para>
+	/// <para>Called from the worker threads at the same time! Return true on a directory to go into it.</para>
+	/// <para>If the function throws, the walk stops and the first exception is thrown again here, after the threads are done.</para>
+	/// <para>Used by walk_path, scan_path, copy_all and remove_all.</para>
+	/// </summary>
+	/// <param name="{std::filesystem::path}">Root directory.</param>
+	/// <param name="{std::function}">Called for each item (stat info only if asked) with the index of the worker thread.</param>
+	/// <param name="{bool}">Fill size and last_write (one more system call per item)?</param>
+	/// <param name="{size_t}">Threads (0 = automatic).</param>
+	/// <returns>{size_t} Items found, or static_cast&lt;size_t&gt;(-1) if a directory couldn't be read.</returns>
+	size_t __path_walk(const std::filesystem::path&, const std::function<bool(const path_entry&, const size_t)>&, const bool, const size_t);
+
+	/// <summary>
+	/// <para>Amount of threads __path_walk uses.</para>
+	/// </summary>
+	/// <param name="{size_t}">Threads asked (0 = automatic).</param>
+	/// <returns>{size_t} Threads it will use.</returns>
+	size_t __path_walk_threads(const size_t);
+
 	/// <summary>
 	/// <para>Translate this to char.</para>
 	/// </summary>
@@ -60,9 +105,54 @@ namespace Lunaris {
 
 	/// <summary>
 	/// <para>Removes this path (completely) or file.</para>
+	/// <para>Directories are walked and cleaned in parallel (see __path_walk).</para>
 	/// </summary>
 	/// <param name="{std::string}">Path itself.</param>
 	/// <param name="{bool}">Call fix_path_to just to be sure things will happen as expected?</param>
 	/// <returns>{size_t} How many items were deleted, or 0 if none, or static_cast&lt;size_t&gt;(-1) if error.</returns>
 	size_t remove_all(std::string, const bool = true);
+
+	/// <summary>
+	/// <para>Match a name or relative path against a glob pattern.</para>
+	/// <para>'*' is anything but '/', '**' is anything, '?' is one char, '[a-z]' and '[!a-z]' are sets.</para>
+	/// <para>'**/' also matches no directory at all: "a/**/b" matches "a/b".</para>
+	/// </summary>
+	/// <param name="{std::string_view}">Pattern.</param>
+	/// <param name="{std::string_view}">Text.</param>
+	/// <returns>{bool} True if it matches.</returns>
+	bool path_glob_match(const std::string_view, const std::string_view);
+
+	/// <summary>
+	/// <para>Walk a directory tree in parallel, with stat info, giving back the results in batches.</para>
+	/// <para>The glob is tested on the file name, or on the relative path if it has a '/' (like "textures/**.png").</para>
+	/// <para>The function is called from the worker threads, but never twice at the same time. Order is not defined.</para>
+	/// <para>If it throws, the walk stops and the exception is thrown again from here.</para>
+	/// </summary>
+	/// <param name="{std::string}">Root directory.</param>
+	/// <param name="{std::function}">Called with each batch (you can move things out of it).</param>
+	/// <param name="{std::string}">Glob filter (empty = everything).</param>
+	/// <param name="{bool}">Include directories in the results?</param>
+	/// <param name="{size_t}">Threads (0 = automatic).</param>
+	/// <returns>{size_t} How many items were given, or static_cast&lt;size_t&gt;(-1) if error.</returns>
+	size_t walk_path(const std::string&, const std::function<void(std::vector<path_entry>&)>&, const std::string& = {}, const bool = true, const size_t = 0);
+
+	/// <summary>
+	/// <para>Scan a directory tree in parallel (see walk_path).</para>
+	/// </summary>
+	/// <param name="{std::string}">Root directory.</param>
+	/// <param name="{std::string}">Glob filter (empty = everything).</param>
+	/// <param name="{bool}">Include directories in the results?</param>
+	/// <param name="{size_t}">Threads (0 = automatic).</param>
+	/// <returns>{std::vector} Everything found, sorted by relative path.</returns>
+	std::vector<path_entry> scan_path(const std::string&, const std::string& = {}, const bool = true, const size_t = 0);
+
+	/// <summary>
+	/// <para>Copy a file or a whole directory tree, in parallel.</para>
+	/// </summary>
+	/// <param name="{std::string}">From (file or directory).</param>
+	/// <param name="{std::string}">To (created if needed).</param>
+	/// <param name="{bool}">Overwrite existing files?</param>
+	/// <param name="{bool}">Call fix_path_to just to be sure things will happen as expected?</param>
+	/// <returns>{size_t} How many files and symlinks were copied (symlinks as links, not what they point to), or static_cast&lt;size_t&gt;(-1) if error.</returns>
+	size_t copy_all(std::string, std::string, const bool = true, const bool = true);
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+
+// This will include all the respective folder for you
+
+#include "serialize/serialize.h"
+#include "serialize/serialize.ipp"
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Lunaris/__macro/macros.h>
+#include <Lunaris/Utility/package.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <stdint.h>
+
+/// <summary>
+/// <para>List the members of a struct to serialize, in order: LUNARIS_SERIALIZE(id, name, items);</para>
+/// <para>New members should be added to the END only. Old data still loads (new members keep their value) and old code still reads new data (extra members are skipped).</para>
+/// </summary>
+#define LUNARIS_SERIALIZE(...) \
+	auto __lunaris_fields() { return std::tie(__VA_ARGS__); } \
+	auto __lunaris_fields() const { return std::tie(__VA_ARGS__); }
+
+/// <summary>
+/// <para>Optional version tag stored with a struct that has LUNARIS_SERIALIZE (default 0). Read it back with serialized_version.</para>
+/// </summary>
+#define LUNARIS_SERIALIZE_VERSION(VER) \
+	static constexpr uint32_t __lunaris_version = VER;
+
+namespace Lunaris {
+
+	/*
+	Format (packed, little endian):
+	- bool: 1 byte
+	- unsigned integers and enums: varint (7 bits per byte)
+	- signed integers: zigzag varint
+	- float, double: 4 or 8 bytes
+	- string, vector<char>: varint size + bytes
+	- vector, map, unordered_map: varint count + each item
+	- array, pair: each item
+	- optional: 1 byte (has value?) + value
+	- LUNARIS_SERIALIZE struct: varint version + varint size + each member
+	*/
+
+	/// <summary>
+	/// <para>Exact size of a value when serialized.</para>
+	/// </summary>
+	/// <param name="{T}">Any supported value.</param>
+	/// <returns>{size_t} Size, in bytes.</returns>
+	template<typename T>
+	size_t serialized_size(const T&);
+
+	/// <summary>
+	/// <para>Serialize a value at the end of a buffer (grows once).</para>
+	/// </summary>
+	/// <param name="{T}">Any supported value.</param>
+	/// <param name="{std::vector&lt;char&gt;}">Buffer to append to.</param>
+	template<typename T>
+	void serialize(const T&, std::vector<char>&);
+
+	/// <summary>
+	/// <para>Serialize a value.</para>
+	/// </summary>
+	/// <param name="{T}">Any supported value.</param>
+	/// <returns>{std::vector&lt;char&gt;} Serialized data.</returns>
+	template<typename T>
+	std::vector<char> serialize(const T&);
+
+	/// <summary>
+	/// <para>Read a value from serialized data.</para>
+	/// </summary>
+	/// <param name="{std::string_view}">Serialized data.</param>
+	/// <param name="{T}">Value to read into.</param>
+	/// <returns>{bool} True if data was valid and fully used.</returns>
+	template<typename T>
+	bool deserialize(const std::string_view, T&);
+
+	/// <summary>
+	/// <para>Read a value from serialized data.</para>
+	/// </summary>
+	/// <param name="{std::vector&lt;char&gt;}">Serialized data.</param>
+	/// <param name="{T}">Value to read into.</param>
+	/// <returns>{bool} True if data was valid and fully used.</returns>
+	template<typename T>
+	bool deserialize(const std::vector<char>&, T&);
+
+	/// <summary>
+	/// <para>Version tag of a serialized struct (LUNARIS_SERIALIZE_VERSION when it was written), without reading it.</para>
+	/// </summary>
+	/// <param name="{std::string_view}">Serialized data of a struct.</param>
+	/// <returns>{uint32_t} Version (0 if invalid).</returns>
+	uint32_t serialized_version(const std::string_view);
+
+	/// <summary>
+	/// <para>Write a LUNARIS_SERIALIZE struct into a package (as a block with its size).</para>
+	/// </summary>
+	/// <param name="{package}">The package.</param>
+	/// <param name="{T}">The struct.</param>
+	/// <returns>{package&amp;} The package.</returns>
+	template<typename T, std::enable_if_t<is_serializable_v<T>, int> = 0>
+	package& operator<<(package&, const T&);
+
+	/// <summary>
+	/// <para>Read a LUNARIS_SERIALIZE struct from a package. Throws if data is invalid.</para>
+	/// </summary>
+	/// <param name="{package}">The package.</param>
+	/// <param name="{T}">The struct.</param>
+	/// <returns>{package&amp;} The package.</returns>
+	template<typename T, std::enable_if_t<is_serializable_v<T>, int> = 0>
+	package& operator>>(package&, T&);
+
+}
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "serialize.h"
+#pragma once
+
+namespace Lunaris {
+
+	namespace __serialize {
+
+		template<typename T> struct is_vector : std::false_type {};
+		template<typename T, typename A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+		template<typename T> struct is_array : std::false_type {};
+		template<typename T, size_t N> struct is_array<std::array<T, N>> : std::true_type {};
+
+		template<typename T> struct is_map : std::false_type {};
+		template<typename K, typename V, typename C, typename A> struct is_map<std::map<K, V, C, A>> : std::true_type {};
+		template<typename K, typename V, typename H, typename E, typename A> struct is_map<std::unordered_map<K, V, H, E, A>> : std::true_type {};
+
+		template<typename T> struct is_optional : std::false_type {};
+		template<typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+		template<typename T> struct is_pair : std::false_type {};
+		template<typename A, typename B> struct is_pair<std::pair<A, B>> : std::true_type {};
+
+		template<typename T> struct always_false : std::false_type {};
+
+		template<typename T, typename = void> struct version_of { static constexpr uint32_t value = 0; };
+		template<typename T> struct version_of<T, std::void_t<decltype(T::__lunaris_version)>> { static constexpr uint32_t value = T::__lunaris_version; };
+
+		template<typename T>
+		constexpr bool is_bytes_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> || std::is_same_v<T, std::vector<char>>;
+
+		inline size_t varint_size(uint64_t v)
+		{
+			size_t n = 1;
+			while (v >= 0x80) { v >>= 7; ++n; }
+			return n;
+		}
+
+		inline void put_varint(char*& p, uint64_t v)
+		{
+			while (v >= 0x80) {
+				*p++ = static_cast<char>((v & 0x7F) | 0x80);
+				v >>= 7;
+			}
+			*p++ = static_cast<char>(v);
+		}
+
+		inline bool get_varint(const char*& p, const char* e, uint64_t& v)
+		{
+			v = 0;
+			for (int shift = 0; shift < 64 && p < e; shift += 7) {
+				const uint64_t b = static_cast<unsigned char>(*p++);
+				v |= (b & 0x7F) << shift;
+				if (!(b & 0x80)) return true;
+			}
+			return false; // too long or cut
+		}
+
+		template<typename T>
+		uint64_t zigzag(const T v)
+		{
+			const int64_t s = static_cast<int64_t>(v);
+			return (static_cast<uint64_t>(s) << 1) ^ static_cast<uint64_t>(s >> 63);
+		}
+
+		template<typename T>
+		T unzigzag(const uint64_t v)
+		{
+			return static_cast<T>(static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1)));
+		}
+
+		// size_of records the body size of every struct (depth first, same order put visits them), so put doesn't measure again at each level
+		using body_sizes = std::vector<size_t>;
+
+		template<typename T> size_t size_of(const T&, body_sizes&);
+		template<typename T> void put(char*&, const T&, const size_t*&);
+		template<typename T> bool get(const char*&, const char*, T&);
+
+		template<typename T>
+		size_t size_of(const T& val, body_sizes& bodies)
+		{
+			if constexpr (is_serializable_v<T>) {
+				const size_t slot = bodies.size();
+				bodies.push_back(0); // reserved before the fields, so nested structs come after it
+				const size_t body = std::apply([&bodies](const auto&... it) { return (static_cast<size_t>(0) + ... + size_of(it, bodies)); }, val.__lunaris_fields());
+				bodies[slot] = body;
+				return varint_size(version_of<T>::value) + varint_size(body) + body;
+			}
+			else if constexpr (std::is_same_v<T, bool>) return 1;
+			else if constexpr (std::is_enum_v<T>) return size_of(static_cast<std::underlying_type_t<T>>(val), bodies);
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return varint_size(zigzag(val));
+			else if constexpr (std::is_integral_v<T>) return varint_size(static_cast<uint64_t>(val));
+			else if constexpr (std::is_floating_point_v<T>) {
+				static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only float and double are supported.");
+				return sizeof(T);
+			}
+			else if constexpr (is_bytes_v<T>) return varint_size(val.size()) + val.size();
+			else if constexpr (is_vector<T>::value) {
+				size_t total = varint_size(val.size());
+				for (const auto& it : val) total += size_of<typename T::value_type>(it, bodies);
+				return total;
+			}
+			else if constexpr (is_array<T>::value) {
+				size_t total = 0;
+				for (const auto& it : val) total += size_of(it, bodies);
+				return total;
+			}
+			else if constexpr (is_map<T>::value) {
+				size_t total = varint_size(val.size());
+				for (const auto& it : val) total += size_of(it.first, bodies) + size_of(it.second, bodies);
+				return total;
+			}
+			else if constexpr (is_pair<T>::value) return size_of(val.first, bodies) + size_of(val.second, bodies);
+			else if constexpr (is_optional<T>::value) return 1 + (val ? size_of(*val, bodies) : 0);
+			else static_assert(always_false<T>::value, "Type not supported by serialize. Add LUNARIS_SERIALIZE to it?");
+		}
+
+		template<typename T>
+		void put(char*& p, const T& val, const size_t*& body)
+		{
+			if constexpr (is_serializable_v<T>) {
+				put_varint(p, version_of<T>::value);
+				put_varint(p, *body++);
+				std::apply([&p, &body](const auto&... it) { (put(p, it, body), ...); }, val.__lunaris_fields());
+			}
+			else if constexpr (std::is_same_v<T, bool>) *p++ = val ? 1 : 0;
+			else if constexpr (std::is_enum_v<T>) put(p, static_cast<std::underlying_type_t<T>>(val), body);
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) put_varint(p, zigzag(val));
+			else if constexpr (std::is_integral_v<T>) put_varint(p, static_cast<uint64_t>(val));
+			else if constexpr (std::is_floating_point_v<T>) {
+				std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+				memcpy(&bits, &val, sizeof(T));
+				for (size_t k = 0; k < sizeof(T); ++k) *p++ = static_cast<char>((bits >> (8 * k)) & 0xFF);
+			}
+			else if constexpr (is_bytes_v<T>) {
+				put_varint(p, val.size());
+				if (val.size()) memcpy(p, val.data(), val.size());
+				p += val.size();
+			}
+			else if constexpr (is_vector<T>::value) {
+				put_varint(p, val.size());
+				for (const auto& it : val) put<typename T::value_type>(p, it, body);
+			}
+			else if constexpr (is_array<T>::value) {
+				for (const auto& it : val) put(p, it, body);
+			}
+			else if constexpr (is_map<T>::value) {
+				put_varint(p, val.size());
+				for (const auto& it : val) {
+					put(p, it.first, body);
+					put(p, it.second, body);
+				}
+			}
+			else if constexpr (is_pair<T>::value) {
+				put(p, val.first, body);
+				put(p, val.second, body);
+			}
+			else if constexpr (is_optional<T>::value) {
+				*p++ = val ? 1 : 0;
+				if (val) put(p, *val, body);
+			}
+			else static_assert(always_false<T>::value, "Type not supported by serialize. Add LUNARIS_SERIALIZE to it?");
+		}
+
+		template<typename T>
+		bool get(const char*& p, const char* e, T& val)
+		{
+			if constexpr (is_serializable_v<T>) {
+				uint64_t ver = 0, len = 0;
+				if (!get_varint(p, e, ver) || !get_varint(p, e, len) || len > static_cast<uint64_t>(e - p)) return false;
+				const char* end = p + len;
+				bool good = true;
+				// older data may end early (members left as they are), newer data may have more (skipped)
+				std::apply([&](auto&... it) { ((good = good && (p == end || get(p, end, it))), ...); }, val.__lunaris_fields());
+				p = end;
+				return good;
+			}
+			else if constexpr (std::is_same_v<T, bool>) {
+				if (p >= e) return false;
+				val = (*p++ != 0);
+				return true;
+			}
+			else if constexpr (std::is_enum_v<T>) {
+				std::underlying_type_t<T> raw{};
+				if (!get(p, e, raw)) return false;
+				val = static_cast<T>(raw);
+				return true;
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				uint64_t raw = 0;
+				if (!get_varint(p, e, raw)) return false;
+				if constexpr (std::is_signed_v<T>) val = unzigzag<T>(raw);
+				else val = static_cast<T>(raw);
+				return true;
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				if (static_cast<size_t>(e - p) < sizeof(T)) return false;
+				std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits = 0;
+				for (size_t k = 0; k < sizeof(T); ++k) bits |= static_cast<decltype(bits)>(static_cast<unsigned char>(*p++)) << (8 * k);
+				memcpy(&val, &bits, sizeof(T));
+				return true;
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<char>>) {
+				uint64_t len = 0;
+				if (!get_varint(p, e, len) || len > static_cast<uint64_t>(e - p)) return false;
+				val.assign(p, p + len);
+				p += len;
+				return true;
+			}
+			else if constexpr (is_vector<T>::value) {
+				uint64_t count = 0;
+				if (!get_varint(p, e, count) || count > static_cast<uint64_t>(e - p)) return false; // every item takes at least a byte
+				val.clear();
+				val.reserve(static_cast<size_t>(count));
+				for (uint64_t i = 0; i < count; ++i) {
+					typename T::value_type it{};
+					if (!get(p, e, it)) return false;
+					val.push_back(std::move(it));
+				}
+				return true;
+			}
+			else if constexpr (is_array<T>::value) {
+				for (auto& it : val) if (!get(p, e, it)) return false;
+				return true;
+			}
+			else if constexpr (is_map<T>::value) {
+				uint64_t count = 0;
+				if (!get_varint(p, e, count) || count > static_cast<uint64_t>(e - p)) return false;
+				val.clear();
+				for (uint64_t i = 0; i < count; ++i) {
+					typename T::key_type k{};
+					typename T::mapped_type v{};
+					if (!get(p, e, k) || !get(p, e, v)) return false;
+					val.emplace(std::move(k), std::move(v));
+				}
+				return true;
+			}
+			else if constexpr (is_pair<T>::value) {
+				return get(p, e, val.first) && get(p, e, val.second);
+			}
+			else if constexpr (is_optional<T>::value) {
+				if (p >= e) return false;
+				if (*p++ == 0) {
+					val.reset();
+					return true;
+				}
+				typename T::value_type it{};
+				if (!get(p, e, it)) return false;
+				val = std::move(it);
+				return true;
+			}
+			else static_assert(always_false<T>::value, "Type not supported by deserialize. Add LUNARIS_SERIALIZE to it?");
+		}
+	}
+
+	template<typename T>
+	inline size_t serialized_size(const T& val)
+	{
+		__serialize::body_sizes bodies;
+		return __serialize::size_of(val, bodies);
+	}
+
+	template<typename T>
+	inline void serialize(const T& val, std::vector<char>& out)
+	{
+		__serialize::body_sizes bodies;
+		const size_t off = out.size();
+		out.resize(off + __serialize::size_of(val, bodies));
+		char* p = out.data() + off;
+		const size_t* body = bodies.data();
+		__serialize::put(p, val, body);
+	}
+
+	template<typename T>
+	inline std::vector<char> serialize(const T& val)
+	{
+		std::vector<char> out;
+		serialize(val, out);
+		return out;
+	}
+
+	template<typename T>
+	inline bool deserialize(const std::string_view data, T& val)
+	{
+		const char* p = data.data();
+		const char* e = data.data() + data.size();
+		return __serialize::get(p, e, val) && p == e;
+	}
+
+	template<typename T>
+	inline bool deserialize(const std::vector<char>& data, T& val)
+	{
+		return deserialize(std::string_view(data.data(), data.size()), val);
+	}
+
+	inline uint32_t serialized_version(const std::string_view data)
+	{
+		const char* p = data.data();
+		uint64_t ver = 0;
+		if (!__serialize::get_varint(p, data.data() + data.size(), ver)) return 0;
+		return static_cast<uint32_t>(ver);
+	}
+
+	template<typename T, std::enable_if_t<is_serializable_v<T>, int>>
+	inline package& operator<<(package& pkg, const T& val)
+	{
+		const std::vector<char> tmp = serialize(val);
+		return pkg << std::string_view(tmp.data(), tmp.size());
+	}
+
+	template<typename T, std::enable_if_t<is_serializable_v<T>, int>>
+	inline package& operator>>(package& pkg, T& val)
+	{
+		if (!deserialize(pkg.read_string_view(), val)) throw std::runtime_error("Unexpected invalid value while reading");
+		return pkg;
+	}
+
+}
\ No newline at end of file
@@ -5,4 +5,8 @@
 #include <Lunaris/Audio/voice.h>
 #include <Lunaris/Audio/mixer.h>
 #include <Lunaris/Audio/sample.h>
-#include <Lunaris/Audio/track.h>
\ No newline at end of file
+#include <Lunaris/Audio/track.h>
+#include <Lunaris/Audio/track_pool.h>
+#include <Lunaris/Audio/track_stream.h>
+#include <Lunaris/Audio/softmix.h>
+#include <Lunaris/Audio/offline_voice.h>
\ No newline at end of file
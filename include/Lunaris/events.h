@@ -6,5 +6,7 @@
 #include <Lunaris/Events/keyboard.h>
 #include <Lunaris/Events/mouse.h>
 #include <Lunaris/Events/keys.h>
+#include <Lunaris/Events/input_state.h>
 #include <Lunaris/Events/generic_event_handler.h>
-#include <Lunaris/Events/specific_event_handler.h>
\ No newline at end of file
+#include <Lunaris/Events/specific_event_handler.h>
+#include <Lunaris/Events/recorder.h>
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <Lunaris/Graphics/vertex.h> // depends on COLOR, TEXTURE
 #include <Lunaris/Graphics/font.h> // depends on COLOR, TEXTURE
 #include <Lunaris/Graphics/sprite.h> // depends on TEXTURE, TRANSFORM, COLOR, Utility/memory, Utility/multi_map
-#include <Lunaris/Graphics/block.h>  // depends on SPRITE, TRANSFORM
+#include <Lunaris/Graphics/animation.h> // depends on TEXTURE
+#include <Lunaris/Graphics/block.h>  // depends on SPRITE, TRANSFORM, ANIMATION
 #include <Lunaris/Graphics/text.h>   // depends on SPRITE, TRANSFORM, BLOCK, UTILITY::SAFE_DATA
-#include <Lunaris/Graphics/collisionable.h> // depends on SPRITE
\ No newline at end of file
+#include <Lunaris/Graphics/collisionable.h> // depends on SPRITE
+#include <Lunaris/Graphics/scene.h> // depends on SPRITE, VERTEX, COLLISIONABLE, TRANSFORM
\ No newline at end of file
@@ -11,10 +11,15 @@
 #include <Lunaris/Utility/memory.h>
 #include <Lunaris/Utility/thread.h>
 #include <Lunaris/Utility/package.h>
+#include <Lunaris/Utility/serialize.h>
 #include <Lunaris/Utility/process.h>
 #include <Lunaris/Utility/downloader.h>
 #include <Lunaris/Utility/file.h>
+#include <Lunaris/Utility/async_io.h>
 #include <Lunaris/Utility/hash.h>
+#include <Lunaris/Utility/merkle.h>
+#include <Lunaris/Utility/crypt.h>
+#include <Lunaris/Utility/archive.h>
 #include <Lunaris/Utility/random.h>
 #include <Lunaris/Utility/config.h>
 #include <Lunaris/Utility/path.h>